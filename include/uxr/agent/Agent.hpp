@@ -523,6 +523,19 @@ public:
      */
     UXR_AGENT_EXPORT void reset();
 
+    /**
+     * @brief Sets the limits of the reliable stream depth of new sessions.
+     *        A client may request a depth, that is, the number of reliable messages in flight per stream,
+     *        through the "uxr_rd" property of its CLIENT_Representation. The requested depth, or the
+     *        default one if it requests none, is clamped to these limits.
+     * @param min_depth Minimum depth, greater than 0.
+     * @param max_depth Maximum depth, up to RELIABLE_STREAM_MAX_DEPTH.
+     * @return true in case of valid limits, false in other case.
+     */
+    UXR_AGENT_EXPORT bool set_reliable_stream_depth_limits(
+            uint16_t min_depth,
+            uint16_t max_depth);
+
     /**
      * @brief Writes data into the middleware using the DataWriter identifier by the datawriter_id.
      * @param client_key        The identifier of the ProxyClient.
@@ -18,6 +18,7 @@
 #include <uxr/agent/client/ProxyClient.hpp>
 
 #include <thread>
+#include <functional>
 #include <memory>
 #include <map>
 #include <mutex>
@@ -53,12 +54,31 @@ public:
 
     void set_verbose_level(uint8_t verbose_level);
 
+    bool set_reliable_depth_limits(
+            uint16_t min_depth,
+            uint16_t max_depth);
+
+    /**
+     * @brief Sets the function called after a client has been created or reset, whatever the path that created it
+     *        (CREATE_CLIENT submessage, Agent API or P2P discovery).
+     *        It is called without holding the Root lock.
+     */
+    void set_on_create_client(
+            std::function<void (const std::shared_ptr<ProxyClient>&)>&& on_create_client);
+
     void reset();
 
+private:
+    uint16_t get_reliable_depth(
+            const std::unordered_map<std::string, std::string>& client_properties) const;
+
 private:
     std::mutex mtx_;
+    uint16_t min_reliable_depth_;
+    uint16_t max_reliable_depth_;
     std::map<dds::xrce::ClientKey, std::shared_ptr<ProxyClient>> clients_;
     std::map<dds::xrce::ClientKey, std::shared_ptr<ProxyClient>>::iterator current_client_;
+    std::function<void (const std::shared_ptr<ProxyClient>&)> on_create_client_;
 };
 
 } // uxr
@@ -18,12 +18,18 @@
 #include <uxr/agent/middleware/Middleware.hpp>
 #include <uxr/agent/participant/Participant.hpp>
 #include <uxr/agent/client/session/Session.hpp>
+#include <uxr/agent/utils/HandleTable.hpp>
 #include <unordered_map>
 #include <array>
 
 namespace eprosima {
 namespace uxr {
 
+class DataWriter;
+class DataReader;
+class Requester;
+class Replier;
+
 class ProxyClient : public std::enable_shared_from_this<ProxyClient>
 {
 public:
@@ -37,7 +43,8 @@ public:
     explicit ProxyClient(
             const dds::xrce::CLIENT_Representation& representation,
             Middleware::Kind middleware_kind = Middleware::Kind(0),
-            std::unordered_map<std::string, std::string>&& properties = {});
+            std::unordered_map<std::string, std::string>&& properties = {},
+            uint16_t reliable_depth = RELIABLE_STREAM_DEPTH);
 
     ~ProxyClient() = default;
 
@@ -62,6 +69,18 @@ public:
 
     std::shared_ptr<XRCEObject> get_object(const dds::xrce::ObjectId& object_id);
 
+    /*
+     * Typed handles of the objects which write and read data, looked up without taking the objects mutex.
+     * A handle is only found for an ObjectId of the matching kind.
+     */
+    std::shared_ptr<DataWriter> get_datawriter(const dds::xrce::ObjectId& object_id) const;
+
+    std::shared_ptr<DataReader> get_datareader(const dds::xrce::ObjectId& object_id) const;
+
+    std::shared_ptr<Requester> get_requester(const dds::xrce::ObjectId& object_id) const;
+
+    std::shared_ptr<Replier> get_replier(const dds::xrce::ObjectId& object_id) const;
+
     const dds::xrce::ClientKey& get_client_key() const { return representation_.client_key(); }
 
     dds::xrce::SessionId get_session_id() const { return representation_.session_id(); }
@@ -128,11 +147,22 @@ private:
     bool delete_object_unlock(
             const dds::xrce::ObjectId& object_id);
 
+    void publish_handle(
+            const dds::xrce::ObjectId& object_id,
+            const std::shared_ptr<XRCEObject>& object);
+
+    static uint16_t get_handle_index(
+            const dds::xrce::ObjectId& object_id);
+
 private:
     const dds::xrce::CLIENT_Representation representation_;
     std::unique_ptr<Middleware> middleware_;
     std::mutex mtx_;
     XRCEObject::ObjectContainer objects_;
+    utils::HandleTable<DataWriter> datawriters_;
+    utils::HandleTable<DataReader> datareaders_;
+    utils::HandleTable<Requester> requesters_;
+    utils::HandleTable<Replier> repliers_;
     Session session_;
     std::mutex state_mtx_;
     State state_;
@@ -19,9 +19,14 @@
 #include <uxr/agent/client/session/stream/InputStream.hpp>
 #include <uxr/agent/client/session/stream/OutputStream.hpp>
 #include <uxr/agent/utils/SharedMutex.hpp>
+#include <uxr/agent/utils/RttEstimator.hpp>
 
+#include <algorithm>
+#include <chrono>
 #include <unordered_map>
 #include <memory>
+#include <tuple>
+#include <utility>
 
 namespace eprosima {
 namespace uxr {
@@ -44,10 +49,24 @@ inline bool is_reliable_stream(dds::xrce::StreamId stream_id)
 class Session
 {
 public:
-    Session(const SessionInfo& info)
+    /**
+     * @brief   Builds a session whose reliable streams have the given depth, that is, the number
+     *          of messages each of them keeps in flight.
+     */
+    Session(
+            const SessionInfo& info,
+            uint16_t reliable_depth = RELIABLE_STREAM_DEPTH)
         : session_info_(info)
+        , reliable_depth_(reliable_depth)
         , none_ostream_{}
-    {}
+        , rtt_estimator_(
+            std::chrono::milliseconds(HEARTBEAT_PERIOD),
+            std::chrono::milliseconds(MIN_HEARTBEAT_PERIOD),
+            std::chrono::milliseconds(MAX_HEARTBEAT_PERIOD),
+            std::chrono::milliseconds(MIN_HEARTBEAT_PERIOD))
+    {
+        set_acknack_policy(ACKNACK_MAX_PENDING, std::chrono::milliseconds(ACKNACK_DELAY));
+    }
 
     ~Session() = default;
 
@@ -85,6 +104,37 @@ public:
             dds::xrce::StreamId stream_id,
             InputMessagePtr& message);
 
+    uint16_t get_reliable_depth() const { return reliable_depth_; }
+
+    /* Acknowledgement functions. */
+
+    /**
+     * @brief   Sets how the reliable input streams are acknowledged. An ACKNACK is sent once max_pending
+     *          messages of a stream are unacknowledged, up to half the stream depth, or once the delay has
+     *          elapsed since the first of them. A missing or repeated message is answered right away,
+     *          so that NACKs are never delayed. A delay of 0 acknowledges every message.
+     */
+    void set_acknack_policy(
+            uint16_t max_pending,
+            std::chrono::milliseconds delay);
+
+    std::chrono::milliseconds get_acknack_delay();
+
+    /**
+     * @brief   Records a message received on a reliable input stream, once those in order have been popped.
+     * @param   accepted    Whether the stream took the message.
+     * @return  true if the ACKNACK of the stream is due now, false if it may be delayed.
+     */
+    bool notify_reliable_message(
+            dds::xrce::StreamId stream_id,
+            bool accepted);
+
+    /**
+     * @brief   Whether messages of a reliable input stream are waiting for a delayed ACKNACK.
+     */
+    bool has_unacked_messages(
+            dds::xrce::StreamId stream_id);
+
     /* Output streams functions. */
     std::vector<uint8_t> get_output_streams();
 
@@ -93,11 +143,25 @@ public:
             dds::xrce::StreamId stream_id,
             dds::xrce::SubmessageId submessage_id,
             const T& submessage,
-            std::chrono::milliseconds timeout);
+            std::chrono::milliseconds timeout,
+            bool coalesce = false);
+
+    /**
+     * @brief   Pushes a submessage without waiting for room in the window of a reliable stream.
+     *          If the window is full, the listener is called once the ACKNACKs open it.
+     */
+    template<class T>
+    PushResult try_push_output_submessage(
+            dds::xrce::StreamId stream_id,
+            dds::xrce::SubmessageId submessage_id,
+            const T& submessage,
+            const std::shared_ptr<WindowListener>& listener,
+            bool coalesce = false);
 
     bool get_next_output_message(
             dds::xrce::StreamId stream_id,
-            OutputMessagePtr& output_message);
+            OutputMessagePtr& output_message,
+            bool flush = true);
 
     bool get_output_message(
             dds::xrce::StreamId stream_id,
@@ -112,25 +176,67 @@ public:
             dds::xrce::StreamId stream_id,
             dds::xrce::HEARTBEAT_Payload& heartbeat);
 
+    /* Round-trip time functions. */
+
+    /**
+     * @brief   Records a HEARTBEAT sent on a reliable output stream, whose ACKNACK gives an RTT sample.
+     *          If the previous HEARTBEAT of the stream is still unanswered, the client is deemed
+     *          unresponsive: the heartbeat period is backed off and no sample is taken for the stream
+     *          until an ACKNACK answers a single HEARTBEAT.
+     * @return  true if the previous HEARTBEAT of the stream is still unanswered, false in other case.
+     */
+    bool notify_heartbeat_sent(
+            dds::xrce::StreamId stream_id,
+            std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now());
+
+    /**
+     * @brief   Records an ACKNACK received on a reliable output stream, updating the RTT estimation.
+     */
+    void notify_acknack_received(
+            dds::xrce::StreamId stream_id,
+            std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now());
+
+    /**
+     * @brief   Period of the HEARTBEATs, that is, the retransmission timeout derived from the RTT.
+     */
+    std::chrono::milliseconds get_heartbeat_period();
+
 private:
+    ReliableInputStream& get_reliable_input_stream(
+            dds::xrce::StreamId stream_id);
+
     ReliableOutputStream& get_reliable_output_stream(
             dds::xrce::StreamId stream_id,
             utils::SharedLock& shared_lock);
 
 private:
     const SessionInfo session_info_;
+    const uint16_t reliable_depth_;
 
     NoneInputStream none_istream_;
     std::unordered_map<dds::xrce::StreamId, BestEffortInputStream> best_effort_istreams_;
     std::unordered_map<dds::xrce::StreamId, ReliableInputStream> reliable_istreams_;
     std::mutex best_effort_imtx_;
     std::mutex reliable_imtx_;
+    uint16_t acknack_max_pending_;
+    std::chrono::milliseconds acknack_delay_;
 
     NoneOutputStream none_ostream_;
     std::unordered_map<dds::xrce::StreamId, BestEffortOutputStream> best_effort_ostreams_;
     std::unordered_map<dds::xrce::StreamId, ReliableOutputStream> reliable_ostreams_;
     std::mutex best_effort_omtx_;
     utils::SharedMutex reliable_omtx_;
+
+    struct HeartbeatProbe
+    {
+        std::chrono::steady_clock::time_point timestamp;
+        bool pending = false;
+        bool ambiguous = false;
+    };
+
+    utils::RttEstimator rtt_estimator_;
+    std::unordered_map<dds::xrce::StreamId, HeartbeatProbe> heartbeat_probes_;
+    std::mutex rtt_mtx_;
 };
 
 inline void Session::reset()
@@ -164,6 +270,9 @@ inline void Session::reset()
         it.second.reset();
     }
     reliable_olock.unlock();
+
+    std::lock_guard<std::mutex> rtt_lock(rtt_mtx_);
+    heartbeat_probes_.clear();
 }
 
 /**************************************************************************************************
@@ -188,7 +297,7 @@ inline bool Session::push_input_message(
     else
     {
         std::lock_guard<std::mutex> lock(reliable_imtx_);
-        rv = reliable_istreams_[stream_id].push_message(sequence_nr, std::move(message));
+        rv = get_reliable_input_stream(stream_id).push_message(sequence_nr, std::move(message));
     }
     return rv;
 }
@@ -210,7 +319,7 @@ inline bool Session::pop_input_message(
     else
     {
         std::lock_guard<std::mutex> lock(reliable_imtx_);
-        rv = reliable_istreams_[stream_id].pop_message(message);
+        rv = get_reliable_input_stream(stream_id).pop_message(message);
     }
     return rv;
 }
@@ -223,7 +332,7 @@ inline void Session::update_from_heartbeat(
     if (is_reliable_stream(stream_id))
     {
         std::lock_guard<std::mutex> lock(reliable_imtx_);
-        reliable_istreams_[stream_id].update_from_heartbeat(first_unacked, last_unacked);
+        get_reliable_input_stream(stream_id).update_from_heartbeat(first_unacked, last_unacked);
     }
 }
 
@@ -234,7 +343,7 @@ inline void Session::fill_acknack(
     if (is_reliable_stream(stream_id))
     {
         std::lock_guard<std::mutex> lock(reliable_imtx_);
-        reliable_istreams_[stream_id].fill_acknack(acknack);
+        get_reliable_input_stream(stream_id).fill_acknack(acknack);
     }
 }
 
@@ -243,14 +352,56 @@ inline void Session::push_input_fragment(dds::xrce::StreamId stream_id, InputMes
     if (is_reliable_stream(stream_id))
     {
         std::lock_guard<std::mutex> lock(reliable_imtx_);
-        reliable_istreams_[stream_id].push_fragment(message);
+        get_reliable_input_stream(stream_id).push_fragment(message);
     }
 }
 
 inline bool Session::pop_input_fragment_message(dds::xrce::StreamId stream_id, InputMessagePtr& message)
 {
     std::lock_guard<std::mutex> lock(reliable_imtx_);
-    return reliable_istreams_[stream_id].pop_fragment_message(message);
+    return get_reliable_input_stream(stream_id).pop_fragment_message(message);
+}
+
+inline void Session::set_acknack_policy(
+        uint16_t max_pending,
+        std::chrono::milliseconds delay)
+{
+    const uint16_t max_depth_pending = (1 < reliable_depth_) ? uint16_t(reliable_depth_ / 2) : 1;
+    std::lock_guard<std::mutex> lock(reliable_imtx_);
+    acknack_max_pending_ = (0 == max_pending) ? 1 : std::min(max_pending, max_depth_pending);
+    acknack_delay_ = (std::chrono::milliseconds::zero() < delay) ? delay : std::chrono::milliseconds::zero();
+}
+
+inline std::chrono::milliseconds Session::get_acknack_delay()
+{
+    std::lock_guard<std::mutex> lock(reliable_imtx_);
+    return acknack_delay_;
+}
+
+inline bool Session::notify_reliable_message(
+        dds::xrce::StreamId stream_id,
+        bool accepted)
+{
+    bool rv = true;
+    if (is_reliable_stream(stream_id))
+    {
+        std::lock_guard<std::mutex> lock(reliable_imtx_);
+        const uint16_t max_pending = (std::chrono::milliseconds::zero() < acknack_delay_) ? acknack_max_pending_ : 1;
+        rv = get_reliable_input_stream(stream_id).is_acknack_due(accepted, max_pending);
+    }
+    return rv;
+}
+
+inline bool Session::has_unacked_messages(
+        dds::xrce::StreamId stream_id)
+{
+    bool rv = false;
+    if (is_reliable_stream(stream_id))
+    {
+        std::lock_guard<std::mutex> lock(reliable_imtx_);
+        rv = get_reliable_input_stream(stream_id).has_unacked_messages();
+    }
+    return rv;
 }
 
 /**************************************************************************************************
@@ -273,45 +424,70 @@ inline bool Session::push_output_submessage(
         dds::xrce::StreamId stream_id,
         dds::xrce::SubmessageId submessage_id,
         const T& submessage,
-        std::chrono::milliseconds timeout)
+        std::chrono::milliseconds timeout,
+        bool coalesce)
 {
     bool rv = false;
     if (is_none_stream(stream_id))
     {
-        rv = none_ostream_.push_submessage(session_info_, submessage_id, submessage);
+        rv = none_ostream_.push_submessage(session_info_, submessage_id, submessage, coalesce);
     }
     else if (is_besteffort_stream(stream_id))
     {
         std::lock_guard<std::mutex> lock(best_effort_omtx_);
-        rv = best_effort_ostreams_[stream_id].push_submessage(session_info_, stream_id, submessage_id, submessage);
+        rv = best_effort_ostreams_[stream_id].push_submessage(
+            session_info_, stream_id, submessage_id, submessage, coalesce);
     }
     else
     {
         utils::SharedLock shared_lock(reliable_omtx_);
         rv = get_reliable_output_stream(stream_id, shared_lock).push_submessage(
-            session_info_, stream_id, submessage_id, submessage, timeout);
+            session_info_, stream_id, submessage_id, submessage, timeout, coalesce);
+    }
+    return rv;
+}
+
+template<class T>
+inline PushResult Session::try_push_output_submessage(
+        dds::xrce::StreamId stream_id,
+        dds::xrce::SubmessageId submessage_id,
+        const T& submessage,
+        const std::shared_ptr<WindowListener>& listener,
+        bool coalesce)
+{
+    PushResult rv = PushResult::error;
+    if (is_reliable_stream(stream_id))
+    {
+        utils::SharedLock shared_lock(reliable_omtx_);
+        rv = get_reliable_output_stream(stream_id, shared_lock).try_push_submessage(
+            session_info_, stream_id, submessage_id, submessage, listener, coalesce);
+    }
+    else if (push_output_submessage(stream_id, submessage_id, submessage, std::chrono::milliseconds(0), coalesce))
+    {
+        rv = PushResult::pushed;
     }
     return rv;
 }
 
 inline bool Session::get_next_output_message(
         dds::xrce::StreamId stream_id,
-        OutputMessagePtr& output_message)
+        OutputMessagePtr& output_message,
+        bool flush)
 {
     bool rv = false;
     if (is_none_stream(stream_id))
     {
-        rv = none_ostream_.pop_message(output_message);
+        rv = none_ostream_.pop_message(output_message, flush);
     }
     else if (is_besteffort_stream(stream_id))
     {
         std::lock_guard<std::mutex> lock(best_effort_omtx_);
-        rv = best_effort_ostreams_[stream_id].pop_message(output_message);
+        rv = best_effort_ostreams_[stream_id].pop_message(output_message, flush);
     }
     else
     {
         utils::SharedLock shared_lock(reliable_omtx_);
-        rv = get_reliable_output_stream(stream_id, shared_lock).get_next_message(output_message);
+        rv = get_reliable_output_stream(stream_id, shared_lock).get_next_message(output_message, flush);
     }
     return rv;
 }
@@ -356,6 +532,53 @@ inline bool Session::fill_heartbeat(
     return rv;
 }
 
+/**************************************************************************************************
+ * Round-Trip Time Methods.
+ **************************************************************************************************/
+inline bool Session::notify_heartbeat_sent(
+        dds::xrce::StreamId stream_id,
+        std::chrono::steady_clock::time_point now)
+{
+    std::lock_guard<std::mutex> lock(rtt_mtx_);
+    HeartbeatProbe& probe = heartbeat_probes_[stream_id];
+    const bool unanswered = probe.pending;
+    if (unanswered)
+    {
+        /* Karn's algorithm: an ACKNACK could answer any of the HEARTBEATs, so it gives no sample. */
+        rtt_estimator_.backoff();
+        probe.ambiguous = true;
+    }
+    probe.timestamp = now;
+    probe.pending = true;
+    return unanswered;
+}
+
+inline void Session::notify_acknack_received(
+        dds::xrce::StreamId stream_id,
+        std::chrono::steady_clock::time_point now)
+{
+    std::lock_guard<std::mutex> lock(rtt_mtx_);
+    auto it = heartbeat_probes_.find(stream_id);
+    if ((heartbeat_probes_.end() != it) && it->second.pending)
+    {
+        if (!it->second.ambiguous)
+        {
+            rtt_estimator_.update(
+                std::chrono::duration_cast<utils::RttEstimator::Duration>(now - it->second.timestamp));
+        }
+        it->second.pending = false;
+        it->second.ambiguous = false;
+    }
+}
+
+inline std::chrono::milliseconds Session::get_heartbeat_period()
+{
+    std::lock_guard<std::mutex> lock(rtt_mtx_);
+    const utils::RttEstimator::Duration rto = rtt_estimator_.get_rto();
+    std::chrono::milliseconds period = std::chrono::duration_cast<std::chrono::milliseconds>(rto);
+    return (period < rto) ? period + std::chrono::milliseconds(1) : period;
+}
+
 inline ReliableOutputStream& Session::get_reliable_output_stream(
         dds::xrce::StreamId stream_id,
         utils::SharedLock& shared_lock)
@@ -371,8 +594,27 @@ inline ReliableOutputStream& Session::get_reliable_output_stream(
         shared_lock.unlock();
         utils::ExclusiveLock exclusive_lock(reliable_omtx_);
         shared_lock.lock();
-        return reliable_ostreams_[stream_id];
+        /* Another thread may have created it meanwhile, in which case emplace keeps that one. */
+        return reliable_ostreams_.emplace(
+            std::piecewise_construct,
+            std::forward_as_tuple(stream_id),
+            std::forward_as_tuple(reliable_depth_)).first->second;
+    }
+}
+
+/* Shall be called with the reliable input streams mutex locked. */
+inline ReliableInputStream& Session::get_reliable_input_stream(
+        dds::xrce::StreamId stream_id)
+{
+    auto it = reliable_istreams_.find(stream_id);
+    if (it == reliable_istreams_.end())
+    {
+        it = reliable_istreams_.emplace(
+            std::piecewise_construct,
+            std::forward_as_tuple(stream_id),
+            std::forward_as_tuple(reliable_depth_)).first;
     }
+    return it->second;
 }
 
 } // namespace uxr
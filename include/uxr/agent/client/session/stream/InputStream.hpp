@@ -18,9 +18,11 @@
 #include <uxr/agent/config.hpp>
 #include <uxr/agent/message/Packet.hpp>
 #include <uxr/agent/utils/SeqNum.hpp>
+#include <uxr/agent/utils/SeqNumRing.hpp>
 #include <uxr/agent/client/session/SessionInfo.hpp>
 
-#include <map>
+#include <array>
+#include <cstring>
 #include <mutex>
 #include <queue>
 
@@ -197,10 +199,15 @@ inline void BestEffortInputStream::reset()
 class ReliableInputStream
 {
 public:
-    ReliableInputStream()
-        : last_handled_(UINT16_MAX),
+    explicit ReliableInputStream(
+            uint16_t depth = RELIABLE_STREAM_DEPTH)
+        : depth_(depth),
+          last_handled_(UINT16_MAX),
           last_announced_(UINT16_MAX),
-          fragment_msg_{},
+          unacked_(0),
+          messages_(depth),
+          fragment_buffer_{},
+          fragment_len_(0),
           fragment_message_available_(false)
     {}
 
@@ -228,17 +235,43 @@ public:
 
     void fill_acknack(dds::xrce::ACKNACK_Payload& acknack);
 
+    /**
+     * @brief   Records a received message, once those in order have been popped, and tells whether
+     *          the ACKNACK is due now. It is when max_pending messages are unacknowledged, when a message
+     *          is missing, or when the message was not taken, as the client may be retransmitting it
+     *          for lack of an ACKNACK.
+     */
+    bool is_acknack_due(
+            bool accepted,
+            uint16_t max_pending);
+
+    /**
+     * @brief   Whether messages have been received since the last ACKNACK.
+     */
+    bool has_unacked_messages();
+
+    /**
+     * @brief   Appends the payload of a FRAGMENT submessage to the message under reassembly.
+     *          The message is reassembled in place in a pooled buffer, grown geometrically when a fragment
+     *          does not fit, so each fragment is copied once.
+     */
     void push_fragment(InputMessagePtr& message);
 
+    /**
+     * @brief   Hands over the reassembled message, which takes ownership of the reassembly buffer.
+     */
     bool pop_fragment_message(InputMessagePtr& message);
 
     void reset();
 
 private:
+    const uint16_t depth_;
     SeqNum last_handled_;
     SeqNum last_announced_;
-    std::map<uint16_t, InputMessagePtr> messages_;
-    std::vector<uint8_t> fragment_msg_;
+    uint16_t unacked_;
+    utils::SeqNumRing<InputMessagePtr> messages_;
+    BufferPool::Buffer fragment_buffer_;
+    size_t fragment_len_;
     bool fragment_message_available_;
     std::mutex mtx_;
 };
@@ -249,23 +282,13 @@ inline bool ReliableInputStream::push_message(
 {
     bool rv = false;
     std::lock_guard<std::mutex> lock(mtx_);
-    if ((seq_num > last_handled_) && (seq_num <= last_handled_ + SeqNum(RELIABLE_STREAM_DEPTH)))
+    if ((seq_num > last_handled_) && (seq_num <= last_handled_ + SeqNum(depth_)))
     {
         if (seq_num > last_announced_)
         {
             last_announced_ = seq_num;
-            messages_.emplace(seq_num, std::move(message));
-            rv = true;
-        }
-        else
-        {
-            auto it = messages_.find(seq_num);
-            if (it == messages_.end())
-            {
-                messages_.emplace(seq_num, std::move(message));
-                rv = true;
-            }
         }
+        rv = messages_.insert(seq_num, std::move(message));
     }
     return rv;
 }
@@ -274,12 +297,9 @@ inline bool ReliableInputStream::pop_message(InputMessagePtr& message)
 {
     bool rv = false;
     std::lock_guard<std::mutex> lock(mtx_);
-    auto it = messages_.find(last_handled_ + 1);
-    if (it != messages_.end())
+    if (messages_.take(last_handled_ + 1, message))
     {
         last_handled_ += 1;
-        message = std::move(messages_.at(last_handled_));
-        messages_.erase(last_handled_);
         rv = true;
     }
     return rv;
@@ -292,25 +312,15 @@ inline bool ReliableInputStream::emplace_message(
 {
     bool rv = false;
     std::lock_guard<std::mutex> lock(mtx_);
-    if ((seq_num > last_handled_) && (seq_num <= last_handled_ + SeqNum(RELIABLE_STREAM_DEPTH)))
+    if ((seq_num > last_handled_) && (seq_num <= last_handled_ + SeqNum(depth_)))
     {
         if (seq_num > last_announced_)
         {
             last_announced_ = seq_num;
-            // gcc5 doesn't not support raw pointer as argument in std::pair when std::unique_ptr is create.
-            messages_.emplace(seq_num,
-                              std::unique_ptr<InputMessage>(new InputMessage(std::forward<Args>(args)...)));
-            rv = true;
         }
-        else
+        if (!messages_.contains(seq_num))
         {
-            auto it = messages_.find(seq_num);
-            if (it == messages_.end())
-            {
-                messages_.emplace(seq_num,
-                                  std::unique_ptr<InputMessage>(new InputMessage(std::forward<Args>(args)...)));
-                rv = true;
-            }
+            rv = messages_.insert(seq_num, InputMessagePtr(new InputMessage(std::forward<Args>(args)...)));
         }
     }
     return rv;
@@ -323,6 +333,19 @@ inline void ReliableInputStream::update_from_heartbeat(
     std::lock_guard<std::mutex> lock(mtx_);
     if (last_handled_ + 1 < first_unacked)
     {
+        /* Skipped messages are dropped so that their slots can be reused. */
+        const uint16_t skipped = uint16_t(first_unacked - (last_handled_ + 1));
+        if (skipped >= messages_.capacity())
+        {
+            messages_.clear();
+        }
+        else
+        {
+            for (uint16_t i = 0; i < skipped; ++i)
+            {
+                messages_.erase(last_handled_ + SeqNum(i + 1));
+            }
+        }
         last_handled_ = first_unacked - 1;
     }
     if (last_announced_ < last_unacked)
@@ -336,25 +359,36 @@ inline void ReliableInputStream::fill_acknack(dds::xrce::ACKNACK_Payload& acknac
     acknack.nack_bitmap() = {0, 0};
     std::lock_guard<std::mutex> lock(mtx_);
     acknack.first_unacked_seq_num(last_handled_ + 1);
-    for (uint16_t i = 0; i < 8; i++)
+
+    /* Announced messages which are not stored, those beyond the ring are never stored. */
+    const size_t bitmap_size = 16;
+    size_t announced = (last_handled_ < last_announced_) ? uint16_t(last_announced_ - last_handled_) : 0;
+    announced = (announced < bitmap_size) ? announced : bitmap_size;
+    const size_t stored = (announced < messages_.capacity()) ? announced : messages_.capacity();
+    const uint64_t announced_mask = (uint64_t(1) << announced) - 1;
+    const uint64_t nack = ~messages_.get_presence(last_handled_ + 1, stored) & announced_mask;
+
+    acknack.nack_bitmap().at(1) = uint8_t(nack & 0xFF);
+    acknack.nack_bitmap().at(0) = uint8_t(nack >> 8);
+    unacked_ = 0;
+}
+
+inline bool ReliableInputStream::is_acknack_due(
+        bool accepted,
+        uint16_t max_pending)
+{
+    std::lock_guard<std::mutex> lock(mtx_);
+    if (UINT16_MAX > unacked_)
     {
-        if (last_handled_ + SeqNum(i) < last_announced_)
-        {
-            auto it = messages_.find(last_handled_ + SeqNum(i + 1));
-            if (it == messages_.end())
-            {
-                acknack.nack_bitmap().at(1) = acknack.nack_bitmap().at(1) | (0x01 << i);
-            }
-        }
-        if (last_handled_ + SeqNum(i + 8) < last_announced_)
-        {
-            auto it = messages_.find(last_handled_ + SeqNum(i + 9));
-            if (it == messages_.end())
-            {
-                acknack.nack_bitmap().at(0) = acknack.nack_bitmap().at(0) | (0x01 << i);
-            }
-        }
+        ++unacked_;
     }
+    return !accepted || (last_handled_ < last_announced_) || (max_pending <= unacked_);
+}
+
+inline bool ReliableInputStream::has_unacked_messages()
+{
+    std::lock_guard<std::mutex> lock(mtx_);
+    return 0 != unacked_;
 }
 
 inline void ReliableInputStream::reset()
@@ -362,6 +396,7 @@ inline void ReliableInputStream::reset()
     std::lock_guard<std::mutex> lock(mtx_);
     last_handled_ = UINT16_MAX;
     last_announced_ = UINT16_MAX;
+    unacked_ = 0;
     messages_.clear();
 }
 
@@ -370,18 +405,36 @@ inline void ReliableInputStream::push_fragment(InputMessagePtr& message)
     std::lock_guard<std::mutex> lock(mtx_);
 
     /* Add header in case. */
-    if (fragment_msg_.empty())
+    std::array<uint8_t, 8> raw_header;
+    uint8_t header_size = 0;
+    if (0 == fragment_len_)
     {
-        std::array<uint8_t, 8> raw_header;
-        uint8_t header_size = message->get_raw_header(raw_header);
-        fragment_msg_.insert(fragment_msg_.begin(), std::begin(raw_header), std::begin(raw_header) + header_size);
+        header_size = message->get_raw_header(raw_header);
     }
 
-    /* Append fragment. */
-    size_t position = fragment_msg_.size();
+    /* Grow the buffer, at least doubling it, if the fragment does not fit. */
     size_t fragment_size = message->get_subheader().submessage_length();
-    fragment_msg_.resize(position + fragment_size);
-    message->get_raw_payload(fragment_msg_.data() + position, fragment_size);
+    size_t required = fragment_len_ + header_size + fragment_size;
+    if (fragment_buffer_.capacity() < required)
+    {
+        size_t doubled = 2 * fragment_buffer_.capacity();
+        BufferPool::Buffer buffer = BufferPool::get_default()->acquire((doubled > required) ? doubled : required);
+        if (0 != fragment_len_)
+        {
+            memcpy(buffer.data(), fragment_buffer_.data(), fragment_len_);
+        }
+        fragment_buffer_ = std::move(buffer);
+    }
+
+    if (0 != header_size)
+    {
+        memcpy(fragment_buffer_.data(), raw_header.data(), header_size);
+        fragment_len_ = header_size;
+    }
+
+    /* Append fragment. */
+    message->get_raw_payload(fragment_buffer_.data() + fragment_len_, fragment_size);
+    fragment_len_ += fragment_size;
 
     /* Check if last message. */
     fragment_message_available_ = (0 != (dds::xrce::FLAG_LAST_FRAGMENT & message->get_subheader().flags()));
@@ -393,8 +446,9 @@ inline bool ReliableInputStream::pop_fragment_message(InputMessagePtr& message)
     std::lock_guard<std::mutex> lock(mtx_);
     if (fragment_message_available_)
     {
-        message.reset(new InputMessage(fragment_msg_.data(), fragment_msg_.size()));
-        fragment_msg_.clear();
+        message.reset(new InputMessage(std::move(fragment_buffer_), fragment_len_));
+        fragment_buffer_ = BufferPool::Buffer();
+        fragment_len_ = 0;
         fragment_message_available_ = false;
         return true;
     }
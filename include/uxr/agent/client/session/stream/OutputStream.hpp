@@ -18,19 +18,224 @@
 #include <uxr/agent/config.hpp>
 #include <uxr/agent/message/Packet.hpp>
 #include <uxr/agent/utils/SeqNum.hpp>
+#include <uxr/agent/utils/SeqNumRing.hpp>
 #include <uxr/agent/client/session/SessionInfo.hpp>
 #include <uxr/agent/logger/Logger.hpp>
+#include <uxr/agent/utils/RecyclingAllocator.hpp>
 
 #include <memory>
 #include <queue>
 #include <mutex>
 #include <array>
-#include <map>
+#include <vector>
 #include <condition_variable>
+#include <functional>
 
 namespace eprosima {
 namespace uxr {
 
+/*
+ * Outcome of a push which does not wait for room in the window of a reliable stream.
+ */
+enum class PushResult
+{
+    pushed,
+    window_full,
+    error
+};
+
+/*
+ * Hook called once the window of a reliable stream opens after a push found it full.
+ * Streams only keep weak references to the hooks, which are called without the stream locked.
+ */
+using WindowListener = std::function<void()>;
+
+/*
+ * Size of a message carrying a single submessage.
+ */
+template<class T>
+inline size_t get_message_size(
+        const dds::xrce::MessageHeader& message_header,
+        const T& submessage)
+{
+    return message_header.getCdrSerializedSize() +
+           dds::xrce::SubmessageHeader().getCdrSerializedSize() +
+           submessage.getCdrSerializedSize();
+}
+
+/*
+ * Part of that size which is serialized into the message buffer, the data of a
+ * ScatteredDataPayload stays in its own segment.
+ */
+template<class T>
+inline size_t get_message_head_size(
+        const dds::xrce::MessageHeader& message_header,
+        const T& submessage)
+{
+    return get_message_size(message_header, submessage);
+}
+
+inline size_t get_message_head_size(
+        const dds::xrce::MessageHeader& message_header,
+        const ScatteredDataPayload& submessage)
+{
+    return message_header.getCdrSerializedSize() +
+           dds::xrce::SubmessageHeader().getCdrSerializedSize() +
+           submessage.request.getCdrSerializedSize();
+}
+
+/*
+ * Serialized submessage to be split into fragments: a few leading bytes held inline, followed by a body
+ * which the fragments reference. A ScatteredDataPayload only serializes its subheader and request inline,
+ * any other submessage is serialized once into a shared pooled buffer.
+ */
+struct FragmentSource
+{
+    static constexpr size_t MAX_INLINE_LEN = 16;
+
+    std::array<uint8_t, MAX_INLINE_LEN> inline_buf;
+    size_t inline_len;
+    std::shared_ptr<const BufferPool::Buffer> body;
+    size_t body_len;
+
+    size_t get_len() const { return inline_len + body_len; }
+};
+
+template<class T>
+inline bool make_fragment_source(
+        const dds::xrce::SubmessageHeader& submessage_header,
+        const T& submessage,
+        FragmentSource& source)
+{
+    const size_t submessage_size = submessage_header.getCdrSerializedSize() + submessage.getCdrSerializedSize();
+    std::shared_ptr<BufferPool::Buffer> body =
+        std::allocate_shared<BufferPool::Buffer>(
+            utils::RecyclingAllocator<BufferPool::Buffer>(), BufferPool::get_default()->acquire(submessage_size));
+
+    fastcdr::FastBuffer fastbuffer(reinterpret_cast<char*>(body->data()), submessage_size);
+    fastcdr::Cdr serializer(fastbuffer, eprosima::fastcdr::Cdr::DEFAULT_ENDIAN, eprosima::fastcdr::CdrVersion::XCDRv1);
+    try
+    {
+        submessage_header.serialize(serializer);
+        submessage.serialize(serializer);
+    }
+    catch(eprosima::fastcdr::exception::NotEnoughMemoryException & /*exception*/)
+    {
+        return false;
+    }
+
+    source.inline_len = 0;
+    source.body = std::move(body);
+    source.body_len = submessage_size;
+    return true;
+}
+
+inline bool make_fragment_source(
+        const dds::xrce::SubmessageHeader& submessage_header,
+        const ScatteredDataPayload& submessage,
+        FragmentSource& source)
+{
+    const size_t inline_len = submessage_header.getCdrSerializedSize() + submessage.request.getCdrSerializedSize();
+    if (FragmentSource::MAX_INLINE_LEN < inline_len)
+    {
+        return false;
+    }
+
+    fastcdr::FastBuffer fastbuffer(reinterpret_cast<char*>(source.inline_buf.data()), inline_len);
+    fastcdr::Cdr serializer(fastbuffer, eprosima::fastcdr::Cdr::DEFAULT_ENDIAN, eprosima::fastcdr::CdrVersion::XCDRv1);
+    try
+    {
+        submessage_header.serialize(serializer);
+        submessage.request.serialize(serializer);
+    }
+    catch(eprosima::fastcdr::exception::NotEnoughMemoryException & /*exception*/)
+    {
+        return false;
+    }
+
+    source.inline_len = inline_len;
+    source.body = submessage.data;
+    source.body_len = submessage.len;
+    return true;
+}
+
+/*
+ * Messages of a stream, each holding a single submessage, which are packed into one message on release.
+ * All of them share the header of the first one. A batch of a single message is released as is, so
+ * submessages are only copied when they are actually packed.
+ */
+class OutputBatch
+{
+public:
+    OutputBatch() = default;
+
+    bool empty() const { return messages_.empty(); }
+
+    /*
+     * Whether a message of the given size could be added without the packed message exceeding the MTU.
+     */
+    bool accepts(
+            size_t message_size,
+            size_t mtu) const
+    {
+        return empty() || ((((len_ + 3) & ~size_t(3)) + message_size - header_len_) <= mtu);
+    }
+
+    void push(
+            const dds::xrce::MessageHeader& message_header,
+            OutputMessagePtr&& output_message);
+
+    OutputMessagePtr release();
+
+    void clear()
+    {
+        messages_.clear();
+        len_ = 0;
+    }
+
+private:
+    dds::xrce::MessageHeader message_header_;
+    std::vector<OutputMessagePtr> messages_;
+    size_t header_len_ = 0;
+    size_t len_ = 0;
+};
+
+inline void OutputBatch::push(
+        const dds::xrce::MessageHeader& message_header,
+        OutputMessagePtr&& output_message)
+{
+    if (empty())
+    {
+        message_header_ = message_header;
+        header_len_ = output_message->get_header_len();
+        len_ = output_message->get_len();
+    }
+    else
+    {
+        len_ = ((len_ + 3) & ~size_t(3)) + output_message->get_len() - header_len_;
+    }
+    messages_.push_back(std::move(output_message));
+}
+
+inline OutputMessagePtr OutputBatch::release()
+{
+    OutputMessagePtr output_message;
+    if (1 == messages_.size())
+    {
+        output_message = std::move(messages_.front());
+    }
+    else if (!messages_.empty())
+    {
+        output_message = OutputMessage::create(message_header_, len_);
+        for (const auto& message : messages_)
+        {
+            output_message->append_submessages(*message);
+        }
+    }
+    clear();
+    return output_message;
+}
+
 /****************************************************************************************
  * None Output Stream.
  ****************************************************************************************/
@@ -48,16 +253,32 @@ public:
 
     void reset();
 
+    /**
+     * @brief   Pushes a submessage into the stream.
+     * @param   coalesce    Whether the submessage may be packed, together with the next ones,
+     *                      into a message which is kept open until the stream is flushed.
+     */
     template<class T>
     bool push_submessage(
             const SessionInfo& session_info,
             dds::xrce::SubmessageId id,
-            const T& submessage);
+            const T& submessage,
+            bool coalesce = false);
+
+    /**
+     * @brief   Pops the next message of the stream.
+     * @param   flush   Whether the open message, if any, shall be closed first.
+     */
+    bool pop_message(
+            OutputMessagePtr& output_message,
+            bool flush = true);
 
-    bool pop_message(OutputMessagePtr& output_message);
+private:
+    void close_batch();
 
 private:
     std::queue<OutputMessagePtr> messages_;
+    OutputBatch batch_;
     std::mutex mtx_;
 };
 
@@ -68,41 +289,69 @@ inline void NoneOutputStream::reset()
     {
         messages_.pop();
     }
+    batch_.clear();
+}
+
+inline void NoneOutputStream::close_batch()
+{
+    if (!batch_.empty())
+    {
+        messages_.push(batch_.release());
+    }
 }
 
 template<class T>
 inline bool NoneOutputStream::push_submessage(
         const SessionInfo& session_info,
         dds::xrce::SubmessageId id,
-        const T& submessage)
+        const T& submessage,
+        bool coalesce)
 {
     bool rv = false;
     std::lock_guard<std::mutex> lock(mtx_);
-    if (BEST_EFFORT_STREAM_DEPTH > messages_.size())
+
+    /* Message header. */
+    dds::xrce::MessageHeader message_header;
+    message_header.session_id(session_info.session_id);
+    message_header.stream_id(dds::xrce::STREAMID_NONE);
+    message_header.sequence_nr(0x00);
+    message_header.client_key(session_info.client_key);
+
+    const size_t message_size = get_message_size(message_header, submessage);
+    if (!coalesce || !batch_.accepts(message_size, session_info.mtu))
     {
-        /* Message header. */
-        dds::xrce::MessageHeader message_header;
-        message_header.session_id(session_info.session_id);
-        message_header.stream_id(dds::xrce::STREAMID_NONE);
-        message_header.sequence_nr(0x00);
-        message_header.client_key(session_info.client_key);
+        close_batch();
+    }
 
-        /* Create message. */
-        OutputMessagePtr output_message(new OutputMessage(message_header, session_info.mtu));
+    if ((!batch_.empty() || (BEST_EFFORT_STREAM_DEPTH > messages_.size())) && (session_info.mtu >= message_size))
+    {
+        /* Create message, sized after its content. */
+        OutputMessagePtr output_message =
+            OutputMessage::create(message_header, get_message_head_size(message_header, submessage));
         if (output_message->append_submessage(id, submessage))
         {
             /* Push message. */
-            messages_.push(std::move(output_message));
+            batch_.push(message_header, std::move(output_message));
+            if (!coalesce)
+            {
+                close_batch();
+            }
             rv = true;
         }
     }
     return rv;
 }
 
-inline bool NoneOutputStream::pop_message(OutputMessagePtr& output_message)
+inline bool NoneOutputStream::pop_message(
+        OutputMessagePtr& output_message,
+        bool flush)
 {
     bool rv = false;
     std::lock_guard<std::mutex> lock(mtx_);
+    if (flush)
+    {
+        close_batch();
+    }
     if (!messages_.empty())
     {
         output_message = std::move(messages_.front());
@@ -133,17 +382,33 @@ public:
 //    void promote_stream() { last_sent_ += 1; }
     void reset();
 
+    /**
+     * @brief   Pushes a submessage into the stream.
+     * @param   coalesce    Whether the submessage may be packed, together with the next ones,
+     *                      into a message which is kept open until the stream is flushed.
+     */
     template<class T>
     bool push_submessage(
             const SessionInfo& session_info,
             dds::xrce::StreamId stream_id,
             dds::xrce::SubmessageId submessage_id,
-            const T& submessage);
+            const T& submessage,
+            bool coalesce = false);
 
-    bool pop_message(OutputMessagePtr& output_message);
+    /**
+     * @brief   Pops the next message of the stream.
+     * @param   flush   Whether the open message, if any, shall be closed first.
+     */
+    bool pop_message(
+            OutputMessagePtr& output_message,
+            bool flush = true);
+
+private:
+    void close_batch();
 
 private:
     std::queue<OutputMessagePtr> messages_;
+    OutputBatch batch_;
     SeqNum last_sent_;
     std::mutex mtx_;
 };
@@ -155,29 +420,46 @@ inline void BestEffortOutputStream::reset()
     {
         messages_.pop();
     }
+    batch_.clear();
     last_sent_ = UINT16_MAX;
 }
 
+inline void BestEffortOutputStream::close_batch()
+{
+    if (!batch_.empty())
+    {
+        messages_.push(batch_.release());
+        last_sent_ += 1;
+    }
+}
+
 template<class T>
 inline bool BestEffortOutputStream::push_submessage(
         const SessionInfo& session_info,
         dds::xrce::StreamId stream_id,
         dds::xrce::SubmessageId submessage_id,
-        const T& submessage)
+        const T& submessage,
+        bool coalesce)
 {
     bool rv = false;
     std::lock_guard<std::mutex> lock(mtx_);
-    if (BEST_EFFORT_STREAM_DEPTH > messages_.size())
+
+    /* Message header, the sequence number is set once the open message, if any, is settled. */
+    dds::xrce::MessageHeader message_header;
+    message_header.session_id(session_info.session_id);
+    message_header.stream_id(stream_id);
+    message_header.client_key(session_info.client_key);
+
+    const size_t message_size = get_message_size(message_header, submessage);
+    if (!coalesce || !batch_.accepts(message_size, session_info.mtu))
+    {
+        close_batch();
+    }
+
+    if (!batch_.empty() || (BEST_EFFORT_STREAM_DEPTH > messages_.size()))
     {
-        /* Message header. */
-        dds::xrce::MessageHeader message_header;
-        message_header.session_id(session_info.session_id);
-        message_header.stream_id(stream_id);
         message_header.sequence_nr(last_sent_ + 1);
-        message_header.client_key(session_info.client_key);
 
-        /* Create message. */
-        OutputMessagePtr output_message(new OutputMessage(message_header, session_info.mtu));
         if (session_info.mtu < submessage.getCdrSerializedSize())
         {
             UXR_AGENT_LOG_WARN(
@@ -187,21 +469,36 @@ inline bool BestEffortOutputStream::push_submessage(
                 session_info.mtu);
             rv = true;
         }
-        else if (output_message->append_submessage(submessage_id, submessage))
+        else if (session_info.mtu >= message_size)
         {
-            /* Push message. */
-            messages_.push(std::move(output_message));
-            last_sent_ += 1;
-            rv = true;
+            /* Create message, sized after its content. */
+            OutputMessagePtr output_message =
+                OutputMessage::create(message_header, get_message_head_size(message_header, submessage));
+            if (output_message->append_submessage(submessage_id, submessage))
+            {
+                /* Push message. */
+                batch_.push(message_header, std::move(output_message));
+                if (!coalesce)
+                {
+                    close_batch();
+                }
+                rv = true;
+            }
         }
     }
     return rv;
 }
 
-inline bool BestEffortOutputStream::pop_message(OutputMessagePtr& output_message)
+inline bool BestEffortOutputStream::pop_message(
+        OutputMessagePtr& output_message,
+        bool flush)
 {
     std::lock_guard<std::mutex> lock(mtx_);
     bool rv = false;
+    if (flush)
+    {
+        close_batch();
+    }
     if (!messages_.empty())
     {
         output_message = std::move(messages_.front());
@@ -217,8 +514,11 @@ inline bool BestEffortOutputStream::pop_message(OutputMessagePtr& output_message
 class ReliableOutputStream
 {
 public:
-    ReliableOutputStream()
-        : last_unacked_(UINT16_MAX)
+    explicit ReliableOutputStream(
+            uint16_t depth = RELIABLE_STREAM_DEPTH)
+        : depth_(depth)
+        , messages_(depth)
+        , last_unacked_(UINT16_MAX)
         , last_sent_(UINT16_MAX)
         , first_unacked_(0x0000)
     {}
@@ -227,15 +527,43 @@ public:
 
     void reset();
 
+    /**
+     * @brief   Pushes a submessage into the stream, waiting up to the timeout for room in the window.
+     * @param   coalesce    Whether the submessage may be packed, together with the next ones,
+     *                      into a message which is kept open until the stream is flushed.
+     *                      An open message already holds its sequence number, so packing into it needs no room.
+     */
     template<class T>
     bool push_submessage(
             const SessionInfo& session_info,
             dds::xrce::StreamId stream_id,
             dds::xrce::SubmessageId submessage_id,
             const T& submessage,
-            std::chrono::milliseconds timeout);
+            std::chrono::milliseconds timeout,
+            bool coalesce = false);
+
+    /**
+     * @brief   Pushes a submessage into the stream without waiting for room in the window.
+     * @param   listener    Hook registered when the window is full, which is called once the window opens.
+     *                      A hook is registered once however many pushes it is given to.
+     * @param   coalesce    As in push_submessage().
+     */
+    template<class T>
+    PushResult try_push_submessage(
+            const SessionInfo& session_info,
+            dds::xrce::StreamId stream_id,
+            dds::xrce::SubmessageId submessage_id,
+            const T& submessage,
+            const std::shared_ptr<WindowListener>& listener,
+            bool coalesce = false);
 
-    bool get_next_message(OutputMessagePtr& output_message);
+    /**
+     * @brief   Gets the next message to send.
+     * @param   flush   Whether the open message, if any, shall be closed first.
+     */
+    bool get_next_message(
+            OutputMessagePtr& output_message,
+            bool flush = true);
 
     bool get_message(
             SeqNum seq_num,
@@ -246,7 +574,42 @@ public:
     bool fill_heartbeat(dds::xrce::HEARTBEAT_Payload& heartbeat);
 
 private:
-    std::map<uint16_t, OutputMessagePtr> messages_;
+    static dds::xrce::MessageHeader get_message_header(
+            const SessionInfo& session_info,
+            dds::xrce::StreamId stream_id);
+
+    bool is_window_available() const;
+
+    /*
+     * Closes the open message unless the submessage can be packed into it.
+     * Returns whether the submessage may be pushed, either into the open message or into the window.
+     */
+    bool settle_batch(
+            size_t message_size,
+            size_t mtu,
+            bool coalesce);
+
+    template<class T>
+    bool push_ready_submessage(
+            const SessionInfo& session_info,
+            dds::xrce::StreamId stream_id,
+            dds::xrce::SubmessageId submessage_id,
+            const T& submessage,
+            bool coalesce);
+
+    void add_window_listener(
+            const std::shared_ptr<WindowListener>& listener);
+
+    static void notify_window_listeners(
+            std::vector<std::weak_ptr<WindowListener>>& listeners);
+
+    void close_batch();
+
+private:
+    const uint16_t depth_;
+    utils::SeqNumRing<OutputMessagePtr> messages_;
+    OutputBatch batch_;
+    std::vector<std::weak_ptr<WindowListener>> window_listeners_;
     SeqNum last_unacked_;
     SeqNum last_sent_;
     SeqNum first_unacked_;
@@ -269,11 +632,26 @@ private:
 //
 inline void ReliableOutputStream::reset()
 {
-    std::lock_guard<std::mutex> lock(mtx_);
+    std::vector<std::weak_ptr<WindowListener>> listeners;
+    std::unique_lock<std::mutex> lock(mtx_);
     last_unacked_ = UINT16_MAX;
     last_sent_ = UINT16_MAX;
     first_unacked_ = 0x0000;
     messages_.clear();
+    batch_.clear();
+    listeners.swap(window_listeners_);
+    lock.unlock();
+
+    notify_window_listeners(listeners);
+}
+
+inline void ReliableOutputStream::close_batch()
+{
+    if (!batch_.empty())
+    {
+        last_unacked_ += 1;
+        messages_.insert(last_unacked_, batch_.release());
+    }
 }
 
 template<class T>
@@ -282,110 +660,244 @@ inline bool ReliableOutputStream::push_submessage(
         dds::xrce::StreamId stream_id,
         dds::xrce::SubmessageId submessage_id,
         const T& submessage,
-        std::chrono::milliseconds timeout)
+        std::chrono::milliseconds timeout,
+        bool coalesce)
 {
-    bool rv = false;
     std::unique_lock<std::mutex> lock(mtx_);
-    auto now = std::chrono::steady_clock::now();
-
-    if (cv_.wait_until(
-            lock,
-            now + timeout, [&](){ return last_unacked_ < first_unacked_ + SeqNum(RELIABLE_STREAM_DEPTH - 1); }))
-    {
-        /* Message header. */
-        dds::xrce::MessageHeader message_header;
-        message_header.session_id(session_info.session_id);
-        message_header.stream_id(stream_id);
-        message_header.client_key(session_info.client_key);
-
-        /* Submessage header. */
-        dds::xrce::SubmessageHeader submessage_header;
-        submessage_header.submessage_id(submessage_id);
-        submessage_header.flags(dds::xrce::FLAG_LITTLE_ENDIANNESS);
-        submessage_header.submessage_length(uint16_t(submessage.getCdrSerializedSize()));
-
-        /* Compute message size. */
-        const size_t header_size = message_header.getCdrSerializedSize();
-        const size_t subheader_size = submessage_header.getCdrSerializedSize();
-        const size_t submessage_size = subheader_size + submessage.getCdrSerializedSize();
-
-        /* Push submessage. */
-        if ((header_size + submessage_size) <= session_info.mtu)
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    auto window_available = [&](){ return is_window_available(); };
+    const size_t message_size = get_message_size(get_message_header(session_info, stream_id), submessage);
+
+    /* Settle the open message, the lock is released while waiting so it may change meanwhile. */
+    bool ready = false;
+    do
+    {
+        ready = settle_batch(message_size, session_info.mtu, coalesce);
+    } while (!ready && cv_.wait_until(lock, deadline, window_available));
+
+    return ready && push_ready_submessage(session_info, stream_id, submessage_id, submessage, coalesce);
+}
+
+template<class T>
+inline PushResult ReliableOutputStream::try_push_submessage(
+        const SessionInfo& session_info,
+        dds::xrce::StreamId stream_id,
+        dds::xrce::SubmessageId submessage_id,
+        const T& submessage,
+        const std::shared_ptr<WindowListener>& listener,
+        bool coalesce)
+{
+    std::lock_guard<std::mutex> lock(mtx_);
+    const size_t message_size = get_message_size(get_message_header(session_info, stream_id), submessage);
+    if (!settle_batch(message_size, session_info.mtu, coalesce))
+    {
+        if (listener)
         {
-            /* Create message. */
-            last_unacked_ += 1;
-            message_header.sequence_nr(last_unacked_);
-            OutputMessagePtr output_message(new OutputMessage(message_header, header_size + submessage_size));
-            if (output_message->append_submessage(submessage_id, submessage))
+            add_window_listener(listener);
+        }
+        return PushResult::window_full;
+    }
+    return push_ready_submessage(session_info, stream_id, submessage_id, submessage, coalesce)
+        ? PushResult::pushed
+        : PushResult::error;
+}
+
+inline dds::xrce::MessageHeader ReliableOutputStream::get_message_header(
+        const SessionInfo& session_info,
+        dds::xrce::StreamId stream_id)
+{
+    dds::xrce::MessageHeader message_header;
+    message_header.session_id(session_info.session_id);
+    message_header.stream_id(stream_id);
+    message_header.client_key(session_info.client_key);
+    return message_header;
+}
+
+inline bool ReliableOutputStream::is_window_available() const
+{
+    return last_unacked_ < first_unacked_ + SeqNum(depth_ - 1);
+}
+
+inline bool ReliableOutputStream::settle_batch(
+        size_t message_size,
+        size_t mtu,
+        bool coalesce)
+{
+    if (!coalesce || (message_size > mtu) || !batch_.accepts(message_size, mtu))
+    {
+        close_batch();
+    }
+    return !batch_.empty() || is_window_available();
+}
+
+inline void ReliableOutputStream::add_window_listener(
+        const std::shared_ptr<WindowListener>& listener)
+{
+    for (auto it = window_listeners_.begin(); it != window_listeners_.end();)
+    {
+        if (it->expired())
+        {
+            it = window_listeners_.erase(it);
+        }
+        else if (!it->owner_before(listener) && !listener.owner_before(*it))
+        {
+            return;
+        }
+        else
+        {
+            ++it;
+        }
+    }
+    window_listeners_.emplace_back(listener);
+}
+
+inline void ReliableOutputStream::notify_window_listeners(
+        std::vector<std::weak_ptr<WindowListener>>& listeners)
+{
+    for (auto& weak_listener : listeners)
+    {
+        std::shared_ptr<WindowListener> listener = weak_listener.lock();
+        if (listener)
+        {
+            (*listener)();
+        }
+    }
+}
+
+template<class T>
+inline bool ReliableOutputStream::push_ready_submessage(
+        const SessionInfo& session_info,
+        dds::xrce::StreamId stream_id,
+        dds::xrce::SubmessageId submessage_id,
+        const T& submessage,
+        bool coalesce)
+{
+    bool rv = false;
+
+    /* Message header. */
+    dds::xrce::MessageHeader message_header = get_message_header(session_info, stream_id);
+
+    /* Submessage header. */
+    dds::xrce::SubmessageHeader submessage_header;
+    submessage_header.submessage_id(submessage_id);
+    submessage_header.flags(dds::xrce::FLAG_LITTLE_ENDIANNESS);
+    submessage_header.submessage_length(uint16_t(submessage.getCdrSerializedSize()));
+
+    /* Compute message size. */
+    const size_t header_size = message_header.getCdrSerializedSize();
+    const size_t subheader_size = submessage_header.getCdrSerializedSize();
+    const size_t submessage_size = subheader_size + submessage.getCdrSerializedSize();
+    const bool fragmented = ((header_size + submessage_size) > session_info.mtu);
+
+    /* Push submessage. */
+    if (!fragmented)
+    {
+        /* Create message. */
+        message_header.sequence_nr(last_unacked_ + 1);
+        OutputMessagePtr output_message =
+            OutputMessage::create(message_header, get_message_head_size(message_header, submessage));
+        if (output_message->append_submessage(submessage_id, submessage))
+        {
+            /* Push message. */
+            batch_.push(message_header, std::move(output_message));
+            if (!coalesce)
             {
-                /* Push message. */
-                messages_.insert(std::make_pair(last_unacked_, std::move(output_message)));
-                rv = true;
+                close_batch();
             }
+            rv = true;
         }
-        else
+    }
+    else
+    {
+        /* Serialize submessage, the fragments reference slices of it instead of copying them. */
+        FragmentSource source;
+        if (!make_fragment_source(submessage_header, submessage, source) || (source.get_len() != submessage_size))
+        {
+            return false;
+        }
+
+        const size_t max_fragment_size = session_info.mtu - header_size - subheader_size;
+
+        /* Fragments are not bounded by the window, so the ring may have to grow to hold them all. */
+        const size_t fragment_count = (submessage_size + max_fragment_size - 1) / max_fragment_size;
+        messages_.reserve(first_unacked_, size_t(uint16_t(last_unacked_ - first_unacked_ + 1)) + fragment_count);
+        dds::xrce::SubmessageHeader fragment_subheader;
+        fragment_subheader.submessage_id(dds::xrce::FRAGMENT);
+        fragment_subheader.flags(dds::xrce::FLAG_LITTLE_ENDIANNESS);
+        fragment_subheader.submessage_length(uint16_t(max_fragment_size));
+
+        size_t serialized_size = 0;
+        do
         {
-            /* Serialize submessage. */
-            std::unique_ptr<uint8_t[]> buf(new uint8_t[submessage_size]);
-            fastcdr::FastBuffer fastbuffer(reinterpret_cast<char*>(buf.get()), submessage_size);
-            fastcdr::Cdr serializer(fastbuffer, eprosima::fastcdr::Cdr::DEFAULT_ENDIAN, eprosima::fastcdr::CdrVersion::XCDRv1);
-            submessage_header.serialize(serializer);
-            submessage.serialize(serializer);
-
-            const size_t max_fragment_size = session_info.mtu - header_size - subheader_size;
-            dds::xrce::SubmessageHeader fragment_subheader;
-            fragment_subheader.submessage_id(dds::xrce::FRAGMENT);
-            fragment_subheader.flags(dds::xrce::FLAG_LITTLE_ENDIANNESS);
-            fragment_subheader.submessage_length(uint16_t(max_fragment_size));
-
-            uint16_t serialized_size = 0;
-            do
+            uint16_t fragment_size;
+            if (session_info.mtu < (header_size + subheader_size + (submessage_size - serialized_size)))
             {
-                uint16_t fragment_size;
-                if (session_info.mtu < (header_size + subheader_size + (submessage_size - serialized_size)))
-                {
-                    fragment_size = uint16_t(max_fragment_size);
-                }
-                else
-                {
-                    fragment_size = uint16_t(submessage_size - serialized_size);
-                    fragment_subheader.flags(submessage_header.flags() | dds::xrce::FLAG_LAST_FRAGMENT);
-                }
-                fragment_subheader.submessage_length(fragment_size);
+                fragment_size = uint16_t(max_fragment_size);
+            }
+            else
+            {
+                fragment_size = uint16_t(submessage_size - serialized_size);
+                fragment_subheader.flags(submessage_header.flags() | dds::xrce::FLAG_LAST_FRAGMENT);
+            }
+            fragment_subheader.submessage_length(fragment_size);
 
-                const size_t current_message_size = header_size + subheader_size + fragment_size;
+            /* Leading bytes still within the inline part are copied, the rest is a slice of the body. */
+            size_t inline_len = 0;
+            if (serialized_size < source.inline_len)
+            {
+                inline_len = source.inline_len - serialized_size;
+                inline_len = (inline_len < fragment_size) ? inline_len : fragment_size;
+            }
+            const size_t body_len = fragment_size - inline_len;
+            const size_t body_offset = (0 != body_len) ? (serialized_size + inline_len - source.inline_len) : 0;
 
-                /* Create message. */
-                last_unacked_ += 1;
-                message_header.sequence_nr(last_unacked_);
-                OutputMessagePtr output_message(new OutputMessage(message_header, current_message_size));
-                if (output_message->append_fragment(fragment_subheader,  buf.get() + serialized_size, fragment_size))
-                {
-                    /* Push message. */
-                    messages_.insert(std::make_pair(last_unacked_, std::move(output_message)));
-                    serialized_size += fragment_size;
-                }
-                else
-                {
-                    break;
-                }
+            /* Create message. */
+            last_unacked_ += 1;
+            message_header.sequence_nr(last_unacked_);
+            OutputMessagePtr output_message =
+                OutputMessage::create(message_header, header_size + subheader_size + inline_len);
+            if (output_message->append_fragment(
+                    fragment_subheader,
+                    source.inline_buf.data() + ((0 != inline_len) ? serialized_size : 0),
+                    inline_len,
+                    source.body,
+                    body_offset,
+                    body_len))
+            {
+                /* Push message. */
+                messages_.insert(last_unacked_, std::move(output_message));
+                serialized_size += fragment_size;
+            }
+            else
+            {
+                break;
+            }
 
-            } while (serialized_size < submessage_size);
-            rv = (serialized_size == submessage_size);
-        }
+        } while (serialized_size < submessage_size);
+        rv = (serialized_size == submessage_size);
     }
     return rv;
 }
 
-inline bool ReliableOutputStream::get_next_message(OutputMessagePtr& output_message)
+inline bool ReliableOutputStream::get_next_message(
+        OutputMessagePtr& output_message,
+        bool flush)
 {
     bool rv = false;
     std::lock_guard<std::mutex> lock(mtx_);
+    if (flush)
+    {
+        close_batch();
+    }
     if (last_sent_ < last_unacked_)
     {
         last_sent_ += 1;
-        output_message = messages_.at(last_sent_);
-        rv = true;
+        OutputMessagePtr* message = messages_.find(last_sent_);
+        if (nullptr != message)
+        {
+            output_message = *message;
+            rv = true;
+        }
     }
     return rv;
 }
@@ -396,10 +908,10 @@ inline bool ReliableOutputStream::get_message(
 {
     bool rv = false;
     std::lock_guard<std::mutex> lock(mtx_);
-    auto it = messages_.find(seq_num);
-    if (it != messages_.end())
+    OutputMessagePtr* message = messages_.find(seq_num);
+    if (nullptr != message)
     {
-        output_message = it->second;
+        output_message = *message;
         rv = true;
     }
     return rv;
@@ -407,7 +919,8 @@ inline bool ReliableOutputStream::get_message(
 
 inline void ReliableOutputStream::update_from_acknack(SeqNum first_unacked)
 {
-    std::lock_guard<std::mutex> lock(mtx_);
+    std::vector<std::weak_ptr<WindowListener>> listeners;
+    std::unique_lock<std::mutex> lock(mtx_);
     if (first_unacked <= last_sent_ + 1)
     {
         while (first_unacked > first_unacked_)
@@ -416,7 +929,16 @@ inline void ReliableOutputStream::update_from_acknack(SeqNum first_unacked)
             first_unacked_ += 1;
         }
         cv_.notify_one();
+
+        /* Producers are resumed as soon as there is credit, rather than polling for it. */
+        if (is_window_available())
+        {
+            listeners.swap(window_listeners_);
+        }
     }
+    lock.unlock();
+
+    notify_window_listeners(listeners);
 }
 
 inline bool ReliableOutputStream::fill_heartbeat(dds::xrce::HEARTBEAT_Payload& heartbeat)
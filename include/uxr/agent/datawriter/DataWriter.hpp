@@ -16,6 +16,7 @@
 #define UXR_AGENT_DATAWRITER_DATAWRITER_HPP_
 
 #include <uxr/agent/object/XRCEObject.hpp>
+#include <uxr/agent/middleware/Middleware.hpp>
 #include <string>
 #include <set>
 
@@ -25,7 +26,6 @@ namespace uxr {
 class Publisher;
 class ProxyClient;
 class Topic;
-class Middleware;
 
 class DataWriter : public XRCEObject
 {
@@ -47,6 +47,17 @@ public:
 
     bool write(dds::xrce::WRITE_DATA_Payload_Data& write_data);
     bool write(const std::vector<uint8_t>& data);
+    bool write(
+        const uint8_t* buf,
+        size_t len);
+
+    /**
+     * @brief   Writes consecutive samples, stopping at the first one which cannot be written.
+     * @return  The number of samples written.
+     */
+    size_t write_batch(
+        const Middleware::SampleView* samples,
+        size_t count);
 
 private:
     DataWriter(const dds::xrce::ObjectId& object_id,
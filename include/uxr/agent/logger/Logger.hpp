@@ -91,6 +91,7 @@
 #define UXR_CREATE_REPLIER_PATTERN      UXR_CREATE_FORMAT_BASE(REPLIER_ID)      UXR_ADD_FIELD(PARTICIPANT_ID)
 #define UXR_MESSAGE_PATTERN             UXR_FIELD(CLIENT_KEY)                   UXR_ADD_FIELD(LEN)
 #define UXR_MESSAGE_WITH_DATA_PATTERN   UXR_MESSAGE_PATTERN                     UXR_ADD_FIELD(DATA)
+#define UXR_MESSAGE_WITH_SEGMENTS_PATTERN UXR_MESSAGE_WITH_DATA_PATTERN         UXR_DATA_FORMAT
 #define UXR_MESSAGE_WITH_FD_PATTERN     UXR_CREATE_FORMAT_BASE(FILE_FD)         UXR_ADD_FIELD(LEN)      UXR_ADD_FIELD(DATA)
 
 
@@ -149,6 +150,19 @@
     } \
     void(0)
 
+/* Message sent as its serialized part followed by a payload segment, logged with the length of both. */
+#define UXR_AGENT_LOG_SEGMENTED_MESSAGE(STATUS, CLIENT_KEY, HEAD, HEAD_LEN, PAYLOAD, PAYLOAD_LEN) \
+    if (spdlog::default_logger()->should_log(spdlog::level::trace)) \
+    { \
+        UXR_AGENT_LOG_DEBUG(STATUS, UXR_MESSAGE_WITH_SEGMENTS_PATTERN, CLIENT_KEY, (HEAD_LEN) + (PAYLOAD_LEN), \
+            spdlog::to_hex(HEAD, HEAD + HEAD_LEN), spdlog::to_hex(PAYLOAD, PAYLOAD + PAYLOAD_LEN)); \
+    } \
+    else \
+    { \
+        UXR_AGENT_LOG_DEBUG(STATUS, UXR_MESSAGE_PATTERN, CLIENT_KEY, (HEAD_LEN) + (PAYLOAD_LEN)); \
+    } \
+    void(0)
+
 #define UXR_MULTIAGENT_LOG_MESSAGE(STATUS, CLIENT_KEY, FD, BUF, LEN) \
     if (spdlog::default_logger()->should_log(spdlog::level::trace)) \
     { \
@@ -161,6 +175,7 @@
     void(0)
 #else
 #define UXR_AGENT_LOG_MESSAGE(...) void(0)
+#define UXR_AGENT_LOG_SEGMENTED_MESSAGE(...) void(0)
 #define UXR_MULTIAGENT_LOG_MESSAGE(...) void(0)
 #endif
 
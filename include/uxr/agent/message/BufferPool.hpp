@@ -0,0 +1,249 @@
+// Copyright 2018 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef UXR_AGENT_MESSAGE_BUFFER_POOL_HPP_
+#define UXR_AGENT_MESSAGE_BUFFER_POOL_HPP_
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace eprosima {
+namespace uxr {
+
+/**
+ * @brief   Pool of message buffers grouped in power-of-four size classes, from 64 B to 64 KiB.
+ *          Released buffers are kept in the free list of their class, up to a count and a memory
+ *          budget per class, so that in steady state acquiring a buffer does not reach the allocator. Requests larger than the
+ *          biggest class are served with a dedicated allocation, which is not cached.
+ *          Buffers keep the pool alive, so they may outlive its creator.
+ */
+class BufferPool : public std::enable_shared_from_this<BufferPool>
+{
+public:
+    class Buffer
+    {
+    public:
+        Buffer()
+            : data_(nullptr)
+            , capacity_(0)
+            , pool_()
+        {}
+
+        ~Buffer()
+        {
+            release();
+        }
+
+        Buffer(Buffer&& other) noexcept
+            : data_(other.data_)
+            , capacity_(other.capacity_)
+            , pool_(std::move(other.pool_))
+        {
+            other.data_ = nullptr;
+            other.capacity_ = 0;
+        }
+
+        Buffer& operator=(Buffer&& other) noexcept
+        {
+            if (this != &other)
+            {
+                release();
+                data_ = other.data_;
+                capacity_ = other.capacity_;
+                pool_ = std::move(other.pool_);
+                other.data_ = nullptr;
+                other.capacity_ = 0;
+            }
+            return *this;
+        }
+
+        Buffer(const Buffer&) = delete;
+        Buffer& operator=(const Buffer&) = delete;
+
+        uint8_t* data() const { return data_; }
+
+        size_t capacity() const { return capacity_; }
+
+        explicit operator bool() const { return nullptr != data_; }
+
+    private:
+        friend class BufferPool;
+
+        void release()
+        {
+            if (nullptr != data_)
+            {
+                pool_->release(data_, capacity_);
+                data_ = nullptr;
+                capacity_ = 0;
+                pool_.reset();
+            }
+        }
+
+        uint8_t* data_;
+        size_t capacity_;
+        std::shared_ptr<BufferPool> pool_;
+    };
+
+    /**
+     * @brief   Creates a pool.
+     * @param   max_cached_buffers  Maximum number of free buffers kept per size class.
+     */
+    static std::shared_ptr<BufferPool> create(
+            size_t max_cached_buffers = DEFAULT_MAX_CACHED_BUFFERS)
+    {
+        return std::shared_ptr<BufferPool>(new BufferPool(max_cached_buffers));
+    }
+
+    /**
+     * @brief   Pool used by the messages which are not built by a server.
+     */
+    static const std::shared_ptr<BufferPool>& get_default()
+    {
+        static std::shared_ptr<BufferPool> default_pool = create();
+        return default_pool;
+    }
+
+    ~BufferPool()
+    {
+        for (auto& size_class : classes_)
+        {
+            for (uint8_t* data : size_class.free_buffers)
+            {
+                delete[] data;
+            }
+        }
+    }
+
+    BufferPool(BufferPool&&) = delete;
+    BufferPool(const BufferPool&) = delete;
+    BufferPool& operator=(BufferPool&&) = delete;
+    BufferPool& operator=(const BufferPool&) = delete;
+
+    /**
+     * @brief   Acquires a buffer of at least the given size.
+     */
+    Buffer acquire(
+            size_t size);
+
+    /**
+     * @brief   Number of buffers allocated from the heap since the creation of the pool.
+     */
+    size_t get_allocation_count() const { return allocation_count_.load(std::memory_order_relaxed); }
+
+    static constexpr size_t MIN_BUFFER_SIZE = 64;
+    static constexpr size_t MAX_BUFFER_SIZE = 64 * 1024;
+    static constexpr size_t DEFAULT_MAX_CACHED_BUFFERS = 1024;
+    static constexpr size_t CLASS_MEMORY_BUDGET = 4 * 1024 * 1024;
+
+private:
+    static constexpr size_t CLASS_COUNT = 6; // 64, 256, 1K, 4K, 16K, 64K.
+
+    struct SizeClass
+    {
+        std::mutex mtx;
+        std::vector<uint8_t*> free_buffers;
+    };
+
+    explicit BufferPool(
+            size_t max_cached_buffers)
+        : classes_()
+        , max_cached_buffers_(max_cached_buffers)
+        , allocation_count_(0)
+    {}
+
+    static size_t get_class_index(
+            size_t size)
+    {
+        size_t index = 0;
+        size_t capacity = MIN_BUFFER_SIZE;
+        while (capacity < size)
+        {
+            capacity <<= 2;
+            ++index;
+        }
+        return index;
+    }
+
+    void release(
+            uint8_t* data,
+            size_t capacity);
+
+    std::array<SizeClass, CLASS_COUNT> classes_;
+    const size_t max_cached_buffers_;
+    std::atomic<size_t> allocation_count_;
+};
+
+inline BufferPool::Buffer BufferPool::acquire(
+        size_t size)
+{
+    Buffer buffer;
+    if (MAX_BUFFER_SIZE < size)
+    {
+        buffer.capacity_ = size;
+    }
+    else
+    {
+        const size_t index = get_class_index(size);
+        SizeClass& size_class = classes_[index];
+        std::lock_guard<std::mutex> lock(size_class.mtx);
+        if (!size_class.free_buffers.empty())
+        {
+            buffer.data_ = size_class.free_buffers.back();
+            size_class.free_buffers.pop_back();
+        }
+        buffer.capacity_ = MIN_BUFFER_SIZE << (2 * index);
+    }
+
+    if (nullptr == buffer.data_)
+    {
+        buffer.data_ = new uint8_t[buffer.capacity_];
+        allocation_count_.fetch_add(1, std::memory_order_relaxed);
+    }
+    buffer.pool_ = shared_from_this();
+    return buffer;
+}
+
+inline void BufferPool::release(
+        uint8_t* data,
+        size_t capacity)
+{
+    if (MAX_BUFFER_SIZE >= capacity)
+    {
+        const size_t budget_buffers = CLASS_MEMORY_BUDGET / capacity;
+        const size_t max_cached_buffers = (budget_buffers < max_cached_buffers_) ? budget_buffers : max_cached_buffers_;
+        SizeClass& size_class = classes_[get_class_index(capacity)];
+        std::lock_guard<std::mutex> lock(size_class.mtx);
+        if (size_class.free_buffers.size() < max_cached_buffers)
+        {
+            if (size_class.free_buffers.capacity() == size_class.free_buffers.size())
+            {
+                size_class.free_buffers.reserve(max_cached_buffers);
+            }
+            size_class.free_buffers.push_back(data);
+            return;
+        }
+    }
+    delete[] data;
+}
+
+} // namespace uxr
+} // namespace eprosima
+
+#endif // UXR_AGENT_MESSAGE_BUFFER_POOL_HPP_
@@ -0,0 +1,109 @@
+// Copyright 2018 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef UXR_AGENT_MESSAGE_INFO_REPLY_HPP_
+#define UXR_AGENT_MESSAGE_INFO_REPLY_HPP_
+
+#include <uxr/agent/message/OutputMessage.hpp>
+#include <uxr/agent/types/XRCETypes.hpp>
+
+#include <fastcdr/Cdr.h>
+#include <fastcdr/exceptions/Exception.h>
+
+#include <cstring>
+#include <memory>
+#include <vector>
+
+namespace eprosima {
+namespace uxr {
+
+/**
+ * @brief   INFO payload serialized once, and copied into the reply to each GET_INFO.
+ *          Replies only differ in the related request and the implementation status, which are the leading
+ *          fields of the payload and are patched in place after the copy.
+ */
+class InfoReply
+{
+public:
+    InfoReply() = default;
+
+    /**
+     * @brief   Serializes the payload, whose related request and implementation status are ignored.
+     *          None of its members is aligned to more than 4 bytes, so its serialization does not depend
+     *          on the offset of the submessage within the message.
+     */
+    explicit InfoReply(
+            const dds::xrce::INFO_Payload& info_payload)
+        : payload_(info_payload.getCdrSerializedSize())
+    {
+        fastcdr::FastBuffer fastbuffer(reinterpret_cast<char*>(payload_.data()), payload_.size());
+        fastcdr::Cdr serializer(fastbuffer, fastcdr::Cdr::DEFAULT_ENDIAN, fastcdr::CdrVersion::XCDRv1);
+        try
+        {
+            info_payload.serialize(serializer);
+        }
+        catch(eprosima::fastcdr::exception::NotEnoughMemoryException & /*exception*/)
+        {
+            payload_.clear();
+        }
+    }
+
+    bool empty() const { return payload_.empty(); }
+
+    size_t get_payload_len() const { return payload_.size(); }
+
+    /**
+     * @brief   Builds the message replying to a GET_INFO.
+     * @return  nullptr if there is no payload or it does not fit.
+     */
+    std::shared_ptr<OutputMessage> create_message(
+            const dds::xrce::MessageHeader& header,
+            const dds::xrce::GET_INFO_Payload& get_info_payload,
+            uint8_t implementation_status) const
+    {
+        std::shared_ptr<OutputMessage> message;
+        if (empty())
+        {
+            return message;
+        }
+
+        message = OutputMessage::create(header, header.getCdrSerializedSize() + SUBHEADER_SIZE + payload_.size());
+        if (!message->append_raw_payload(dds::xrce::INFO, payload_.data(), payload_.size()))
+        {
+            message.reset();
+            return message;
+        }
+
+        uint8_t* reply = message->get_buf() + message->get_len() - payload_.size();
+        memcpy(reply + REQUEST_ID_OFFSET, get_info_payload.request_id().data(), get_info_payload.request_id().size());
+        memcpy(reply + OBJECT_ID_OFFSET, get_info_payload.object_id().data(), get_info_payload.object_id().size());
+        reply[IMPLEMENTATION_STATUS_OFFSET] = implementation_status;
+        return message;
+    }
+
+private:
+    static constexpr size_t SUBHEADER_SIZE = 4;
+
+    /* Layout of the BaseObjectReply leading the INFO payload. */
+    static constexpr size_t REQUEST_ID_OFFSET = 0;
+    static constexpr size_t OBJECT_ID_OFFSET = 2;
+    static constexpr size_t IMPLEMENTATION_STATUS_OFFSET = 5;
+
+    std::vector<uint8_t> payload_;
+};
+
+} // namespace uxr
+} // namespace eprosima
+
+#endif // UXR_AGENT_MESSAGE_INFO_REPLY_HPP_
@@ -15,49 +15,77 @@
 #ifndef UXR_AGENT_MESSAGE_INPUT_MESSAGE_HPP_
 #define UXR_AGENT_MESSAGE_INPUT_MESSAGE_HPP_
 
+#include <uxr/agent/config.hpp>
+#include <uxr/agent/message/BufferPool.hpp>
 #include <uxr/agent/types/MessageHeader.hpp>
 #include <uxr/agent/types/SubMessageHeader.hpp>
 
 #include <fastcdr/Cdr.h>
 #include <fastcdr/exceptions/Exception.h>
 
+#include <array>
+#include <cstring>
+#include <memory>
+#include <vector>
+
 namespace eprosima {
 namespace uxr {
 
+/**
+ * @brief   Location and header of a submessage within an InputMessage.
+ */
+struct SubmessageIndexEntry
+{
+    uint32_t offset;    // Offset of the submessage header from the beginning of the message.
+    uint16_t length;    // Payload length, as given by the submessage header.
+    dds::xrce::SubmessageId id;
+    uint8_t flags;
+};
+
 class InputMessage
 {
 public:
+    /**
+     * @brief   Builds a message from a copy of the given bytes, stored in a pooled buffer.
+     */
     InputMessage(
             uint8_t* buf,
+            size_t len,
+            const std::shared_ptr<BufferPool>& pool = BufferPool::get_default())
+        : InputMessage(pool->acquire(len), len, buf)
+    {}
+
+    /**
+     * @brief   Builds a message from a buffer where it has already been received, without copying it.
+     *          The buffer is given back to its pool when the message is destroyed.
+     */
+    InputMessage(
+            BufferPool::Buffer&& buffer,
             size_t len)
-        : buf_(new uint8_t[len]),
-          len_(len),
-          header_(),
-          subheader_(),
-          fastbuffer_(reinterpret_cast<char*>(buf_), len_),
-          deserializer_(fastbuffer_, eprosima::fastcdr::Cdr::DEFAULT_ENDIAN, eprosima::fastcdr::CdrVersion::XCDRv1)
-    {
-        memcpy(buf_, buf, len);
-
-        // A valid XRCE message must have a valid header and at least 1 submessage
-        valid_xrce_message_ = deserialize(header_);
-        valid_xrce_message_ = valid_xrce_message_ && count_submessages() > 0;
-    }
+        : InputMessage(std::move(buffer), len, nullptr)
+    {}
 
     uint8_t* get_buf() const { return buf_; }
 
     size_t get_len() const { return len_; }
 
-    ~InputMessage()
-    {
-        delete[] buf_;
-    }
+    ~InputMessage() = default;
 
     InputMessage(InputMessage&&) = delete;
     InputMessage(const InputMessage&) = delete;
     InputMessage& operator=(InputMessage&&) = delete;
     InputMessage& operator=(const InputMessage&) = delete;
 
+    /*
+     * Messages are created and destroyed for every received packet, so their storage is recycled.
+     */
+    static void* operator new(
+            std::size_t size);
+
+    static void operator delete(
+            void* ptr,
+            std::size_t size);
+
     const dds::xrce::MessageHeader& get_header() const { return header_; }
 
     const dds::xrce::SubmessageHeader& get_subheader() const { return subheader_; }
@@ -69,21 +97,89 @@ public:
 
     bool get_raw_payload(uint8_t* buf, size_t len);
 
+    /**
+     * @brief   Non-owning view of the next len bytes of the payload, which are skipped as if deserialized.
+     *          The view is valid as long as the message is.
+     */
+    bool get_payload_view(
+            const uint8_t*& buf,
+            size_t len);
+
     bool prepare_next_submessage();
 
-    size_t count_submessages();
+    /**
+     * @brief   Submessages of the message, indexed once at construction.
+     *          The last entry may announce more payload than the message holds.
+     * @param   position    Position of the submessage, lower than count_submessages().
+     */
+    const SubmessageIndexEntry& get_submessage_index_entry(
+            size_t position) const
+    {
+        return (SUBMESSAGE_INDEX_INLINE_SIZE > position)
+            ? inline_submessage_index_[position]
+            : extra_submessage_index_[position - SUBMESSAGE_INDEX_INLINE_SIZE];
+    }
 
-    bool is_valid_xrce_message() { return valid_xrce_message_; }
+    size_t count_submessages() const { return submessage_count_; }
 
-    dds::xrce::SubmessageId get_submessage_id();
+    /**
+     * @brief   Index entry of the submessage which prepare_next_submessage() would move to, if any.
+     */
+    const SubmessageIndexEntry* peek_next_submessage() const
+    {
+        return (submessage_count_ > next_submessage_) ? &get_submessage_index_entry(next_submessage_) : nullptr;
+    }
+
+    bool is_valid_xrce_message() const { return valid_xrce_message_; }
+
+    /**
+     * @brief   Identifier of the first submessage.
+     */
+    dds::xrce::SubmessageId get_submessage_id() const;
 
 private:
+    /* Most messages carry a few submessages, which are indexed without allocating. */
+    static constexpr size_t SUBMESSAGE_INDEX_INLINE_SIZE = 4;
+
+    InputMessage(
+            BufferPool::Buffer&& buffer,
+            size_t len,
+            const uint8_t* source)
+        : buffer_(std::move(buffer)),
+          buf_(buffer_.data()),
+          len_(len),
+          header_(),
+          subheader_(),
+          fastbuffer_(reinterpret_cast<char*>(buf_), len_),
+          deserializer_(fastbuffer_, eprosima::fastcdr::Cdr::DEFAULT_ENDIAN, eprosima::fastcdr::CdrVersion::XCDRv1),
+          inline_submessage_index_(),
+          extra_submessage_index_(),
+          submessage_count_(0),
+          next_submessage_(0)
+    {
+        if (nullptr != source)
+        {
+            memcpy(buf_, source, len);
+        }
+
+        // A valid XRCE message must have a valid header and at least 1 submessage
+        valid_xrce_message_ = deserialize(header_);
+        if (valid_xrce_message_)
+        {
+            build_submessage_index();
+        }
+        valid_xrce_message_ = valid_xrce_message_ && (0 < submessage_count_);
+    }
+
     template<class T>
     bool deserialize(T& data);
 
+    void build_submessage_index();
+
     void log_error();
 
 private:
+    BufferPool::Buffer buffer_;
     uint8_t* buf_;
     size_t len_;
     dds::xrce::MessageHeader header_;
@@ -91,74 +187,79 @@ private:
     fastcdr::FastBuffer fastbuffer_;
     fastcdr::Cdr deserializer_;
     bool valid_xrce_message_ = false;
+    std::array<SubmessageIndexEntry, SUBMESSAGE_INDEX_INLINE_SIZE> inline_submessage_index_;
+    std::vector<SubmessageIndexEntry> extra_submessage_index_;
+    size_t submessage_count_;
+    size_t next_submessage_;
 };
 
-inline bool InputMessage::prepare_next_submessage()
+inline void InputMessage::build_submessage_index()
 {
-    bool rv = false;
-    deserializer_.jump((4 - ((deserializer_.get_current_position() - deserializer_.get_buffer_pointer()) & 3)) & 3);
-    if (fastbuffer_.getBufferSize() > deserializer_.get_serialized_data_length())
+    const size_t subheader_size = 4;
+    size_t offset = (128 > header_.session_id()) ? 8 : 4;
+    while (len_ >= offset + subheader_size)
     {
-        rv = deserialize(subheader_);
-
-        // Check submessage endianness
-        fastcdr::Cdr::Endianness endianness = static_cast<fastcdr::Cdr::Endianness>(subheader_.flags() & 0x01);
-        if (endianness != deserializer_.endianness())
+        SubmessageIndexEntry entry;
+        entry.offset = uint32_t(offset);
+        entry.id = dds::xrce::SubmessageId(buf_[offset]);
+        entry.flags = buf_[offset + 1];
+        entry.length = uint16_t(buf_[offset + 2] | (buf_[offset + 3] << 8)); // Always little endian.
+        if (SUBMESSAGE_INDEX_INLINE_SIZE > submessage_count_)
         {
-            deserializer_.change_endianness(endianness);
+            inline_submessage_index_[submessage_count_] = entry;
         }
-    }
-    return rv;
-}
-
-inline size_t InputMessage::count_submessages()
-{
-    fastcdr::Cdr local_deserializer(fastbuffer_, eprosima::fastcdr::Cdr::DEFAULT_ENDIAN, eprosima::fastcdr::CdrVersion::XCDRv1);
-    dds::xrce::MessageHeader local_header;
-    dds::xrce::SubmessageHeader local_subheader;
-
-    local_header.deserialize(local_deserializer);
-
-    bool rv = false;
-    size_t count = 0;
+        else
+        {
+            extra_submessage_index_.push_back(entry);
+        }
+        ++submessage_count_;
 
-    do
-    {
-        local_deserializer.jump((4 - ((local_deserializer.get_current_position() - local_deserializer.get_buffer_pointer()) & 3)) & 3);
-        if (fastbuffer_.getBufferSize() > local_deserializer.get_serialized_data_length())
+#ifdef UAGENT_TWEAK_XRCE_WRITE_LIMIT
+        // A WRITE_DATA with no length takes the rest of the message.
+        if ((0 == entry.length) && (dds::xrce::WRITE_DATA == entry.id))
         {
-            try
-            {
-                local_subheader.deserialize(local_deserializer);
-                count++;
-            }
-            catch(eprosima::fastcdr::exception::NotEnoughMemoryException& /*exception*/)
-            {
-                rv = false;
-            }
-        } else {
-            rv = false;
+            break;
         }
-    } while (rv);
+#endif
 
-    return count;
+        offset += subheader_size + entry.length;
+        offset += (4 - (offset & 3)) & 3;
+    }
 }
 
-inline dds::xrce::SubmessageId InputMessage::get_submessage_id()
+inline bool InputMessage::prepare_next_submessage()
 {
-    fastcdr::Cdr local_deserializer(fastbuffer_, eprosima::fastcdr::Cdr::DEFAULT_ENDIAN, eprosima::fastcdr::CdrVersion::XCDRv1);
-    dds::xrce::MessageHeader local_header;
-    dds::xrce::SubmessageHeader local_subheader;
+    if (submessage_count_ <= next_submessage_)
+    {
+        return false;
+    }
+
+    /* Skip whatever the previous submessage left unread, plus the alignment. */
+    const SubmessageIndexEntry& entry = get_submessage_index_entry(next_submessage_++);
+    const size_t payload_offset = entry.offset + 4;
+    const size_t current_offset = deserializer_.get_serialized_data_length();
+    if (current_offset > payload_offset)
+    {
+        return false;
+    }
+    deserializer_.jump(payload_offset - current_offset);
 
-    local_header.deserialize(local_deserializer);
+    subheader_.submessage_id(entry.id);
+    subheader_.flags(entry.flags);
+    subheader_.submessage_length(entry.length);
 
-    local_deserializer.jump((4 - ((local_deserializer.get_current_position() - local_deserializer.get_buffer_pointer()) & 3)) & 3);
-    if (fastbuffer_.getBufferSize() > local_deserializer.get_serialized_data_length())
+    // Check submessage endianness
+    fastcdr::Cdr::Endianness endianness = static_cast<fastcdr::Cdr::Endianness>(entry.flags & 0x01);
+    if (endianness != deserializer_.endianness())
     {
-        local_subheader.deserialize(local_deserializer);
+        deserializer_.change_endianness(endianness);
     }
+    return true;
+}
 
-    return local_subheader.submessage_id();
+inline dds::xrce::SubmessageId InputMessage::get_submessage_id() const
+{
+    return (0 == submessage_count_) ? dds::xrce::SubmessageId(0) : inline_submessage_index_[0].id;
 }
 
 template<class T>
@@ -202,6 +303,21 @@ inline bool InputMessage::get_raw_payload(uint8_t* buf, size_t len)
     return rv;
 }
 
+inline bool InputMessage::get_payload_view(
+        const uint8_t*& buf,
+        size_t len)
+{
+    const size_t offset = deserializer_.get_serialized_data_length();
+    if ((offset > len_) || (len > len_ - offset))
+    {
+        log_error();
+        return false;
+    }
+    buf = buf_ + offset;
+    deserializer_.jump(len);
+    return true;
+}
+
 template<class T>
 inline bool InputMessage::deserialize(T& data)
 {
@@ -15,33 +15,83 @@
 #ifndef UXR_AGENT_MESSAGE_OUTPUT_MESSAGE_HPP_
 #define UXR_AGENT_MESSAGE_OUTPUT_MESSAGE_HPP_
 
+#include <uxr/agent/message/BufferPool.hpp>
 #include <uxr/agent/types/MessageHeader.hpp>
 #include <uxr/agent/types/SubMessageHeader.hpp>
 #include <uxr/agent/utils/Functions.hpp>
+#include <uxr/agent/utils/RecyclingAllocator.hpp>
 
 #include <fastcdr/Cdr.h>
 #include <fastcdr/exceptions/Exception.h>
 
+#include <cstring>
+#include <memory>
+#include <mutex>
+
 namespace eprosima {
 namespace uxr {
 
+/**
+ * @brief   DATA payload whose sample bytes are referenced instead of copied.
+ *          An OutputMessage keeps them as a separate segment after the serialized part, so transports able
+ *          to gather segments send them straight from this buffer. It serializes as a DATA_Payload_Data.
+ */
+struct ScatteredDataPayload
+{
+    dds::xrce::BaseObjectRequest request;
+    std::shared_ptr<const BufferPool::Buffer> data;
+    size_t len;
+
+    size_t getCdrSerializedSize(
+            size_t current_alignment = 0) const
+    {
+        return request.getCdrSerializedSize(current_alignment) + len;
+    }
+
+    void serialize(
+            fastcdr::Cdr& serializer) const
+    {
+        request.serialize(serializer);
+        serializer.serialize_array(data->data(), len);
+    }
+};
+
 class OutputMessage
 {
 public:
+    /**
+     * @brief   Builds a message of the given size, stored in a pooled buffer.
+     *          Only those len bytes are cleared, not the whole buffer, so callers shall size messages
+     *          after their content rather than after the MTU.
+     */
     OutputMessage(
             const dds::xrce::MessageHeader& header,
-            size_t len)
-        : buf_(new uint8_t[len]{0}),
+            size_t len,
+            const std::shared_ptr<BufferPool>& pool = BufferPool::get_default())
+        : buffer_(pool->acquire(len)),
+          buf_(buffer_.data()),
           len_(len),
           fastbuffer_(reinterpret_cast<char*>(buf_), len_),
           serializer_(fastbuffer_, eprosima::fastcdr::Cdr::DEFAULT_ENDIAN, eprosima::fastcdr::CdrVersion::XCDRv1)
     {
+        /* Serialization skips alignment padding, which shall not expose bytes of a previous message. */
+        memset(buf_, 0, len_);
         serialize(header);
+        header_len_ = serializer_.get_serialized_data_length();
     }
 
-    ~OutputMessage()
+    ~OutputMessage() = default;
+
+    /**
+     * @brief   Builds a shared message whose storage and reference count are recycled together,
+     *          so that neither the message nor its control block reach the allocator in steady state.
+     */
+    static std::shared_ptr<OutputMessage> create(
+            const dds::xrce::MessageHeader& header,
+            size_t len,
+            const std::shared_ptr<BufferPool>& pool = BufferPool::get_default())
     {
-        delete[] buf_;
+        return std::allocate_shared<OutputMessage>(utils::RecyclingAllocator<OutputMessage>(), header, len, pool);
     }
 
     OutputMessage(OutputMessage&&) = delete;
@@ -49,9 +99,33 @@ public:
     OutputMessage& operator=(OutputMessage&&) = delete;
     OutputMessage& operator=(const OutputMessage&) = delete;
 
-    uint8_t* get_buf() const { return buf_; }
+    /**
+     * @brief   Contiguous copy of the whole message.
+     *          A message with a payload segment is gathered into a new buffer the first time,
+     *          transports which support it should send get_head_buf() and get_payload_buf() instead.
+     */
+    uint8_t* get_buf() const;
+
+    size_t get_len() const { return get_head_len() + payload_len_; }
+
+    /**
+     * @brief   Serialized part of the message, which is followed on the wire by the payload segment.
+     */
+    const uint8_t* get_head_buf() const { return buf_; }
+
+    size_t get_head_len() const { return serializer_.get_serialized_data_length(); }
 
-    size_t get_len() const { return serializer_.get_serialized_data_length(); }
+    /**
+     * @brief   Payload segment, referenced by the last submessage, or nullptr if there is none.
+     */
+    const uint8_t* get_payload_buf() const { return payload_ ? payload_->data() + payload_offset_ : nullptr; }
+
+    size_t get_payload_len() const { return payload_len_; }
+
+    size_t get_header_len() const { return header_len_; }
+
+    /* The stream id is the second byte of the serialized message header. */
+    dds::xrce::StreamId get_stream_id() const { return dds::xrce::StreamId(buf_[1]); }
 
     template<class T>
     bool append_submessage(
@@ -59,6 +133,15 @@ public:
             const T& data,
             uint8_t flags = 0x01);
 
+    /**
+     * @brief   Appends a submessage whose data is kept as the payload segment, without being copied.
+     *          It shall be the last submessage of the message.
+     */
+    bool append_submessage(
+            dds::xrce::SubmessageId submessage_id,
+            const ScatteredDataPayload& data,
+            uint8_t flags = 0x01);
+
     bool append_raw_payload(
             dds::xrce::SubmessageId submessage_id,
             const uint8_t* buf,
@@ -70,6 +153,26 @@ public:
             uint8_t* buf,
             size_t len);
 
+    /**
+     * @brief   Appends a fragment made of a few bytes copied after its subheader, followed by a slice
+     *          of a shared buffer which is kept as the payload segment, without being copied.
+     *          It shall be the last submessage of the message.
+     */
+    bool append_fragment(
+            const dds::xrce::SubmessageHeader& subheader,
+            const uint8_t* inline_buf,
+            size_t inline_len,
+            const std::shared_ptr<const BufferPool::Buffer>& payload,
+            size_t payload_offset,
+            size_t payload_len);
+
+    /**
+     * @brief   Appends the submessages of another message, payload segment included.
+     *          Both messages shall belong to the same session and stream.
+     */
+    bool append_submessages(
+            const OutputMessage& other);
+
 private:
     bool append_subheader(
             dds::xrce::SubmessageId submessage_id,
@@ -82,12 +185,50 @@ private:
     void log_error();
 
 private:
+    BufferPool::Buffer buffer_;
     uint8_t* buf_;
     size_t len_;
     fastcdr::FastBuffer fastbuffer_;
     fastcdr::Cdr serializer_;
+    size_t header_len_ = 0;
+    std::shared_ptr<const BufferPool::Buffer> payload_;
+    size_t payload_offset_ = 0;
+    size_t payload_len_ = 0;
+    mutable BufferPool::Buffer gathered_buffer_;
+    mutable std::once_flag gathered_flag_;
 };
 
+inline uint8_t* OutputMessage::get_buf() const
+{
+    if (!payload_)
+    {
+        return buf_;
+    }
+
+    std::call_once(gathered_flag_, [this]()
+    {
+        gathered_buffer_ = BufferPool::get_default()->acquire(get_len());
+        memcpy(gathered_buffer_.data(), buf_, get_head_len());
+        memcpy(gathered_buffer_.data() + get_head_len(), payload_->data() + payload_offset_, payload_len_);
+    });
+    return gathered_buffer_.data();
+}
+
+inline bool OutputMessage::append_submessage(
+        dds::xrce::SubmessageId submessage_id,
+        const ScatteredDataPayload& data,
+        uint8_t flags)
+{
+    bool rv = false;
+    if (append_subheader(submessage_id, flags, data.getCdrSerializedSize()) && serialize(data.request))
+    {
+        payload_ = data.data;
+        payload_len_ = data.len;
+        rv = true;
+    }
+    return rv;
+}
+
 template<class T>
 inline bool OutputMessage::append_submessage(
         dds::xrce::SubmessageId submessage_id,
@@ -134,6 +275,10 @@ inline bool OutputMessage::append_fragment(
         size_t len)
 {
     bool rv = false;
+    if (payload_)
+    {
+        return rv;
+    }
     serializer_.jump((4 - ((serializer_.get_current_position() - serializer_.get_buffer_pointer()) & 3)) & 3);
     if (serialize(subheader))
     {
@@ -151,11 +296,77 @@ inline bool OutputMessage::append_fragment(
     return rv;
 }
 
+inline bool OutputMessage::append_fragment(
+        const dds::xrce::SubmessageHeader& subheader,
+        const uint8_t* inline_buf,
+        size_t inline_len,
+        const std::shared_ptr<const BufferPool::Buffer>& payload,
+        size_t payload_offset,
+        size_t payload_len)
+{
+    bool rv = false;
+    if (payload_)
+    {
+        return rv;
+    }
+    serializer_.jump((4 - ((serializer_.get_current_position() - serializer_.get_buffer_pointer()) & 3)) & 3);
+    if (serialize(subheader))
+    {
+        try
+        {
+            serializer_.serialize_array(inline_buf, inline_len);
+            if (0 != payload_len)
+            {
+                payload_ = payload;
+                payload_offset_ = payload_offset;
+                payload_len_ = payload_len;
+            }
+            rv = true;
+        }
+        catch(eprosima::fastcdr::exception::NotEnoughMemoryException & /*exception*/)
+        {
+            log_error();
+        }
+    }
+    return rv;
+}
+
+inline bool OutputMessage::append_submessages(
+        const OutputMessage& other)
+{
+    bool rv = false;
+    if (payload_)
+    {
+        return rv;
+    }
+
+    try
+    {
+        serializer_.jump((4 - ((serializer_.get_current_position() - serializer_.get_buffer_pointer()) & 3)) & 3);
+        serializer_.serialize_array(other.buf_ + other.header_len_, other.get_head_len() - other.header_len_);
+        if (other.payload_)
+        {
+            serializer_.serialize_array(other.payload_->data() + other.payload_offset_, other.payload_len_);
+        }
+        rv = true;
+    }
+    catch(eprosima::fastcdr::exception::NotEnoughMemoryException & /*exception*/)
+    {
+        log_error();
+    }
+    return rv;
+}
+
 inline bool OutputMessage::append_subheader(
         dds::xrce::SubmessageId submessage_id,
         uint8_t flags,
         size_t submessage_len)
 {
+    if (payload_)
+    {
+        return false;
+    }
+
     dds::xrce::SubmessageHeader subheader;
     subheader.submessage_id(submessage_id);
     subheader.flags(flags);
@@ -47,6 +47,15 @@ public:
     #endif
     };
 
+    /*
+     * Non-owning view of a serialized sample.
+     */
+    struct SampleView
+    {
+        const uint8_t* buf;
+        size_t len;
+    };
+
     Middleware() = default;
     Middleware(
             bool intraprocess_enabled)
@@ -202,6 +211,54 @@ public:
             uint16_t replier_id,
             const std::vector<uint8_t>& data) = 0;
 
+    /*
+     * Writes taking a non-owning view of the serialized sample, which is only valid during the call.
+     * By default the sample is copied into a vector, middlewares which can serialize straight from
+     * the view override them.
+     */
+    virtual bool write_data(
+            uint16_t datawriter_id,
+            const uint8_t* buf,
+            size_t len)
+    {
+        return write_data(datawriter_id, std::vector<uint8_t>(buf, buf + len));
+    }
+
+    /*
+     * Writes consecutive samples of a DataWriter, stopping at the first one which cannot be written,
+     * and returns the number of samples written. Middlewares override it to take their locks and look
+     * the DataWriter up once per batch, by default the samples are written one by one.
+     */
+    virtual size_t write_data_batch(
+            uint16_t datawriter_id,
+            const SampleView* samples,
+            size_t count)
+    {
+        size_t written = 0;
+        while ((written < count) && write_data(datawriter_id, samples[written].buf, samples[written].len))
+        {
+            ++written;
+        }
+        return written;
+    }
+
+    virtual bool write_request(
+            uint16_t requester_id,
+            uint32_t sequence_number,
+            const uint8_t* buf,
+            size_t len)
+    {
+        return write_request(requester_id, sequence_number, std::vector<uint8_t>(buf, buf + len));
+    }
+
+    virtual bool write_reply(
+            uint16_t replier_id,
+            const uint8_t* buf,
+            size_t len)
+    {
+        return write_reply(replier_id, std::vector<uint8_t>(buf, buf + len));
+    }
+
     virtual bool read_data(
             uint16_t datareader_id,
             std::vector<uint8_t>& data,
@@ -15,6 +15,7 @@
 #ifndef UXR_AGENT_MIDDLEWARE_CED_CED_ENTITIES_HPP_
 #define UXR_AGENT_MIDDLEWARE_CED_CED_ENTITIES_HPP_
 
+#include <uxr/agent/middleware/Middleware.hpp>
 #include <uxr/agent/utils/SeqNum.hpp>
 
 #include <string>
@@ -126,6 +127,14 @@ private:
             TopicSource topic_src,
             uint8_t& errcode);
 
+    /* Writes the samples into the history under a single lock, waking the readers once. */
+    size_t write_batch(
+            const Middleware::SampleView* samples,
+            size_t count,
+            WriteAccess write_access,
+            TopicSource topic_src,
+            uint8_t& errcode);
+
     bool read(
             std::vector<uint8_t>& data,
             std::chrono::milliseconds timeout,
@@ -266,6 +275,11 @@ public:
         const std::vector<uint8_t>& data,
         uint8_t& errcode) const;
 
+    size_t write_batch(
+        const Middleware::SampleView* samples,
+        size_t count,
+        uint8_t& errcode) const;
+
     const std::string& topic_name() const { return topic_->get_global_topic()->name(); }
 
 private:
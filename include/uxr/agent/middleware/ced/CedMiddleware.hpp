@@ -392,6 +392,10 @@ public:
      */
     bool delete_replier(uint16_t) override { return false; };
 
+    using Middleware::write_data;
+    using Middleware::write_request;
+    using Middleware::write_reply;
+
     /**
      * @brief Writes data using the CedDataWriter identified by the datawriter_id parameter.
      * @param datawriter_id The CedDataWriter identifier.
@@ -402,6 +406,18 @@ public:
             uint16_t datawriter_id,
             const std::vector<uint8_t>& data) override;
 
+    /**
+     * @brief Writes consecutive samples using the CedDataWriter identified by the datawriter_id parameter.
+     * @param datawriter_id The CedDataWriter identifier.
+     * @param samples       The samples to be written.
+     * @param count         The number of samples.
+     * @return  the number of samples written.
+     */
+    size_t write_data_batch(
+            uint16_t datawriter_id,
+            const SampleView* samples,
+            size_t count) override;
+
     /**
      * @brief Not implemented.
      */
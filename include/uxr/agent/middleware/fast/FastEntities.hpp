@@ -204,6 +204,10 @@ public:
     bool write(
             const std::vector<uint8_t>& data);
 
+    bool write(
+            const uint8_t* buf,
+            size_t len);
+
     bool write(
             const std::vector<uint8_t>& data,
             fastrtps::rtps::WriteParams& wparams);
@@ -171,10 +171,19 @@ public:
 /**********************************************************************************************************************
  * Write/Read functions.
  **********************************************************************************************************************/
+    using Middleware::write_data;
+    using Middleware::write_request;
+    using Middleware::write_reply;
+
     bool write_data(
             uint16_t datawriter_id,
             const std::vector<uint8_t>& data) override;
 
+    size_t write_data_batch(
+            uint16_t datawriter_id,
+            const SampleView* samples,
+            size_t count) override;
+
     bool write_request(
             uint16_t requester_id,
             uint32_t sequence_number,
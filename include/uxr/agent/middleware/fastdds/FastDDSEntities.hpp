@@ -273,6 +273,9 @@ public:
     bool match(const fastrtps::PublisherAttributes& attrs) const;
     bool match_from_bin(const dds::xrce::OBJK_DataWriter_Binary& datawriter_xrce) const;
     bool write(const std::vector<uint8_t>& data);
+    bool write(
+        const uint8_t* buf,
+        size_t len);
     const fastdds::dds::DataWriter* ptr() const;
     const fastdds::dds::DomainParticipant* participant() const;
 
@@ -351,6 +354,10 @@ public:
     bool write(
         uint32_t sequence_number,
         const std::vector<uint8_t>& data);
+    bool write(
+        uint32_t sequence_number,
+        const uint8_t* buf,
+        size_t len);
 
     bool read(
         uint32_t& sequence_number,
@@ -415,6 +422,9 @@ public:
     bool match_from_bin(const dds::xrce::OBJK_Replier_Binary& replier_xrce) const;
 
     bool write(const std::vector<uint8_t>& data);
+    bool write(
+        const uint8_t* buf,
+        size_t len);
     bool read(std::vector<uint8_t>& data,
         std::chrono::milliseconds timeout,
         fastdds::dds::SampleInfo& info);
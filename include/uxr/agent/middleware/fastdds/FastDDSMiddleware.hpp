@@ -182,6 +182,27 @@ public:
             uint16_t replier_id,
             const std::vector<uint8_t>& data) override;
 
+    bool write_data(
+            uint16_t datawriter_id,
+            const uint8_t* buf,
+            size_t len) override;
+
+    size_t write_data_batch(
+            uint16_t datawriter_id,
+            const SampleView* samples,
+            size_t count) override;
+
+    bool write_request(
+            uint16_t requester_id,
+            uint32_t sequence_number,
+            const uint8_t* buf,
+            size_t len) override;
+
+    bool write_reply(
+            uint16_t replier_id,
+            const uint8_t* buf,
+            size_t len) override;
+
     bool read_data(
             uint16_t datareader_id,
             std::vector<uint8_t>& data,
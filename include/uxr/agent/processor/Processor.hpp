@@ -16,8 +16,13 @@
 #define UXR_AGENT_PROCESSOR_PROCESSOR_HPP_
 
 #include <uxr/agent/middleware/Middleware.hpp>
+#include <uxr/agent/message/InfoReply.hpp>
+#include <uxr/agent/utils/RateLimiter.hpp>
+#include <uxr/agent/utils/TimerWheel.hpp>
 
 #include <cstdint>
+#include <functional>
+#include <memory>
 #include <vector>
 #include <mutex>
 
@@ -57,7 +62,7 @@ public:
             Root& root,
             Middleware::Kind middleware_kind);
 
-    ~Processor() = default;
+    ~Processor();
 
     void process_input_packet(
             InputPacket<EndPoint>&& input_packet);
@@ -66,13 +71,49 @@ public:
             InputPacket<EndPoint>&& input_packet,
             OutputPacket<EndPoint>& output_packet) const;
 
+    /**
+     * @brief Replies to a discovery GET_INFO with an INFO payload built by get_info_reply.
+     */
     bool process_get_info_packet(
             InputPacket<IPv4EndPoint>&& input_packet,
-            std::vector<dds::xrce::TransportAddress>& address,
+            const InfoReply& info_reply,
             OutputPacket<IPv4EndPoint>& output_packet) const;
 
+    /**
+     * @brief Serializes the INFO payload of the agent advertising the given transport addresses.
+     *        It only changes with them, so it shall be built again only when the addresses do.
+     */
+    InfoReply get_info_reply(
+            const std::vector<dds::xrce::TransportAddress>& addresses) const;
+
+    /**
+     * @brief Sends the HEARTBEATs and liveliness checks whose timers have expired.
+     *        Timers are only armed for reliable output streams with unacknowledged messages
+     *        and for clients with hard liveliness check, armed when the Root creates them,
+     *        so idle sessions are never visited.
+     */
     void check_heartbeats();
 
+    std::chrono::milliseconds get_heartbeat_resolution() const { return heartbeat_wheel_.get_resolution(); }
+
+    /**
+     * @brief Sets the time STATUS and DATA submessages are kept in an open output message, waiting
+     *        for others of the same stream to be packed with them. 0 disables packing.
+     */
+    void set_output_linger(std::chrono::milliseconds linger) { output_linger_ = linger; }
+
+    /**
+     * @brief Sets the delayed acknowledgement applied to the sessions of the clients created afterwards.
+     *        See Session::set_acknack_policy.
+     */
+    void set_acknack_policy(
+            uint16_t max_pending,
+            std::chrono::milliseconds delay)
+    {
+        acknack_max_pending_ = max_pending;
+        acknack_delay_ = delay;
+    }
+
 private:
     void process_input_message(
             ProxyClient& client,
@@ -128,12 +169,47 @@ private:
     bool read_data_callback(
             const WriteFnArgs& write_args,
             const std::vector<uint8_t>& buffer,
-            std::chrono::milliseconds timeout);
+            const std::shared_ptr<std::function<void()>>& resume);
+
+    void push_output_messages(
+            ProxyClient& client,
+            dds::xrce::StreamId stream_id,
+            OutputPacket<EndPoint>& output_packet);
+
+    void flush_output_stream(
+            ProxyClient& client,
+            dds::xrce::StreamId stream_id);
+
+    void send_acknack(
+            ProxyClient& client,
+            dds::xrce::StreamId stream_id,
+            const EndPoint& destination);
+
+    void send_delayed_acknack(
+            ProxyClient& client,
+            dds::xrce::StreamId stream_id);
+
+    void schedule_heartbeat(
+            ProxyClient& client,
+            dds::xrce::StreamId stream_id);
+
+    void send_heartbeat(
+            ProxyClient& client,
+            dds::xrce::StreamId stream_id);
+
+    void check_liveliness(
+            ProxyClient& client);
 
 private:
     Server<EndPoint>& server_;
     Middleware::Kind middleware_kind_;
     Root& root_;
+    utils::TimerWheel heartbeat_wheel_;
+    std::chrono::milliseconds output_linger_;
+    uint16_t acknack_max_pending_;
+    std::chrono::milliseconds acknack_delay_;
+    const InfoReply info_reply_;
+    mutable utils::RateLimiter<EndPoint> info_limiter_;
 };
 
 } // namespace uxr
@@ -17,11 +17,15 @@
 
 #include <uxr/agent/types/XRCETypes.hpp>
 #include <uxr/agent/utils/TokenBucket.hpp>
+#include <uxr/agent/utils/ThreadPolicy.hpp>
 
 #include <atomic>
 #include <thread>
 #include <mutex>
 #include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
 #include <type_traits>
 
 namespace eprosima {
@@ -38,14 +42,32 @@ struct WriteFnArgs
     dds::xrce::RequestId request_id;
 };
 
+/*
+ * Wake-up of a reader whose sample the writer could not take, shared with the hook given to the writer
+ * so that a late call of the hook never reaches a destroyed reader.
+ */
+struct WriteWakeup
+{
+    std::mutex mtx;
+    std::condition_variable cv;
+    bool pending = false;
+};
+
+/**
+ * @brief   Reads samples on a thread of its own and hands them to a writer.
+ *          The writer does not block: when it cannot take a sample it keeps the resume hook, which it calls
+ *          once it can, and the reader waits for that call before retrying.
+ */
 template<typename RA, typename WA = const WriteFnArgs&>
 class Reader
 {
 public:
     typedef const std::function<bool (RA, std::vector<uint8_t>&, std::chrono::milliseconds)> ReadFn;
-    typedef const std::function<bool (WA, const std::vector<uint8_t>&, std::chrono::milliseconds)> WriteFn;
+    typedef const std::function<bool (WA, const std::vector<uint8_t>&, const std::shared_ptr<std::function<void()>>&)> WriteFn;
 
 public:
+    Reader();
+
     ~Reader();
 
     bool start_reading(
@@ -62,6 +84,9 @@ private:
         ReadFn read_fn,
         WriteFn write_fn);
 
+    void wait_resume(
+        std::chrono::milliseconds timeout);
+
 private:
     dds::xrce::DataDeliveryControl delivery_control_;
     typename std::decay<RA>::type read_args_;
@@ -69,6 +94,8 @@ private:
     std::atomic<bool> running_cond_;
     std::thread thread_;
     std::mutex mtx_;
+    std::shared_ptr<WriteWakeup> wakeup_;
+    std::shared_ptr<std::function<void()>> resume_;
 
     static constexpr uint8_t rw_timeout = 100;
     static constexpr uint16_t max_samples_zero = 0;
@@ -77,6 +104,20 @@ private:
     static constexpr uint16_t max_bytes_per_second_unlimited = 0;
 };
 
+template<typename RA, typename WA>
+inline Reader<RA, WA>::Reader()
+    : running_cond_(false)
+    , wakeup_(std::make_shared<WriteWakeup>())
+{
+    std::shared_ptr<WriteWakeup> wakeup = wakeup_;
+    resume_ = std::make_shared<std::function<void()>>([wakeup]()
+    {
+        std::lock_guard<std::mutex> lock(wakeup->mtx);
+        wakeup->pending = true;
+        wakeup->cv.notify_one();
+    });
+}
+
 template<typename RA, typename WA>
 inline Reader<RA, WA>::~Reader()
 {
@@ -113,6 +154,10 @@ inline bool Reader<RA, WA>::stop_reading()
     if (running_cond_)
     {
         running_cond_ = false;
+        {
+            std::lock_guard<std::mutex> wakeup_lock(wakeup_->mtx);
+            wakeup_->cv.notify_one();
+        }
         if (thread_.joinable())
         {
             thread_.join();
@@ -133,6 +178,8 @@ inline void Reader<RA, WA>::read_task(
     using namespace eprosima::uxr::utils;
     using namespace std::chrono;
 
+    ThreadPolicies::instance().apply(ThreadRole::reader, "uxr-reader");
+
     constexpr std::chrono::milliseconds max_timeout{rw_timeout};
 
     size_t rate = (max_bytes_per_second_unlimited == delivery_control_.max_bytes_per_second())
@@ -158,8 +205,13 @@ inline void Reader<RA, WA>::read_task(
                 if (token_bucket.consume_tokens(data.size(), timeout))
                 {
                     do {
-                        timeout = std::min(max_timeout, duration_cast<milliseconds>(final_time - steady_clock::now()));
-                        submessage_pushed = write_fn(write_args_, data, timeout);
+                        submessage_pushed = write_fn(write_args_, data, resume_);
+                        if (!submessage_pushed)
+                        {
+                            /* The wait is bounded in case the writer failed without keeping the hook. */
+                            timeout = std::min(max_timeout, duration_cast<milliseconds>(final_time - steady_clock::now()));
+                            wait_resume(timeout);
+                        }
                     } while (running_cond_ && !submessage_pushed);
 
                     if (submessage_pushed)
@@ -176,6 +228,15 @@ inline void Reader<RA, WA>::read_task(
     }
 }
 
+template<typename RA, typename WA>
+inline void Reader<RA, WA>::wait_resume(
+        std::chrono::milliseconds timeout)
+{
+    std::unique_lock<std::mutex> lock(wakeup_->mtx);
+    wakeup_->cv.wait_for(lock, timeout, [this]() { return wakeup_->pending || !running_cond_; });
+    wakeup_->pending = false;
+}
+
 } // namespace uxr
 } // namespace eprosima
 
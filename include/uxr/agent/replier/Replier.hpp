@@ -44,6 +44,10 @@ public:
     bool write(
         dds::xrce::WRITE_DATA_Payload_Data& write_data);
 
+    bool write(
+        const uint8_t* buf,
+        size_t len);
+
     bool read(
         const dds::xrce::READ_DATA_Payload& read_data,
         Reader<bool>::WriteFn write_fn,
@@ -44,6 +44,11 @@ public:
         dds::xrce::WRITE_DATA_Payload_Data& write_data,
         const dds::xrce::RequestId& request_id);
 
+    bool write(
+        const uint8_t* buf,
+        size_t len,
+        const dds::xrce::RequestId& request_id);
+
     bool read(
         const dds::xrce::READ_DATA_Payload& read_data,
         Reader<bool>::WriteFn write_fn,
@@ -0,0 +1,505 @@
+// Copyright 2018 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef UXR_AGENT_SCHEDULER_FAIR_SCHEDULER_HPP_
+#define UXR_AGENT_SCHEDULER_FAIR_SCHEDULER_HPP_
+
+#include <uxr/agent/scheduler/Scheduler.hpp>
+
+#include <deque>
+#include <map>
+#include <mutex>
+#include <condition_variable>
+#include <algorithm>
+
+namespace eprosima {
+namespace uxr {
+
+/**
+ * @brief   Scheduler which shares priority 0 among flows using deficit round robin.
+ *          Elements are classified into flows by a key function, and each active flow is given
+ *          a quantum (weight times the base quantum) of cost per round, so a flow with a large backlog
+ *          does not delay the others more than one round. Lanes with priority greater than 0 are
+ *          plain FIFO queues served before the flows, as in PacketScheduler.
+ *          When priority 0 is full, the element to discard is taken from the longest flow.
+ */
+template<class T, class Key>
+class FairScheduler : public Scheduler<T>
+{
+public:
+    /**
+     * @param   max_size    Capacity of priority 0, shared by all the flows.
+     * @param   quantum     Cost credited to a flow of weight 1 per round.
+     * @param   flow_key    Function returning the flow of an element.
+     * @param   cost        Function returning the cost of an element, 1 per element if empty.
+     */
+    FairScheduler(
+            size_t max_size,
+            size_t quantum,
+            std::function<Key(const T&)> flow_key,
+            std::function<size_t(const T&)> cost = std::function<size_t(const T&)>())
+        : flow_key_(std::move(flow_key))
+        , cost_(std::move(cost))
+        , weight_()
+        , best_effort_predicate_()
+        , quantum_{(0 < quantum) ? quantum : 1}
+        , max_size_{max_size}
+        , flows_()
+        , active_flows_()
+        , lane_()
+        , priority_lanes_()
+        , mtx_()
+        , cond_var_()
+        , space_cond_var_()
+        , running_cond_(false)
+    {}
+
+    /**
+     * @brief   Sets the function returning the weight of a flow, 1 if empty.
+     *          It is called every time a flow becomes active.
+     */
+    void set_weight_function(
+            std::function<uint32_t(const Key&)> weight);
+
+    void set_priority_size(uint8_t priority, size_t size) final;
+
+    void set_overflow_policy(
+            uint8_t priority,
+            OverflowPolicy policy,
+            std::chrono::milliseconds timeout = std::chrono::milliseconds(0)) final;
+
+    void set_best_effort_predicate(
+            std::function<bool(const T&)> predicate) final;
+
+    void init() final;
+
+    void deinit() final;
+
+    void push(
+            T&& element,
+            uint8_t priority) final;
+
+    void push_front(
+            T&& element,
+            uint8_t priority) final;
+
+    bool pop(
+            T& element) final;
+
+    bool pop_batch(
+            std::vector<T>& elements,
+            size_t max_elements) final;
+
+    void get_stats(
+            std::vector<SchedulerLaneStats>& stats) final;
+
+private:
+    struct Flow
+    {
+        std::deque<T> queue;
+        size_t deficit;
+        size_t quantum;
+    };
+
+    struct Lane
+    {
+        Lane()
+            : queue()
+            , capacity{0}
+            , size{0}
+            , policy{OverflowPolicy::drop_oldest}
+            , timeout{0}
+            , enqueued{0}
+            , dropped{0}
+            , high_watermark{0}
+        {}
+
+        std::deque<T> queue;
+        size_t capacity;
+        size_t size;
+        OverflowPolicy policy;
+        std::chrono::milliseconds timeout;
+        uint64_t enqueued;
+        uint64_t dropped;
+        size_t high_watermark;
+    };
+
+    bool make_room(
+            std::unique_lock<std::mutex>& lock,
+            Lane& lane,
+            uint8_t priority);
+
+    bool drop_from_longest_flow(
+            bool best_effort_first);
+
+    Flow& activate_flow(
+            const Key& key,
+            bool front);
+
+    size_t get_cost(
+            const T& element) const;
+
+    bool try_pop(
+            T& element);
+
+    const std::function<Key(const T&)> flow_key_;
+    const std::function<size_t(const T&)> cost_;
+    std::function<uint32_t(const Key&)> weight_;
+    std::function<bool(const T&)> best_effort_predicate_;
+    const size_t quantum_;
+    const size_t max_size_;
+    std::map<Key, Flow> flows_;
+    std::deque<Key> active_flows_;
+    Lane lane_;
+    std::map<uint8_t, Lane> priority_lanes_;
+    std::mutex mtx_;
+    std::condition_variable cond_var_;
+    std::condition_variable space_cond_var_;
+    bool running_cond_;
+};
+
+template<class T, class Key>
+inline void FairScheduler<T, Key>::set_weight_function(
+        std::function<uint32_t(const Key&)> weight)
+{
+    std::lock_guard<std::mutex> lock(mtx_);
+    weight_ = std::move(weight);
+}
+
+template<class T, class Key>
+inline void FairScheduler<T, Key>::set_priority_size(uint8_t priority, size_t size)
+{
+    std::lock_guard<std::mutex> lock(mtx_);
+    if (0 == priority)
+    {
+        lane_.capacity = size;
+    }
+    else
+    {
+        priority_lanes_[priority].capacity = size;
+    }
+}
+
+template<class T, class Key>
+inline void FairScheduler<T, Key>::set_overflow_policy(
+        uint8_t priority,
+        OverflowPolicy policy,
+        std::chrono::milliseconds timeout)
+{
+    std::lock_guard<std::mutex> lock(mtx_);
+    Lane& lane = (0 == priority) ? lane_ : priority_lanes_[priority];
+    lane.policy = policy;
+    lane.timeout = timeout;
+}
+
+template<class T, class Key>
+inline void FairScheduler<T, Key>::set_best_effort_predicate(
+        std::function<bool(const T&)> predicate)
+{
+    std::lock_guard<std::mutex> lock(mtx_);
+    best_effort_predicate_ = std::move(predicate);
+}
+
+template<class T, class Key>
+inline void FairScheduler<T, Key>::init()
+{
+    std::lock_guard<std::mutex> lock(mtx_);
+    lane_.capacity = max_size_;
+    running_cond_ = true;
+}
+
+template<class T, class Key>
+inline void FairScheduler<T, Key>::deinit()
+{
+    std::lock_guard<std::mutex> lock(mtx_);
+    running_cond_ = false;
+    cond_var_.notify_all();
+    space_cond_var_.notify_all();
+}
+
+template<class T, class Key>
+inline void FairScheduler<T, Key>::push(
+        T&& element,
+        uint8_t priority)
+{
+    std::unique_lock<std::mutex> lock(mtx_);
+    if ((0 != priority) && (priority_lanes_.end() == priority_lanes_.find(priority)))
+    {
+        return;
+    }
+
+    Lane& lane = (0 == priority) ? lane_ : priority_lanes_[priority];
+    if ((lane.capacity <= lane.size) && !make_room(lock, lane, priority))
+    {
+        ++lane.dropped;
+        return;
+    }
+
+    if (0 == priority)
+    {
+        activate_flow(flow_key_(element), false).queue.push_back(std::move(element));
+    }
+    else
+    {
+        lane.queue.push_back(std::move(element));
+    }
+    ++lane.size;
+    ++lane.enqueued;
+    lane.high_watermark = std::max(lane.high_watermark, lane.size);
+    cond_var_.notify_one();
+}
+
+template<class T, class Key>
+inline bool FairScheduler<T, Key>::make_room(
+        std::unique_lock<std::mutex>& lock,
+        Lane& lane,
+        uint8_t priority)
+{
+    switch (lane.policy)
+    {
+        case OverflowPolicy::drop_newest:
+            return false;
+
+        case OverflowPolicy::block:
+            return space_cond_var_.wait_for(lock, lane.timeout,
+                       [&lane, this]() { return !running_cond_ || (lane.size < lane.capacity); })
+                   && running_cond_;
+
+        case OverflowPolicy::drop_best_effort_first:
+        case OverflowPolicy::drop_oldest:
+        default:
+        {
+            const bool best_effort_first = (OverflowPolicy::drop_best_effort_first == lane.policy);
+            if (0 == priority)
+            {
+                if (!drop_from_longest_flow(best_effort_first))
+                {
+                    return false;
+                }
+            }
+            else
+            {
+                auto it = lane.queue.begin();
+                if (best_effort_first && best_effort_predicate_)
+                {
+                    it = std::find_if(lane.queue.begin(), lane.queue.end(), best_effort_predicate_);
+                    it = (it == lane.queue.end()) ? lane.queue.begin() : it;
+                }
+                if (it == lane.queue.end())
+                {
+                    return false;
+                }
+                lane.queue.erase(it);
+            }
+            --lane.size;
+            ++lane.dropped;
+            return true;
+        }
+    }
+}
+
+template<class T, class Key>
+inline bool FairScheduler<T, Key>::drop_from_longest_flow(
+        bool best_effort_first)
+{
+    auto longest = flows_.end();
+    for (auto it = flows_.begin(); it != flows_.end(); ++it)
+    {
+        if ((longest == flows_.end()) || (longest->second.queue.size() < it->second.queue.size()))
+        {
+            longest = it;
+        }
+    }
+    if ((longest == flows_.end()) || longest->second.queue.empty())
+    {
+        return false;
+    }
+
+    std::deque<T>& queue = longest->second.queue;
+    auto victim = queue.begin();
+    if (best_effort_first && best_effort_predicate_)
+    {
+        victim = std::find_if(queue.begin(), queue.end(), best_effort_predicate_);
+        victim = (victim == queue.end()) ? queue.begin() : victim;
+    }
+    queue.erase(victim);
+
+    if (queue.empty())
+    {
+        /* Keys are only required to provide operator<. */
+        const Key& key = longest->first;
+        active_flows_.erase(std::find_if(active_flows_.begin(), active_flows_.end(),
+            [&key](const Key& other) { return !(other < key) && !(key < other); }));
+        flows_.erase(longest);
+    }
+    return true;
+}
+
+template<class T, class Key>
+inline typename FairScheduler<T, Key>::Flow& FairScheduler<T, Key>::activate_flow(
+        const Key& key,
+        bool front)
+{
+    auto it = flows_.find(key);
+    if (it == flows_.end())
+    {
+        const uint32_t weight = weight_ ? std::max(weight_(key), uint32_t(1)) : 1;
+        Flow flow;
+        flow.quantum = quantum_ * weight;
+        flow.deficit = flow.quantum;
+        it = flows_.emplace(key, std::move(flow)).first;
+        if (front)
+        {
+            active_flows_.push_front(key);
+        }
+        else
+        {
+            active_flows_.push_back(key);
+        }
+    }
+    return it->second;
+}
+
+template<class T, class Key>
+inline size_t FairScheduler<T, Key>::get_cost(
+        const T& element) const
+{
+    return cost_ ? cost_(element) : 1;
+}
+
+template<class T, class Key>
+inline void FairScheduler<T, Key>::push_front(
+        T&& element,
+        uint8_t priority)
+{
+    std::lock_guard<std::mutex> lock(mtx_);
+    if (0 == priority)
+    {
+        activate_flow(flow_key_(element), true).queue.push_front(std::forward<T>(element));
+        ++lane_.size;
+    }
+    else
+    {
+        auto it = priority_lanes_.find(priority);
+        if (it == priority_lanes_.end())
+        {
+            return;
+        }
+        it->second.queue.push_front(std::forward<T>(element));
+        ++it->second.size;
+    }
+    cond_var_.notify_one();
+}
+
+template<class T, class Key>
+inline bool FairScheduler<T, Key>::try_pop(
+        T& element)
+{
+    for (auto it = priority_lanes_.rbegin(); it != priority_lanes_.rend(); ++it)
+    {
+        if (!it->second.queue.empty())
+        {
+            element = std::move(it->second.queue.front());
+            it->second.queue.pop_front();
+            --it->second.size;
+            return true;
+        }
+    }
+
+    while (!active_flows_.empty())
+    {
+        auto it = flows_.find(active_flows_.front());
+        Flow& flow = it->second;
+        const size_t cost = get_cost(flow.queue.front());
+        if (flow.deficit < cost)
+        {
+            /* The flow has run out of credit in this round, move it to the end of the round. */
+            flow.deficit += flow.quantum;
+            active_flows_.push_back(active_flows_.front());
+            active_flows_.pop_front();
+            continue;
+        }
+
+        flow.deficit -= cost;
+        element = std::move(flow.queue.front());
+        flow.queue.pop_front();
+        --lane_.size;
+        if (flow.queue.empty())
+        {
+            active_flows_.pop_front();
+            flows_.erase(it);
+        }
+        return true;
+    }
+    return false;
+}
+
+template<class T, class Key>
+inline bool FairScheduler<T, Key>::pop(
+        T& element)
+{
+    std::unique_lock<std::mutex> lock(mtx_);
+    bool rv = false;
+    cond_var_.wait(lock, [this, &rv, &element] { return !running_cond_ || (rv = try_pop(element)); });
+    if (rv)
+    {
+        space_cond_var_.notify_all();
+    }
+    return rv;
+}
+
+template<class T, class Key>
+inline bool FairScheduler<T, Key>::pop_batch(
+        std::vector<T>& elements,
+        size_t max_elements)
+{
+    if (0 == max_elements)
+    {
+        return false;
+    }
+
+    T element;
+    if (!pop(element))
+    {
+        return false;
+    }
+    elements.push_back(std::move(element));
+
+    std::lock_guard<std::mutex> lock(mtx_);
+    while ((elements.size() < max_elements) && try_pop(element))
+    {
+        elements.push_back(std::move(element));
+    }
+    space_cond_var_.notify_all();
+    return true;
+}
+
+template<class T, class Key>
+inline void FairScheduler<T, Key>::get_stats(
+        std::vector<SchedulerLaneStats>& stats)
+{
+    std::lock_guard<std::mutex> lock(mtx_);
+    for (auto it = priority_lanes_.rbegin(); it != priority_lanes_.rend(); ++it)
+    {
+        stats.push_back(SchedulerLaneStats{it->first, it->second.capacity, it->second.size,
+                                           it->second.enqueued, it->second.dropped, it->second.high_watermark});
+    }
+    stats.push_back(SchedulerLaneStats{0, lane_.capacity, lane_.size,
+                                       lane_.enqueued, lane_.dropped, lane_.high_watermark});
+}
+
+} // namespace uxr
+} // namespace eprosima
+
+#endif // UXR_AGENT_SCHEDULER_FAIR_SCHEDULER_HPP_
@@ -0,0 +1,173 @@
+// Copyright 2018 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef UXR_AGENT_SCHEDULER_MPMC_QUEUE_HPP_
+#define UXR_AGENT_SCHEDULER_MPMC_QUEUE_HPP_
+
+#include <atomic>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+namespace eprosima {
+namespace uxr {
+
+constexpr size_t CACHE_LINE_SIZE = 64;
+
+/**
+ * @brief   Bounded multi-producer/multi-consumer lock-free queue.
+ *          Each cell carries a sequence number which tells producers and consumers whether
+ *          the cell is ready to be written or read, so that the only shared write points
+ *          are the head and tail counters, each one placed in its own cache line.
+ *          All the storage is allocated at construction time.
+ *          Sequence numbers are twice the position (plus one once written), which keeps the
+ *          written and free states apart even for a capacity of one.
+ */
+template<class T>
+class MPMCQueue
+{
+public:
+    explicit MPMCQueue(
+            size_t capacity)
+        : capacity_{(0 < capacity) ? capacity : 1}
+        , cells_(capacity_)
+        , enqueue_pos_{0}
+        , dequeue_pos_{0}
+    {
+        for (size_t i = 0; i < capacity_; ++i)
+        {
+            cells_[i].sequence.store(2 * i, std::memory_order_relaxed);
+        }
+    }
+
+    MPMCQueue(const MPMCQueue&) = delete;
+    MPMCQueue& operator=(const MPMCQueue&) = delete;
+
+    size_t capacity() const
+    {
+        return capacity_;
+    }
+
+    /**
+     * @brief   Tries to enqueue an element.
+     * @return  false if the queue is full, in which case the element is left untouched.
+     */
+    bool try_push(
+            T& element);
+
+    /**
+     * @brief   Tries to dequeue the oldest element.
+     * @return  false if the queue is empty.
+     */
+    bool try_pop(
+            T& element);
+
+    /**
+     * @brief   Approximate number of elements, exact when there are no concurrent operations.
+     */
+    size_t size() const
+    {
+        const size_t dequeue_pos = dequeue_pos_.load(std::memory_order_acquire);
+        const size_t enqueue_pos = enqueue_pos_.load(std::memory_order_acquire);
+        return (enqueue_pos > dequeue_pos) ? enqueue_pos - dequeue_pos : 0;
+    }
+
+    bool empty() const
+    {
+        return dequeue_pos_.load(std::memory_order_acquire) >= enqueue_pos_.load(std::memory_order_acquire);
+    }
+
+private:
+    struct Cell
+    {
+        Cell()
+            : sequence{0}
+            , data()
+        {}
+
+        std::atomic<size_t> sequence;
+        T data;
+    };
+
+    const size_t capacity_;
+    std::vector<Cell> cells_;
+    char pad_0_[CACHE_LINE_SIZE];
+    std::atomic<size_t> enqueue_pos_;
+    char pad_1_[CACHE_LINE_SIZE - sizeof(std::atomic<size_t>)];
+    std::atomic<size_t> dequeue_pos_;
+    char pad_2_[CACHE_LINE_SIZE - sizeof(std::atomic<size_t>)];
+};
+
+template<class T>
+inline bool MPMCQueue<T>::try_push(
+        T& element)
+{
+    size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+    for (;;)
+    {
+        Cell& cell = cells_[pos % capacity_];
+        intptr_t diff = intptr_t(cell.sequence.load(std::memory_order_acquire)) - intptr_t(2 * pos);
+        if (0 == diff)
+        {
+            if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+            {
+                cell.data = std::move(element);
+                cell.sequence.store(2 * pos + 1, std::memory_order_release);
+                return true;
+            }
+        }
+        else if (0 > diff)
+        {
+            return false;
+        }
+        else
+        {
+            pos = enqueue_pos_.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+template<class T>
+inline bool MPMCQueue<T>::try_pop(
+        T& element)
+{
+    size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+    for (;;)
+    {
+        Cell& cell = cells_[pos % capacity_];
+        intptr_t diff = intptr_t(cell.sequence.load(std::memory_order_acquire)) - intptr_t(2 * pos + 1);
+        if (0 == diff)
+        {
+            if (dequeue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+            {
+                element = std::move(cell.data);
+                cell.sequence.store(2 * (pos + capacity_), std::memory_order_release);
+                return true;
+            }
+        }
+        else if (0 > diff)
+        {
+            return false;
+        }
+        else
+        {
+            pos = dequeue_pos_.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+} // namespace uxr
+} // namespace eprosima
+
+#endif // UXR_AGENT_SCHEDULER_MPMC_QUEUE_HPP_
@@ -16,29 +16,76 @@
 #define UXR_AGENT_SCHEDULER_FCFS_SCHEDULER_HPP_
 
 #include <uxr/agent/scheduler/Scheduler.hpp>
+#include <uxr/agent/scheduler/MPMCQueue.hpp>
 
 #include <deque>
 #include <mutex>
 #include <condition_variable>
 #include <atomic>
+#include <array>
+#include <vector>
+#include <map>
+#include <memory>
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <thread>
 
 namespace eprosima {
 namespace uxr {
 
+/**
+ * @brief   Priority scheduler backed by a preallocated lock-free ring per priority lane.
+ *          When a lane is full, the element to discard is selected by the lane OverflowPolicy
+ *          (drop_oldest by default). Lanes with OverflowPolicy::drop_best_effort_first keep best-effort
+ *          elements in a second ring, popped after the first one, and bound both rings by a shared count of
+ *          reserved slots, so the victim is the head of a ring and neither ring is ever reordered.
+ *          Consumers only park on a condition variable when every lane is empty.
+ *          Priority 0 is configured by init(), the remaining priorities shall be configured
+ *          through set_priority_size() before any push or pop.
+ */
 template<class T>
 class PacketScheduler : public Scheduler<T>
 {
 public:
     PacketScheduler(
             size_t max_size)
-        : deque_()
+        : lanes_()
+        , lane_index_()
+        , policies_()
+        , best_effort_predicate_()
         , mtx_()
         , cond_var_()
+        , space_cond_var_()
         , running_cond_(false)
+        , waiters_{0}
         , max_size_{max_size}
-    {}
+    {
+        lane_index_.fill(nullptr);
+    }
+
+    /**
+     * @brief   Sets the capacity of a priority lane. Not thread-safe with respect to push and pop.
+     */
+    void set_priority_size(uint8_t priority, size_t size) final;
 
-    void set_priority_size(uint8_t priority, size_t size);
+    /**
+     * @brief   Sets the overflow policy of a priority lane. Not thread-safe with respect to push and pop.
+     * @param   priority    Lane priority.
+     * @param   policy      Overflow policy.
+     * @param   timeout     Maximum time a producer waits for room with OverflowPolicy::block.
+     */
+    void set_overflow_policy(
+            uint8_t priority,
+            OverflowPolicy policy,
+            std::chrono::milliseconds timeout = std::chrono::milliseconds(0)) final;
+
+    /**
+     * @brief   Sets the function which tells whether an element may be discarded first
+     *          by OverflowPolicy::drop_best_effort_first. Not thread-safe with respect to push and pop.
+     */
+    void set_best_effort_predicate(
+            std::function<bool(const T&)> predicate) final;
 
     void init() final;
 
@@ -50,19 +97,115 @@ public:
 
     void push_front(
             T&& element,
-            uint8_t priority);
+            uint8_t priority) final;
 
     bool pop(
             T& element) final;
 
+    /**
+     * @brief   Blocks until at least one element is available and then drains, without blocking,
+     *          up to max_elements following the same priority order as pop().
+     * @param   elements        Vector where the popped elements are appended.
+     * @param   max_elements    Maximum number of elements to pop.
+     * @return  true if at least one element was popped, false if the scheduler was stopped.
+     */
+    bool pop_batch(
+            std::vector<T>& elements,
+            size_t max_elements) final;
+
+    /**
+     * @brief   Appends the statistics of every lane, from the highest to the lowest priority.
+     */
+    void get_stats(
+            std::vector<SchedulerLaneStats>& stats) final;
+
 private:
-    bool empty();
+    struct LanePolicy
+    {
+        OverflowPolicy policy;
+        std::chrono::milliseconds timeout;
+    };
+
+    struct Lane
+    {
+        Lane(
+                uint8_t lane_priority,
+                size_t size,
+                const LanePolicy& lane_policy)
+            : priority{lane_priority}
+            , policy(lane_policy)
+            , ring{size}
+            , best_effort_ring((OverflowPolicy::drop_best_effort_first == lane_policy.policy)
+                    ? new MPMCQueue<T>(size)
+                    : nullptr)
+            , reserved{0}
+            , front_mtx()
+            , front()
+            , front_size{0}
+            , blocked_producers{0}
+            , enqueued{0}
+            , dropped{0}
+            , high_watermark{0}
+        {}
+
+        const uint8_t priority;
+        LanePolicy policy;
+        MPMCQueue<T> ring;
+        std::unique_ptr<MPMCQueue<T>> best_effort_ring;
+        std::atomic<size_t> reserved;
+        std::mutex front_mtx;
+        std::deque<T> front;
+        std::atomic<size_t> front_size;
+        std::atomic<size_t> blocked_producers;
+        std::atomic<uint64_t> enqueued;
+        std::atomic<uint64_t> dropped;
+        std::atomic<size_t> high_watermark;
+    };
+
+    void build_lane(
+            uint8_t priority,
+            size_t size);
 
-    std::map<uint8_t, std::deque<T>> deque_;
-    std::map<uint8_t, size_t> sizes_;
+    bool is_best_effort(
+            const T& element) const;
+
+    bool try_push(
+            Lane& lane,
+            T& element);
+
+    bool push_overflow(
+            Lane& lane,
+            T& element);
+
+    bool wait_for_room(
+            Lane& lane,
+            T& element);
+
+    bool drop_best_effort(
+            Lane& lane,
+            T& element);
+
+    size_t get_size(
+            const Lane& lane) const;
+
+    void update_high_watermark(
+            Lane& lane);
+
+    bool try_pop(
+            T& element,
+            bool& room_released);
+
+    void notify();
+
+    std::vector<std::unique_ptr<Lane>> lanes_;
+    std::array<Lane*, 256> lane_index_;
+    std::map<uint8_t, LanePolicy> policies_;
+    std::function<bool(const T&)> best_effort_predicate_;
     std::mutex mtx_;
     std::condition_variable cond_var_;
-    bool running_cond_;
+    std::condition_variable space_cond_var_;
+    std::atomic<bool> running_cond_;
+    std::atomic<size_t> waiters_;
     const size_t max_size_;
 };
 
@@ -70,14 +213,112 @@ template<class T>
 inline void PacketScheduler<T>::set_priority_size(uint8_t priority, size_t size)
 {
     std::lock_guard<std::mutex> lock(mtx_);
-    sizes_[priority] = size;
+    Lane* old_lane = lane_index_[priority];
+    if ((nullptr != old_lane) && (old_lane->ring.capacity() == size))
+    {
+        return;
+    }
+    build_lane(priority, size);
 }
 
 template<class T>
-inline void PacketScheduler<T>::init()
+inline void PacketScheduler<T>::build_lane(
+        uint8_t priority,
+        size_t size)
+{
+    LanePolicy lane_policy{OverflowPolicy::drop_oldest, std::chrono::milliseconds(0)};
+    auto it_policy = policies_.find(priority);
+    if (it_policy != policies_.end())
+    {
+        lane_policy = it_policy->second;
+    }
+
+    std::unique_ptr<Lane> new_lane(new Lane(priority, size, lane_policy));
+    Lane* old_lane = lane_index_[priority];
+    if (nullptr != old_lane)
+    {
+        new_lane->front = std::move(old_lane->front);
+        new_lane->front_size.store(new_lane->front.size());
+        new_lane->enqueued.store(old_lane->enqueued.load());
+        new_lane->dropped.store(old_lane->dropped.load());
+        new_lane->high_watermark.store(old_lane->high_watermark.load());
+        T element;
+        while (old_lane->ring.try_pop(element)
+                || ((nullptr != old_lane->best_effort_ring) && old_lane->best_effort_ring->try_pop(element)))
+        {
+            if (try_push(*new_lane, element))
+            {
+                continue;
+            }
+            if (nullptr != new_lane->best_effort_ring)
+            {
+                if (!drop_best_effort(*new_lane, element))
+                {
+                    new_lane->dropped.fetch_add(1);
+                }
+            }
+            else
+            {
+                T discarded;
+                new_lane->ring.try_pop(discarded);
+                new_lane->ring.try_push(element);
+                new_lane->dropped.fetch_add(1);
+            }
+        }
+    }
+
+    lane_index_[priority] = new_lane.get();
+    auto it = std::find_if(lanes_.begin(), lanes_.end(),
+        [priority](const std::unique_ptr<Lane>& lane) { return lane->priority == priority; });
+    if (it != lanes_.end())
+    {
+        *it = std::move(new_lane);
+    }
+    else
+    {
+        lanes_.push_back(std::move(new_lane));
+        std::sort(lanes_.begin(), lanes_.end(),
+            [](const std::unique_ptr<Lane>& a, const std::unique_ptr<Lane>& b) { return a->priority > b->priority; });
+    }
+}
+
+template<class T>
+inline void PacketScheduler<T>::set_overflow_policy(
+        uint8_t priority,
+        OverflowPolicy policy,
+        std::chrono::milliseconds timeout)
+{
+    std::lock_guard<std::mutex> lock(mtx_);
+    LanePolicy lane_policy{policy, timeout};
+    policies_[priority] = lane_policy;
+    Lane* lane = lane_index_[priority];
+    if (nullptr != lane)
+    {
+        /* Switching to or from drop_best_effort_first adds or removes the best-effort ring. */
+        const bool split = (OverflowPolicy::drop_best_effort_first == policy);
+        if (split == (nullptr != lane->best_effort_ring))
+        {
+            lane->policy = lane_policy;
+        }
+        else
+        {
+            build_lane(priority, lane->ring.capacity());
+        }
+    }
+}
+
+template<class T>
+inline void PacketScheduler<T>::set_best_effort_predicate(
+        std::function<bool(const T&)> predicate)
 {
     std::lock_guard<std::mutex> lock(mtx_);
-    sizes_[0] = max_size_;
+    best_effort_predicate_ = std::move(predicate);
+}
+
+template<class T>
+inline void PacketScheduler<T>::init()
+{
+    set_priority_size(0, max_size_);
     running_cond_ = true;
 }
 
@@ -86,7 +327,8 @@ inline void PacketScheduler<T>::deinit()
 {
     std::lock_guard<std::mutex> lock(mtx_);
     running_cond_ = false;
-    cond_var_.notify_one();
+    cond_var_.notify_all();
+    space_cond_var_.notify_all();
 }
 
 template<class T>
@@ -94,61 +336,325 @@ inline void PacketScheduler<T>::push(
         T&& element,
         uint8_t priority)
 {
-    std::lock_guard<std::mutex> lock(mtx_);
-    if (sizes_[priority] <= deque_[priority].size())
+    Lane* lane = lane_index_[priority];
+    if (nullptr == lane)
+    {
+        return;
+    }
+
+    if (try_push(*lane, element) || push_overflow(*lane, element))
     {
-        deque_[priority].pop_front();
+        lane->enqueued.fetch_add(1, std::memory_order_relaxed);
+        update_high_watermark(*lane);
+        notify();
+    }
+    else
+    {
+        lane->dropped.fetch_add(1, std::memory_order_relaxed);
     }
-    deque_[priority].push_back(std::move(element));
-    cond_var_.notify_one();
 }
 
 template<class T>
-inline void PacketScheduler<T>::push_front(
-        T&& element,
-        uint8_t priority)
+inline bool PacketScheduler<T>::is_best_effort(
+        const T& element) const
 {
-    std::lock_guard<std::mutex> lock(mtx_);
-    deque_[priority].push_front(std::forward<T>(element));
+    return best_effort_predicate_ && best_effort_predicate_(element);
 }
 
 template<class T>
-inline bool PacketScheduler<T>::empty()
+inline bool PacketScheduler<T>::try_push(
+        Lane& lane,
+        T& element)
 {
-    for (auto& deque : deque_) {
-        if (!deque.second.empty())
+    if (nullptr == lane.best_effort_ring)
+    {
+        return lane.ring.try_push(element);
+    }
+
+    /*
+     * A slot is reserved before pushing and released after popping, so neither ring holds more elements,
+     * including those being pushed or popped, than the reserved ones, and the push always finds room.
+     */
+    size_t reserved = lane.reserved.load(std::memory_order_relaxed);
+    do
+    {
+        if (lane.ring.capacity() <= reserved)
         {
             return false;
         }
     }
+    while (!lane.reserved.compare_exchange_weak(reserved, reserved + 1, std::memory_order_acq_rel));
 
+    MPMCQueue<T>& ring = is_best_effort(element) ? *lane.best_effort_ring : lane.ring;
+    if (!ring.try_push(element))
+    {
+        lane.reserved.fetch_sub(1, std::memory_order_release);
+        return false;
+    }
     return true;
 }
 
 template<class T>
-inline bool PacketScheduler<T>::pop(
+inline bool PacketScheduler<T>::push_overflow(
+        Lane& lane,
         T& element)
 {
-    bool rv = false;
+    switch (lane.policy.policy)
+    {
+        case OverflowPolicy::drop_newest:
+            return false;
+
+        case OverflowPolicy::block:
+            return wait_for_room(lane, element);
+
+        case OverflowPolicy::drop_best_effort_first:
+            return drop_best_effort(lane, element);
+
+        case OverflowPolicy::drop_oldest:
+        default:
+            while (!lane.ring.try_push(element))
+            {
+                T discarded;
+                if (lane.ring.try_pop(discarded))
+                {
+                    lane.dropped.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+            return true;
+    }
+}
+
+template<class T>
+inline bool PacketScheduler<T>::wait_for_room(
+        Lane& lane,
+        T& element)
+{
+    const auto deadline = std::chrono::steady_clock::now() + lane.policy.timeout;
     std::unique_lock<std::mutex> lock(mtx_);
-    cond_var_.wait(lock, [this] { return !(empty() && running_cond_); });
-    if (running_cond_)
+    lane.blocked_producers.fetch_add(1);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    bool rv = false;
+    while (running_cond_ && !(rv = lane.ring.try_push(element)))
     {
-        uint8_t available_priority;
+        if (std::cv_status::timeout == space_cond_var_.wait_until(lock, deadline))
+        {
+            rv = lane.ring.try_push(element);
+            break;
+        }
+    }
+    lane.blocked_producers.fetch_sub(1);
+    return rv;
+}
 
-        for(auto iter = deque_.rbegin(); iter != deque_.rend(); ++iter){
-            if(iter->second.size() > 0){
-                available_priority = iter->first;
-                break;
+template<class T>
+inline bool PacketScheduler<T>::drop_best_effort(
+        Lane& lane,
+        T& element)
+{
+    /*
+     * The victim is the oldest best-effort element, or the oldest reliable one if the reliable ring holds
+     * every reserved slot, and its reserved slot is handed over to the pushed element.
+     */
+    MPMCQueue<T>& ring = is_best_effort(element) ? *lane.best_effort_ring : lane.ring;
+    T discarded;
+    for (;;)
+    {
+        if (lane.best_effort_ring->try_pop(discarded)
+                || ((lane.ring.capacity() <= lane.ring.size()) && lane.ring.try_pop(discarded)))
+        {
+            lane.dropped.fetch_add(1, std::memory_order_relaxed);
+            if (!ring.try_push(element))
+            {
+                lane.reserved.fetch_sub(1, std::memory_order_release);
+                return false;
             }
+            return true;
+        }
+
+        /* Consumers emptied the lane meanwhile. */
+        if (try_push(lane, element))
+        {
+            return true;
         }
 
-        element = std::move(deque_[available_priority].front());
-        deque_[available_priority].pop_front();
-        rv = true;
+        /* Slots being pushed or popped by other threads are settled shortly. */
+        std::this_thread::yield();
+    }
+}
+
+template<class T>
+inline size_t PacketScheduler<T>::get_size(
+        const Lane& lane) const
+{
+    const size_t size = (nullptr != lane.best_effort_ring)
+            ? lane.reserved.load(std::memory_order_relaxed)
+            : lane.ring.size();
+    return size + lane.front_size.load(std::memory_order_relaxed);
+}
+
+template<class T>
+inline void PacketScheduler<T>::update_high_watermark(
+        Lane& lane)
+{
+    const size_t size = get_size(lane);
+    size_t high_watermark = lane.high_watermark.load(std::memory_order_relaxed);
+    while ((size > high_watermark) &&
+           !lane.high_watermark.compare_exchange_weak(high_watermark, size, std::memory_order_relaxed))
+    {
+    }
+}
+
+template<class T>
+inline void PacketScheduler<T>::push_front(
+        T&& element,
+        uint8_t priority)
+{
+    Lane* lane = lane_index_[priority];
+    if (nullptr == lane)
+    {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(lane->front_mtx);
+        lane->front.push_front(std::forward<T>(element));
+        lane->front_size.fetch_add(1);
+    }
+    notify();
+}
+
+template<class T>
+inline void PacketScheduler<T>::notify()
+{
+    /* Pairs with the fence in pop(), either the consumer sees the element or we see the waiter. */
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (0 < waiters_.load(std::memory_order_relaxed))
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
         cond_var_.notify_one();
     }
-    return rv;
+}
+
+template<class T>
+inline bool PacketScheduler<T>::try_pop(
+        T& element,
+        bool& room_released)
+{
+    for (auto& lane : lanes_)
+    {
+        if (0 < lane->front_size.load(std::memory_order_acquire))
+        {
+            std::lock_guard<std::mutex> lock(lane->front_mtx);
+            if (!lane->front.empty())
+            {
+                element = std::move(lane->front.front());
+                lane->front.pop_front();
+                lane->front_size.fetch_sub(1);
+                return true;
+            }
+        }
+        if (lane->ring.try_pop(element)
+                || ((nullptr != lane->best_effort_ring) && lane->best_effort_ring->try_pop(element)))
+        {
+            if (nullptr != lane->best_effort_ring)
+            {
+                lane->reserved.fetch_sub(1, std::memory_order_release);
+            }
+            /* Pairs with the fence in wait_for_room(). */
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (0 < lane->blocked_producers.load(std::memory_order_relaxed))
+            {
+                room_released = true;
+            }
+            return true;
+        }
+    }
+    return false;
+}
+
+template<class T>
+inline bool PacketScheduler<T>::pop(
+        T& element)
+{
+    bool room_released = false;
+    while (running_cond_)
+    {
+        if (try_pop(element, room_released))
+        {
+            if (room_released)
+            {
+                std::lock_guard<std::mutex> lock(mtx_);
+                space_cond_var_.notify_all();
+            }
+            return true;
+        }
+
+        std::unique_lock<std::mutex> lock(mtx_);
+        waiters_.fetch_add(1);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        bool rv = running_cond_ && try_pop(element, room_released);
+        if (!rv && running_cond_)
+        {
+            cond_var_.wait(lock);
+        }
+        waiters_.fetch_sub(1);
+        if (rv)
+        {
+            if (room_released)
+            {
+                space_cond_var_.notify_all();
+            }
+            return true;
+        }
+    }
+    return false;
+}
+
+template<class T>
+inline bool PacketScheduler<T>::pop_batch(
+        std::vector<T>& elements,
+        size_t max_elements)
+{
+    if (0 == max_elements)
+    {
+        return false;
+    }
+
+    T element;
+    if (!pop(element))
+    {
+        return false;
+    }
+    elements.push_back(std::move(element));
+
+    bool room_released = false;
+    while ((elements.size() < max_elements) && try_pop(element, room_released))
+    {
+        elements.push_back(std::move(element));
+    }
+    if (room_released)
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        space_cond_var_.notify_all();
+    }
+    return true;
+}
+
+template<class T>
+inline void PacketScheduler<T>::get_stats(
+        std::vector<SchedulerLaneStats>& stats)
+{
+    for (auto& lane : lanes_)
+    {
+        SchedulerLaneStats lane_stats;
+        lane_stats.priority = lane->priority;
+        lane_stats.capacity = lane->ring.capacity();
+        lane_stats.size = get_size(*lane);
+        lane_stats.enqueued = lane->enqueued.load(std::memory_order_relaxed);
+        lane_stats.dropped = lane->dropped.load(std::memory_order_relaxed);
+        lane_stats.high_watermark = lane->high_watermark.load(std::memory_order_relaxed);
+        stats.push_back(lane_stats);
+    }
 }
 
 } // namespace uxr
@@ -16,10 +16,38 @@
 #define _UXR_AGENT_SCHEDULER_SCHEDULER_HPP_
 
 #include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <chrono>
+#include <functional>
 
 namespace eprosima {
 namespace uxr {
 
+/**
+ * @brief   Behaviour of a priority lane when an element is pushed and the lane is full.
+ */
+enum class OverflowPolicy : uint8_t
+{
+    drop_oldest,                ///< The oldest element of the lane is discarded.
+    drop_newest,                ///< The pushed element is discarded.
+    block,                      ///< The producer waits for room up to a timeout, then the pushed element is discarded.
+    drop_best_effort_first      ///< The oldest best-effort element is discarded, or the oldest one if there is none.
+};
+
+/**
+ * @brief   Statistics of a priority lane.
+ */
+struct SchedulerLaneStats
+{
+    uint8_t priority;
+    size_t capacity;
+    size_t size;
+    uint64_t enqueued;
+    uint64_t dropped;
+    size_t high_watermark;
+};
+
 template<class T>
 class Scheduler
 {
@@ -31,6 +59,13 @@ public:
     virtual void deinit() = 0;
     virtual void push(T&& element, uint8_t priority) = 0;
     virtual bool pop(T& element) = 0;
+
+    virtual void set_priority_size(uint8_t priority, size_t size) = 0;
+    virtual void set_overflow_policy(uint8_t priority, OverflowPolicy policy, std::chrono::milliseconds timeout) = 0;
+    virtual void set_best_effort_predicate(std::function<bool(const T&)> predicate) = 0;
+    virtual void push_front(T&& element, uint8_t priority) = 0;
+    virtual bool pop_batch(std::vector<T>& elements, size_t max_elements) = 0;
+    virtual void get_stats(std::vector<SchedulerLaneStats>& stats) = 0;
 };
 
 } // namespace uxr
@@ -19,10 +19,15 @@
 #include <uxr/agent/transport/TransportRc.hpp>
 #include <uxr/agent/transport/SessionManager.hpp>
 #include <uxr/agent/scheduler/PacketScheduler.hpp>
+#include <uxr/agent/scheduler/FairScheduler.hpp>
+#include <uxr/agent/message/BufferPool.hpp>
 #include <uxr/agent/message/Packet.hpp>
 #include <uxr/agent/processor/Processor.hpp>
 
 #include <thread>
+#include <vector>
+#include <memory>
+#include <map>
 
 namespace eprosima {
 namespace uxr {
@@ -30,6 +35,12 @@ namespace uxr {
 template<typename EndPoint>
 class Processor;
 
+#ifdef __linux__
+namespace util {
+class Reactor;
+} // namespace util
+#endif
+
 template<typename EndPoint>
 class Server : public Agent, public SessionManager<EndPoint>
 {
@@ -42,6 +53,116 @@ public:
     UXR_AGENT_EXPORT bool start();
     UXR_AGENT_EXPORT bool stop();
 
+    /**
+     * @brief Sets the number of threads processing input packets.
+     *        Packets are routed to a processing thread by client key (or by source endpoint
+     *        when the client key is not carried in the header), so messages of a session
+     *        are processed in order while different clients are processed in parallel.
+     *        It shall be called before starting the server.
+     * @param count Number of processing threads, greater than 0.
+     * @return true in case of success, false in other case.
+     */
+    UXR_AGENT_EXPORT bool set_processing_threads(size_t count);
+
+    /**
+     * @brief Sets the overflow policy of an input queue lane (priority 0 for regular messages,
+     *        priority 1 for HEARTBEATs). With OverflowPolicy::drop_best_effort_first,
+     *        messages of non-reliable streams are discarded first.
+     *        It shall be called before starting the server.
+     * @param priority Lane priority.
+     * @param policy   Overflow policy.
+     * @param timeout  Maximum blocking time of the receiver thread with OverflowPolicy::block.
+     * @return true in case of success, false in other case.
+     */
+    UXR_AGENT_EXPORT bool set_input_overflow_policy(
+            uint8_t priority,
+            OverflowPolicy policy,
+            std::chrono::milliseconds timeout = std::chrono::milliseconds(0));
+
+    /**
+     * @brief Sets the overflow policy of the output queue.
+     *        It shall be called before starting the server.
+     * @param policy  Overflow policy.
+     * @param timeout Maximum blocking time of the producer with OverflowPolicy::block.
+     * @return true in case of success, false in other case.
+     */
+    UXR_AGENT_EXPORT bool set_output_overflow_policy(
+            OverflowPolicy policy,
+            std::chrono::milliseconds timeout = std::chrono::milliseconds(0));
+
+    /**
+     * @brief Enables or disables per-client fair queuing in the output queue.
+     *        When enabled, output packets are grouped by destination and served with deficit
+     *        round robin, so a client with a large backlog does not delay the others.
+     *        It shall be called before starting the server.
+     * @param enable Whether fair queuing is used.
+     * @return true in case of success, false in other case.
+     */
+    UXR_AGENT_EXPORT bool set_output_fair_queuing(bool enable);
+
+    /**
+     * @brief Sets the share of the output bandwidth given to a client when fair queuing is enabled.
+     *        Clients have weight 1 by default.
+     * @param client_key Raw client key.
+     * @param weight     Relative weight, greater than 0.
+     * @return true in case of success, false in other case.
+     */
+    UXR_AGENT_EXPORT bool set_output_client_weight(
+            uint32_t client_key,
+            uint32_t weight);
+
+    /**
+     * @brief Sets the time a STATUS or DATA submessage may wait for others of the same stream,
+     *        so that they are packed together into messages up to the session MTU.
+     *        The open message is flushed once the linger time has elapsed, with the granularity
+     *        of the heartbeat timer, or as soon as the next submessage does not fit into it.
+     *        A linger time of 0, the default, sends every submessage in its own message.
+     *        It shall be called before starting the server.
+     * @param linger Linger time.
+     * @return true in case of success, false in other case.
+     */
+    UXR_AGENT_EXPORT bool set_output_linger(std::chrono::milliseconds linger);
+
+    /**
+     * @brief Sets how the messages received on reliable streams are acknowledged.
+     *        An ACKNACK is sent once max_pending messages of a stream are unacknowledged, up to half
+     *        the stream depth, or once the delay has elapsed since the first of them, with the granularity
+     *        of the heartbeat timer. Missing or repeated messages are answered right away.
+     *        A delay of 0, the default, acknowledges every message.
+     *        It shall be called before starting the server.
+     * @param max_pending   Maximum number of messages acknowledged by a delayed ACKNACK.
+     * @param delay         Maximum time an ACKNACK is delayed.
+     * @return true in case of success, false in other case.
+     */
+    UXR_AGENT_EXPORT bool set_acknack_policy(
+            uint16_t max_pending,
+            std::chrono::milliseconds delay);
+
+    /**
+     * @brief Retrieves the statistics of the input and output queues, one entry per lane.
+     *        Input statistics are aggregated over the processing threads: counters are added up
+     *        while capacity and high watermark are given per queue.
+     * @param input_stats  Statistics of the input queue lanes.
+     * @param output_stats Statistics of the output queue lanes.
+     */
+    UXR_AGENT_EXPORT void get_queue_stats(
+            std::vector<SchedulerLaneStats>& input_stats,
+            std::vector<SchedulerLaneStats>& output_stats);
+
+#ifndef _WIN32
+    /**
+     * @brief Enables or disables the reactor mode.
+     *        In reactor mode a single event loop thread waits with epoll on the transport descriptors
+     *        and the heartbeat timer, and reads input messages only when they are ready, instead of
+     *        running a receiver thread blocked on poll() and a heartbeat thread.
+     *        Transports without reactor support keep the threaded receiver.
+     *        It shall be called before starting the server. Only available on Linux.
+     * @param enable Whether the reactor mode is used.
+     * @return true in case of success, false in other case.
+     */
+    UXR_AGENT_EXPORT bool set_reactor_mode(bool enable);
+#endif
+
 #ifdef UAGENT_DISCOVERY_PROFILE
     UXR_AGENT_EXPORT virtual bool has_discovery() = 0;
     UXR_AGENT_EXPORT bool enable_discovery(uint16_t discovery_port = DISCOVERY_PORT);
@@ -87,45 +208,165 @@ private:
             int timeout,
             TransportRc& transport_rc) = 0;
 
+    /**
+     * @brief Receives a burst of input packets.
+     *        The default implementation receives a single packet through recv_message(), transports
+     *        able to read several packets at once (e.g. recvmmsg) may override it.
+     * @param input_packets Vector the received packets are appended to.
+     * @param timeout       Maximum waiting time in milliseconds for the first packet.
+     * @param transport_rc  Error code in case no packet is received.
+     * @return true if at least a packet has been received, false in other case.
+     */
     virtual bool recv_message(
-            std::vector<InputPacket<EndPoint>>& /* input_packet */,
-            int /* timeout */,
-            TransportRc& /* transport_rc */) {
-                    return false;
-                };
+            std::vector<InputPacket<EndPoint>>& input_packets,
+            int timeout,
+            TransportRc& transport_rc)
+    {
+        InputPacket<EndPoint> input_packet;
+        bool rv = recv_message(input_packet, timeout, transport_rc);
+        if (rv)
+        {
+            input_packets.push_back(std::move(input_packet));
+        }
+        return rv;
+    }
 
     virtual bool send_message(
             OutputPacket<EndPoint> output_packet,
             TransportRc& transport_rc) = 0;
 
+    /**
+     * @brief Sends a burst of output packets.
+     *        The default implementation sends them one by one through send_message(), transports
+     *        able to flush several packets at once (e.g. sendmmsg or writev) may override it.
+     * @param output_packets Packets to send, in order.
+     * @param sent_count     Number of packets sent successfully before any error.
+     * @param transport_rc   Error code of the first failed packet.
+     * @return true if all the packets were sent, false in other case.
+     */
+    virtual bool send_messages(
+            const std::vector<OutputPacket<EndPoint>>& output_packets,
+            size_t& sent_count,
+            TransportRc& transport_rc);
+
     virtual bool handle_error(TransportRc transport_rc) = 0;
 
+#ifndef _WIN32
+    /**
+     * @brief Retrieves the descriptors which shall be watched for input readiness in reactor mode.
+     *        They are queried again after a transport error has been handled.
+     * @param fds Descriptors of the transport.
+     * @return true if the transport supports the reactor mode, false in other case.
+     */
+    virtual bool get_reactor_fds(
+            std::vector<int>& /* fds */) {
+                    return false;
+                };
+
+    /**
+     * @brief Reads a message from a descriptor reported as readable, without blocking.
+     * @param fd           Ready descriptor, one of those given by get_reactor_fds().
+     * @param input_packet Received packet.
+     * @param transport_rc TransportRc::timeout_error when there is nothing left to read.
+     * @return true if a message has been read, false in other case.
+     */
+    virtual bool recv_ready_message(
+            int /* fd */,
+            InputPacket<EndPoint>& /* input_packet */,
+            TransportRc& /* transport_rc */) {
+                    return false;
+                };
+
+    /**
+     * @brief Reads the messages pending in a descriptor reported as readable, without blocking.
+     *        The default implementation reads a single message through recv_ready_message().
+     * @param fd            Ready descriptor, one of those given by get_reactor_fds().
+     * @param input_packets Vector the received packets are appended to.
+     * @param transport_rc  TransportRc::timeout_error when there is nothing left to read.
+     * @return true if at least a message has been read, false in other case.
+     */
+    virtual bool recv_ready_messages(
+            int fd,
+            std::vector<InputPacket<EndPoint>>& input_packets,
+            TransportRc& transport_rc)
+    {
+        InputPacket<EndPoint> input_packet;
+        bool rv = recv_ready_message(fd, input_packet, transport_rc);
+        if (rv)
+        {
+            input_packets.push_back(std::move(input_packet));
+        }
+        return rv;
+    }
+
+#endif
+
+#ifdef __linux__
+    void reactor_loop();
+
+    bool register_reactor_fds();
+
+    void on_readable(
+            int fd);
+#endif
+
+    void dispatch_input_packet(
+            InputPacket<EndPoint>&& input_packet);
+
     void receiver_loop();
 
     void sender_loop();
 
-    void processing_loop();
+    void processing_loop(
+            size_t shard);
 
     void heartbeat_loop();
 
+    size_t get_processing_shard(
+            const InputPacket<EndPoint>& input_packet);
+
+    uint32_t get_output_weight(
+            const EndPoint& endpoint);
+
     void error_handler_loop();
 
 protected:
+    /**
+     * @brief Pool of the buffers where incoming messages are stored.
+     *        Transports receive into it, or copy into it, so that no allocation is needed per message.
+     */
+    const std::shared_ptr<BufferPool>& get_input_buffer_pool() const { return input_buffer_pool_; }
+
     Processor<EndPoint>* processor_;
 
 private:
+    std::shared_ptr<BufferPool> input_buffer_pool_;
     std::mutex mtx_;
     std::thread receiver_thread_;
     std::thread sender_thread_;
-    std::thread processing_thread_;
+    std::vector<std::thread> processing_threads_;
     std::thread heartbeat_thread_;
     std::thread error_handler_thread_;
     std::atomic<bool> running_cond_;
-    PacketScheduler<InputPacket<EndPoint>> input_scheduler_;
-    PacketScheduler<OutputPacket<EndPoint>> output_scheduler_;
+    size_t processing_threads_count_;
+    std::map<uint8_t, std::pair<OverflowPolicy, std::chrono::milliseconds>> input_overflow_policies_;
+    std::vector<std::unique_ptr<PacketScheduler<InputPacket<EndPoint>>>> input_schedulers_;
+    std::unique_ptr<Scheduler<OutputPacket<EndPoint>>> output_scheduler_;
+    std::pair<OverflowPolicy, std::chrono::milliseconds> output_overflow_policy_;
+    std::map<uint32_t, uint32_t> output_client_weights_;
+    std::mutex output_client_weights_mtx_;
     TransportRc transport_rc_;
     std::mutex error_mtx_;
     std::condition_variable error_cv_;
+#ifndef _WIN32
+    bool reactor_mode_;
+#endif
+#ifdef __linux__
+    std::unique_ptr<util::Reactor> reactor_;
+    std::thread reactor_thread_;
+    TransportRc reactor_rc_;
+    std::vector<InputPacket<EndPoint>> reactor_packets_;
+#endif
 };
 
 } // namespace uxr
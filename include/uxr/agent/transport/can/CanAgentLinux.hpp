@@ -54,6 +54,14 @@ private:
             int timeout,
             TransportRc& transport_rc) final;
 
+    bool get_reactor_fds(
+            std::vector<int>& fds) final;
+
+    bool recv_ready_message(
+            int fd,
+            InputPacket<CanEndPoint>& input_packet,
+            TransportRc& transport_rc) final;
+
     bool send_message(
             OutputPacket<CanEndPoint> output_packet,
             TransportRc& transport_rc) final;
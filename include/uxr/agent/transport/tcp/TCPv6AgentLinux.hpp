@@ -23,6 +23,7 @@
 
 #include <netinet/in.h>
 #include <sys/poll.h>
+#include <sys/uio.h>
 #include <array>
 #include <list>
 #include <set>
@@ -117,6 +118,15 @@ private:
             size_t len,
             TransportRc& transport_rc) final;
 
+    /**
+     * @brief Sends gathered segments with a single call and skips the sent bytes in them.
+     * @return Number of bytes sent.
+     */
+    size_t send_segments(
+            TCPv6ConnectionLinux& connection,
+            std::array<struct iovec, 3>& iov,
+            TransportRc& transport_rc);
+
 private:
     std::array<TCPv6ConnectionLinux, TCP_MAX_CONNECTIONS> connections_;
     std::set<uint32_t> active_connections_;
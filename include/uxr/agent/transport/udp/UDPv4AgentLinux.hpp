@@ -17,6 +17,7 @@
 
 #include <uxr/agent/transport/Server.hpp>
 #include <uxr/agent/transport/endpoint/IPv4EndPoint.hpp>
+#include <uxr/agent/transport/util/DatagramBatchLinux.hpp>
 #ifdef UAGENT_DISCOVERY_PROFILE
 #include <uxr/agent/transport/discovery/DiscoveryServerLinux.hpp>
 #endif
@@ -27,6 +28,7 @@
 #include <cstdint>
 #include <cstddef>
 #include <sys/poll.h>
+#include <netinet/in.h>
 #include <unordered_map>
 
 namespace eprosima {
@@ -73,16 +75,46 @@ private:
             int timeout,
             TransportRc& transport_rc) final;
 
+    bool get_reactor_fds(
+            std::vector<int>& fds) final;
+
+    bool recv_message(
+            std::vector<InputPacket<IPv4EndPoint>>& input_packets,
+            int timeout,
+            TransportRc& transport_rc) final;
+
+    bool recv_ready_message(
+            int fd,
+            InputPacket<IPv4EndPoint>& input_packet,
+            TransportRc& transport_rc) final;
+
+    bool recv_ready_messages(
+            int fd,
+            std::vector<InputPacket<IPv4EndPoint>>& input_packets,
+            TransportRc& transport_rc) final;
+
     bool send_message(
             OutputPacket<IPv4EndPoint> output_packet,
             TransportRc& transport_rc) final;
 
+    bool send_messages(
+            const std::vector<OutputPacket<IPv4EndPoint>>& output_packets,
+            size_t& sent_count,
+            TransportRc& transport_rc) final;
+
+    void set_input_packet(
+            BufferPool::Buffer&& buffer,
+            size_t len,
+            const struct sockaddr_in& source,
+            InputPacket<IPv4EndPoint>& input_packet);
+
     bool handle_error(
             TransportRc transport_rc) final;
 
 private:
     struct pollfd poll_fd_;
-    uint8_t buffer_[SERVER_BUFFER_SIZE];
+    util::DatagramReceiver<struct sockaddr_in> receiver_;
+    util::DatagramSender<struct sockaddr_in> sender_;
     uint16_t agent_port_;
 #ifdef UAGENT_DISCOVERY_PROFILE
     DiscoveryServerLinux<IPv4EndPoint> discovery_server_;
@@ -0,0 +1,283 @@
+// Copyright 2018 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef UXR_AGENT_TRANSPORT_UTIL_DATAGRAMBATCHLINUX_HPP_
+#define UXR_AGENT_TRANSPORT_UTIL_DATAGRAMBATCHLINUX_HPP_
+
+#include <uxr/agent/message/BufferPool.hpp>
+
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace eprosima {
+namespace uxr {
+namespace util {
+
+#ifdef __linux__
+using MultiMsgHdr = struct mmsghdr;
+#else
+/* Layout of mmsghdr, which recvmmsg and sendmmsg only provide on Linux. */
+struct MultiMsgHdr
+{
+    struct msghdr msg_hdr;
+    unsigned int msg_len;
+};
+#endif // __linux__
+
+/**
+ * @brief   Receives up to count datagrams without blocking, with a single recvmmsg on Linux and a recvmsg
+ *          per datagram elsewhere.
+ * @return  Number of datagrams received, -1 on error, with errno set.
+ */
+inline int recv_datagrams(
+        int fd,
+        MultiMsgHdr* msgs,
+        unsigned int count)
+{
+#ifdef __linux__
+    return recvmmsg(fd, msgs, count, MSG_DONTWAIT, nullptr);
+#else
+    unsigned int received = 0;
+    for (; received < count; ++received)
+    {
+        const ssize_t len = recvmsg(fd, &msgs[received].msg_hdr, MSG_DONTWAIT);
+        if (0 > len)
+        {
+            break;
+        }
+        msgs[received].msg_len = static_cast<unsigned int>(len);
+    }
+    return (0 < received) ? int(received) : -1;
+#endif // __linux__
+}
+
+/**
+ * @brief   Sends up to count datagrams, with a single sendmmsg on Linux and a sendmsg per datagram elsewhere.
+ * @return  Number of datagrams sent, -1 on error, with errno set.
+ */
+inline int send_datagrams(
+        int fd,
+        MultiMsgHdr* msgs,
+        unsigned int count)
+{
+#ifdef __linux__
+    return sendmmsg(fd, msgs, count, 0);
+#else
+    unsigned int sent = 0;
+    for (; sent < count; ++sent)
+    {
+        const ssize_t len = sendmsg(fd, &msgs[sent].msg_hdr, 0);
+        if (0 > len)
+        {
+            break;
+        }
+        msgs[sent].msg_len = static_cast<unsigned int>(len);
+    }
+    return (0 < sent) ? int(sent) : -1;
+#endif // __linux__
+}
+
+/**
+ * @brief   Receives batches of datagrams through recv_datagrams().
+ *          Each slot scatters its datagram between a pooled buffer, which is handed over as the message
+ *          storage, and a tail of its own, which only catches the end of unusually large datagrams and is
+ *          left untouched, thus uncommitted, otherwise. Slots keep their pooled buffer until a datagram is
+ *          received in it.
+ */
+template<typename SockAddr>
+class DatagramReceiver
+{
+public:
+    /**
+     * @param   batch_size  Maximum number of datagrams received at once.
+     * @param   pooled_len  Size of the pooled buffer of each slot.
+     * @param   max_len     Size of the largest datagram.
+     */
+    DatagramReceiver(
+            size_t batch_size,
+            size_t pooled_len,
+            size_t max_len)
+        : pooled_len_(pooled_len)
+        , tail_len_((max_len > pooled_len) ? (max_len - pooled_len) : 0)
+        , buffers_(batch_size)
+        , tails_(new uint8_t[batch_size * tail_len_])
+        , msgs_(batch_size)
+        , iovs_(2 * batch_size)
+        , addrs_(batch_size)
+    {}
+
+    DatagramReceiver(DatagramReceiver&&) = delete;
+    DatagramReceiver(const DatagramReceiver&) = delete;
+    DatagramReceiver& operator=(DatagramReceiver&&) = delete;
+    DatagramReceiver& operator=(const DatagramReceiver&) = delete;
+
+    /**
+     * @brief   Receives the datagrams already queued in the socket, without blocking.
+     * @param   handler Called for each datagram, in order, as handler(BufferPool::Buffer&& buffer, size_t len,
+     *                  const SockAddr& source).
+     * @return  Number of datagrams received, -1 on error, with errno set (EAGAIN if there was none).
+     */
+    template<typename Handler>
+    int receive(
+            int fd,
+            BufferPool& pool,
+            size_t max_count,
+            Handler&& handler)
+    {
+        const size_t count = (max_count < buffers_.size()) ? max_count : buffers_.size();
+        for (size_t i = 0; i < count; ++i)
+        {
+            if (0 == buffers_[i].capacity())
+            {
+                buffers_[i] = pool.acquire(pooled_len_);
+            }
+            iovs_[2 * i].iov_base = buffers_[i].data();
+            iovs_[2 * i].iov_len = buffers_[i].capacity();
+            iovs_[2 * i + 1].iov_base = get_tail(i);
+            iovs_[2 * i + 1].iov_len = tail_len_;
+
+            msgs_[i] = MultiMsgHdr{};
+            msgs_[i].msg_hdr.msg_name = &addrs_[i];
+            msgs_[i].msg_hdr.msg_namelen = sizeof(SockAddr);
+            msgs_[i].msg_hdr.msg_iov = &iovs_[2 * i];
+            msgs_[i].msg_hdr.msg_iovlen = 2;
+        }
+
+        const int received = recv_datagrams(fd, msgs_.data(), unsigned(count));
+        for (int i = 0; i < received; ++i)
+        {
+            const size_t len = msgs_[i].msg_len;
+            BufferPool::Buffer buffer = std::move(buffers_[i]);
+            if (buffer.capacity() < len)
+            {
+                BufferPool::Buffer large_buffer = pool.acquire(len);
+                memcpy(large_buffer.data(), buffer.data(), buffer.capacity());
+                memcpy(large_buffer.data() + buffer.capacity(), get_tail(i), len - buffer.capacity());
+                buffer = std::move(large_buffer);
+            }
+            handler(std::move(buffer), len, addrs_[i]);
+        }
+        return received;
+    }
+
+private:
+    uint8_t* get_tail(
+            size_t slot) const
+    {
+        return tails_.get() + slot * tail_len_;
+    }
+
+private:
+    const size_t pooled_len_;
+    const size_t tail_len_;
+    std::vector<BufferPool::Buffer> buffers_;
+    std::unique_ptr<uint8_t[]> tails_;
+    std::vector<MultiMsgHdr> msgs_;
+    std::vector<iovec> iovs_;
+    std::vector<SockAddr> addrs_;
+};
+
+/**
+ * @brief   Sends batches of datagrams through send_datagrams().
+ *          Each datagram is gathered from a head and an optional payload segment, which are referenced,
+ *          not copied, so they shall outlive the call to send().
+ */
+template<typename SockAddr>
+class DatagramSender
+{
+public:
+    explicit DatagramSender(
+            size_t batch_size)
+        : size_(0)
+        , msgs_(batch_size)
+        , iovs_(2 * batch_size)
+        , addrs_(batch_size)
+    {}
+
+    DatagramSender(DatagramSender&&) = delete;
+    DatagramSender(const DatagramSender&) = delete;
+    DatagramSender& operator=(DatagramSender&&) = delete;
+    DatagramSender& operator=(const DatagramSender&) = delete;
+
+    size_t size() const { return size_; }
+
+    bool full() const { return msgs_.size() == size_; }
+
+    void clear() { size_ = 0; }
+
+    /**
+     * @brief   Queues a datagram, the batch shall not be full.
+     */
+    void push(
+            const SockAddr& destination,
+            const uint8_t* head,
+            size_t head_len,
+            const uint8_t* payload,
+            size_t payload_len)
+    {
+        const size_t i = size_++;
+        addrs_[i] = destination;
+        iovs_[2 * i].iov_base = const_cast<uint8_t*>(head);
+        iovs_[2 * i].iov_len = head_len;
+        iovs_[2 * i + 1].iov_base = const_cast<uint8_t*>(payload);
+        iovs_[2 * i + 1].iov_len = payload_len;
+
+        msgs_[i] = MultiMsgHdr{};
+        msgs_[i].msg_hdr.msg_name = &addrs_[i];
+        msgs_[i].msg_hdr.msg_namelen = sizeof(SockAddr);
+        msgs_[i].msg_hdr.msg_iov = &iovs_[2 * i];
+        msgs_[i].msg_hdr.msg_iovlen = 2;
+    }
+
+    /**
+     * @brief   Sends the queued datagrams from the given one on.
+     *          The kernel may stop before the last one, so it shall be called again from the first unsent.
+     * @return  Number of datagrams sent, -1 on error, with errno set.
+     */
+    int send(
+            int fd,
+            size_t first)
+    {
+        return send_datagrams(fd, msgs_.data() + first, unsigned(size_ - first));
+    }
+
+    /**
+     * @brief   Tells whether a sent datagram went out whole.
+     */
+    bool is_complete(
+            size_t index) const
+    {
+        return msgs_[index].msg_len == (iovs_[2 * index].iov_len + iovs_[2 * index + 1].iov_len);
+    }
+
+private:
+    size_t size_;
+    std::vector<MultiMsgHdr> msgs_;
+    std::vector<iovec> iovs_;
+    std::vector<SockAddr> addrs_;
+};
+
+} // namespace util
+} // namespace uxr
+} // namespace eprosima
+
+#endif // UXR_AGENT_TRANSPORT_UTIL_DATAGRAMBATCHLINUX_HPP_
@@ -0,0 +1,348 @@
+// Copyright 2018 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef UXR_AGENT_TRANSPORT_UTIL_REACTORLINUX_HPP_
+#define UXR_AGENT_TRANSPORT_UTIL_REACTORLINUX_HPP_
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+#include <array>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+
+namespace eprosima {
+namespace uxr {
+namespace util {
+
+/**
+ * @brief   epoll based event loop.
+ *          File descriptors are registered together with a readiness callback, which is invoked from
+ *          run_once() with the epoll events reported for the descriptor. Periodic timers are backed by
+ *          timerfd and an eventfd allows other threads to interrupt a blocked run_once().
+ */
+class Reactor
+{
+public:
+    using Callback = std::function<void(uint32_t events)>;
+
+    Reactor()
+        : epoll_fd_(-1)
+        , wakeup_fd_(-1)
+        , callbacks_()
+        , timer_fds_()
+        , mtx_()
+    {}
+
+    ~Reactor()
+    {
+        fini();
+    }
+
+    Reactor(Reactor&&) = delete;
+    Reactor(const Reactor&) = delete;
+    Reactor& operator=(Reactor&&) = delete;
+    Reactor& operator=(const Reactor&) = delete;
+
+    /**
+     * @brief   Creates the epoll instance and the wakeup eventfd.
+     * @return  true in case of success, false in other case.
+     */
+    bool init();
+
+    /**
+     * @brief   Closes the epoll instance, the wakeup eventfd and the timers.
+     *          Registered descriptors are not closed, they belong to the caller.
+     */
+    void fini();
+
+    /**
+     * @brief   Registers a descriptor.
+     * @param   fd          File descriptor.
+     * @param   events      epoll events of interest (e.g. EPOLLIN).
+     * @param   callback    Function called from run_once() when the descriptor is ready.
+     * @return  true in case of success, false in other case.
+     */
+    bool add(
+            int fd,
+            uint32_t events,
+            Callback callback);
+
+    bool modify(
+            int fd,
+            uint32_t events);
+
+    bool remove(
+            int fd);
+
+    /**
+     * @brief   Unregisters every descriptor added through add(), timers are kept.
+     */
+    void clear();
+
+    /**
+     * @brief   Adds a periodic timer.
+     * @param   period      Timer period.
+     * @param   callback    Function called from run_once() on each expiration.
+     * @return  true in case of success, false in other case.
+     */
+    bool add_timer(
+            std::chrono::milliseconds period,
+            std::function<void()> callback);
+
+    /**
+     * @brief   Interrupts a blocked run_once(). It may be called from any thread.
+     */
+    void wakeup();
+
+    /**
+     * @brief   Waits for readiness events and dispatches them.
+     * @param   timeout Maximum waiting time in milliseconds, -1 to wait indefinitely.
+     * @return  Number of dispatched events, 0 on timeout or wakeup, -1 on error.
+     */
+    int run_once(
+            int timeout);
+
+private:
+    static constexpr size_t MAX_EVENTS = 32;
+
+    int epoll_fd_;
+    int wakeup_fd_;
+    std::map<int, Callback> callbacks_;
+    std::map<int, std::function<void()>> timer_fds_;
+    std::mutex mtx_;
+};
+
+inline bool Reactor::init()
+{
+    std::lock_guard<std::mutex> lock(mtx_);
+    if (-1 != epoll_fd_)
+    {
+        return true;
+    }
+
+    epoll_fd_ = epoll_create1(EPOLL_CLOEXEC);
+    if (-1 == epoll_fd_)
+    {
+        return false;
+    }
+
+    wakeup_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    struct epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.fd = wakeup_fd_;
+    if ((-1 == wakeup_fd_) || (-1 == epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, wakeup_fd_, &event)))
+    {
+        if (-1 != wakeup_fd_)
+        {
+            ::close(wakeup_fd_);
+            wakeup_fd_ = -1;
+        }
+        ::close(epoll_fd_);
+        epoll_fd_ = -1;
+        return false;
+    }
+    return true;
+}
+
+inline void Reactor::fini()
+{
+    std::lock_guard<std::mutex> lock(mtx_);
+    for (const auto& timer : timer_fds_)
+    {
+        ::close(timer.first);
+    }
+    timer_fds_.clear();
+    callbacks_.clear();
+    if (-1 != wakeup_fd_)
+    {
+        ::close(wakeup_fd_);
+        wakeup_fd_ = -1;
+    }
+    if (-1 != epoll_fd_)
+    {
+        ::close(epoll_fd_);
+        epoll_fd_ = -1;
+    }
+}
+
+inline bool Reactor::add(
+        int fd,
+        uint32_t events,
+        Callback callback)
+{
+    std::lock_guard<std::mutex> lock(mtx_);
+    struct epoll_event event{};
+    event.events = events;
+    event.data.fd = fd;
+    if ((-1 == epoll_fd_) || (-1 == epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &event)))
+    {
+        return false;
+    }
+    callbacks_[fd] = std::move(callback);
+    return true;
+}
+
+inline bool Reactor::modify(
+        int fd,
+        uint32_t events)
+{
+    std::lock_guard<std::mutex> lock(mtx_);
+    struct epoll_event event{};
+    event.events = events;
+    event.data.fd = fd;
+    return (-1 != epoll_fd_) && (0 == epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, fd, &event));
+}
+
+inline bool Reactor::remove(
+        int fd)
+{
+    std::lock_guard<std::mutex> lock(mtx_);
+    if (0 == callbacks_.erase(fd))
+    {
+        return false;
+    }
+    /* The descriptor may have been closed already, which removes it from the epoll set. */
+    epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, fd, nullptr);
+    return true;
+}
+
+inline void Reactor::clear()
+{
+    std::lock_guard<std::mutex> lock(mtx_);
+    for (const auto& callback : callbacks_)
+    {
+        epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, callback.first, nullptr);
+    }
+    callbacks_.clear();
+}
+
+inline bool Reactor::add_timer(
+        std::chrono::milliseconds period,
+        std::function<void()> callback)
+{
+    std::lock_guard<std::mutex> lock(mtx_);
+    if ((-1 == epoll_fd_) || (0 >= period.count()))
+    {
+        return false;
+    }
+
+    int timer_fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if (-1 == timer_fd)
+    {
+        return false;
+    }
+
+    struct itimerspec spec{};
+    spec.it_interval.tv_sec = time_t(period.count() / 1000);
+    spec.it_interval.tv_nsec = long((period.count() % 1000) * 1000000);
+    spec.it_value = spec.it_interval;
+
+    struct epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.fd = timer_fd;
+    if ((-1 == timerfd_settime(timer_fd, 0, &spec, nullptr)) ||
+        (-1 == epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, timer_fd, &event)))
+    {
+        ::close(timer_fd);
+        return false;
+    }
+    timer_fds_[timer_fd] = std::move(callback);
+    return true;
+}
+
+inline void Reactor::wakeup()
+{
+    uint64_t value = 1;
+    if (-1 != wakeup_fd_)
+    {
+        ssize_t rv = ::write(wakeup_fd_, &value, sizeof(value));
+        (void) rv;
+    }
+}
+
+inline int Reactor::run_once(
+        int timeout)
+{
+    std::array<struct epoll_event, MAX_EVENTS> events;
+    int events_count = epoll_wait(epoll_fd_, events.data(), int(events.size()), timeout);
+    if (-1 == events_count)
+    {
+        return (EINTR == errno) ? 0 : -1;
+    }
+
+    int dispatched = 0;
+    for (int i = 0; i < events_count; ++i)
+    {
+        const int fd = events[size_t(i)].data.fd;
+        if (fd == wakeup_fd_)
+        {
+            uint64_t value;
+            ssize_t rv = ::read(wakeup_fd_, &value, sizeof(value));
+            (void) rv;
+            continue;
+        }
+
+        /*
+         * Callbacks are copied out of the lock, so they are allowed to add or remove descriptors,
+         * and a descriptor removed by a previous callback of this round is skipped.
+         */
+        Callback callback;
+        std::function<void()> timer_callback;
+        {
+            std::lock_guard<std::mutex> lock(mtx_);
+            auto it = callbacks_.find(fd);
+            if (it != callbacks_.end())
+            {
+                callback = it->second;
+            }
+            else
+            {
+                auto timer_it = timer_fds_.find(fd);
+                if (timer_it != timer_fds_.end())
+                {
+                    timer_callback = timer_it->second;
+                }
+            }
+        }
+
+        if (callback)
+        {
+            callback(events[size_t(i)].events);
+            ++dispatched;
+        }
+        else if (timer_callback)
+        {
+            uint64_t expirations;
+            if (sizeof(expirations) == ::read(fd, &expirations, sizeof(expirations)))
+            {
+                timer_callback();
+                ++dispatched;
+            }
+        }
+    }
+    return dispatched;
+}
+
+} // namespace util
+} // namespace uxr
+} // namespace eprosima
+
+#endif // UXR_AGENT_TRANSPORT_UTIL_REACTORLINUX_HPP_
@@ -17,6 +17,7 @@
 
 #include <fastrtps/TopicDataType.h>
 
+#include <cstddef>
 #include <vector>
 
 using namespace eprosima::fastrtps;
@@ -26,7 +27,43 @@ namespace uxr {
 class TopicPubSubType: public TopicDataType
 {
 public:
-    typedef std::vector<unsigned char> type;
+    /*
+     * Sample representation, used by every method of the type. Read samples own their serialized bytes,
+     * while written samples may just reference them, e.g. within an input message, so they are copied
+     * straight into the payload.
+     */
+    class type
+    {
+    public:
+        type() = default;
+
+        type(
+                const unsigned char* data,
+                size_t size)
+            : view_data_(data)
+            , view_size_(size)
+        {}
+
+        const unsigned char* data() const { return (nullptr != view_data_) ? view_data_ : buffer_.data(); }
+
+        size_t size() const { return (nullptr != view_data_) ? view_size_ : buffer_.size(); }
+
+        void assign(
+                const unsigned char* first,
+                const unsigned char* last)
+        {
+            buffer_.assign(first, last);
+            view_data_ = nullptr;
+            view_size_ = 0;
+        }
+
+        std::vector<unsigned char>& buffer() { return buffer_; }
+
+    private:
+        std::vector<unsigned char> buffer_;
+        const unsigned char* view_data_ = nullptr;
+        size_t view_size_ = 0;
+    };
 
     explicit TopicPubSubType(bool with_key);
     ~TopicPubSubType() override = default;
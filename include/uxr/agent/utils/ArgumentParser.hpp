@@ -23,6 +23,7 @@
 #include <unordered_map>
 #include <uxr/agent/transport/Server.hpp>
 #include <uxr/agent/config.hpp>
+#include <uxr/agent/utils/ThreadPolicy.hpp>
 
 #ifdef _WIN32
 #include <uxr/agent/transport/udp/UDPv4AgentWindows.hpp>
@@ -469,6 +470,14 @@ public:
         , refs_("-r", "--refs")
         , verbose_("-v", "--verbose", static_cast<uint16_t>(DEFAULT_VERBOSE_LEVEL),
             {0, 1, 2, 3, 4, 5, 6})
+        , processing_threads_("-t", "--processing-threads", static_cast<uint16_t>(1), {}, false)
+        , linger_("-L", "--linger", static_cast<uint16_t>(0), {}, false)
+        , ack_delay_("-a", "--ack-delay", static_cast<uint16_t>(ACKNACK_DELAY), {}, false)
+        , ack_count_("-n", "--ack-count", static_cast<uint16_t>(ACKNACK_MAX_PENDING), {}, false)
+#ifndef _WIN32
+        , reactor_("-R", "--reactor", ArgumentKind::NO_VALUE)
+        , thread_policy_("-T", "--thread-policy")
+#endif
 #ifdef UAGENT_DISCOVERY_PROFILE
         , discovery_("-d", "--discovery", static_cast<uint16_t>(DEFAULT_DISCOVERY_PORT), {}, false)
 #endif
@@ -528,6 +537,53 @@ public:
             result.first = false;
             return result;
         }
+        if (ParseResult::INVALID == processing_threads_.parse_argument(argc, argv))
+        {
+            result.first = false;
+            return result;
+        }
+        if (ParseResult::INVALID == linger_.parse_argument(argc, argv))
+        {
+            result.first = false;
+            return result;
+        }
+        if (ParseResult::INVALID == ack_delay_.parse_argument(argc, argv))
+        {
+            result.first = false;
+            return result;
+        }
+        if (ParseResult::INVALID == ack_count_.parse_argument(argc, argv))
+        {
+            result.first = false;
+            return result;
+        }
+#ifndef _WIN32
+        if (ParseResult::INVALID == reactor_.parse_argument(argc, argv))
+        {
+            result.first = false;
+            return result;
+        }
+        ParseResult thread_policy_arg = thread_policy_.parse_argument(argc, argv);
+        if (ParseResult::VALID == thread_policy_arg)
+        {
+            /* The value is either a policy file or a list of policy entries. */
+            struct stat sb;
+            bool thread_policy_loaded = (0 == stat(thread_policy_.value().c_str(), &sb))
+                ? eprosima::uxr::utils::ThreadPolicies::instance().load_file(thread_policy_.value())
+                : eprosima::uxr::utils::ThreadPolicies::instance().parse(thread_policy_.value());
+            if (!thread_policy_loaded)
+            {
+                std::cerr << "Error: invalid thread policy '" << thread_policy_.value() << "'" << std::endl;
+                result.first = false;
+                return result;
+            }
+        }
+        else if (ParseResult::INVALID == thread_policy_arg)
+        {
+            result.first = false;
+            return result;
+        }
+#endif
 #ifdef UAGENT_DISCOVERY_PROFILE
         if (ParseResult::INVALID == discovery_.parse_argument(argc, argv))
         {
@@ -545,6 +601,44 @@ public:
         return result;
     }
 
+    void apply_init_actions(
+            std::unique_ptr<AgentType>& server)
+    {
+        if (processing_threads_.found())
+        {
+            if (!server->set_processing_threads(processing_threads_.value()))
+            {
+                UXR_AGENT_LOG_WARN(
+                        UXR_DECORATE_YELLOW("processing threads error"),
+                        "invalid number of threads: {}",
+                        processing_threads_.value());
+            }
+        }
+        if (linger_.found())
+        {
+            server->set_output_linger(std::chrono::milliseconds(linger_.value()));
+        }
+        if (ack_delay_.found() || ack_count_.found())
+        {
+            if (!server->set_acknack_policy(ack_count_.value(), std::chrono::milliseconds(ack_delay_.value())))
+            {
+                UXR_AGENT_LOG_WARN(
+                        UXR_DECORATE_YELLOW("acknack policy error"),
+                        "invalid number of messages: {}",
+                        ack_count_.value());
+            }
+        }
+#ifndef _WIN32
+        if (reactor_.found() && !server->set_reactor_mode(true))
+        {
+            UXR_AGENT_LOG_WARN(
+                    UXR_DECORATE_YELLOW("reactor mode error"),
+                    "not available on this platform",
+                    "");
+        }
+#endif
+    }
+
     void apply_actions(
             std::unique_ptr<AgentType>& server)
     {
@@ -597,6 +691,14 @@ public:
         ss << "    " << middleware_.get_help() << std::endl;
         ss << "    " << refs_.get_help() << std::endl;
         ss << "    " << verbose_.get_help() << std::endl;
+        ss << "    " << processing_threads_.get_help() << std::endl;
+        ss << "    " << linger_.get_help() << std::endl;
+        ss << "    " << ack_delay_.get_help() << std::endl;
+        ss << "    " << ack_count_.get_help() << std::endl;
+#ifndef _WIN32
+        ss << "    " << reactor_.get_help() << std::endl;
+        ss << "    " << thread_policy_.get_help() << std::endl;
+#endif
 #ifdef UAGENT_DISCOVERY_PROFILE
         ss << "    " << discovery_.get_help() << std::endl;
 #endif
@@ -611,6 +713,14 @@ private:
     Argument<std::string> middleware_;
     Argument<std::string> refs_;
     Argument<uint8_t> verbose_;
+    Argument<uint16_t> processing_threads_;
+    Argument<uint16_t> linger_;
+    Argument<uint16_t> ack_delay_;
+    Argument<uint16_t> ack_count_;
+#ifndef _WIN32
+    Argument<dummy_type> reactor_;
+    Argument<std::string> thread_policy_;
+#endif
 #ifdef UAGENT_DISCOVERY_PROFILE
     Argument<uint16_t> discovery_;
 #endif
@@ -1016,6 +1126,7 @@ public:
     bool launch_agent()
     {
         agent_server_.reset(new AgentType(ip_args_.port(), utils::get_mw_kind(common_args_.middleware())));
+        common_args_.apply_init_actions(agent_server_);
         if (agent_server_->start())
         {
             common_args_.apply_actions(agent_server_);
@@ -1127,6 +1238,7 @@ template<> inline bool ArgumentParser<TermiosAgent>::launch_agent()
     agent_server_.reset(new TermiosAgent(
         serial_args_.dev().c_str(),  O_RDWR | O_NOCTTY, attr, 0, utils::get_mw_kind(common_args_.middleware())));
 
+    common_args_.apply_init_actions(agent_server_);
     if (agent_server_->start())
     {
         common_args_.apply_actions(agent_server_);
@@ -1147,6 +1259,7 @@ template<> inline bool ArgumentParser<MultiTermiosAgent>::launch_agent()
     agent_server_.reset(new MultiTermiosAgent(
         multiserial_args_.devs(),  O_RDWR | O_NOCTTY, attr, 0, utils::get_mw_kind(common_args_.middleware())));
 
+    common_args_.apply_init_actions(agent_server_);
     if (agent_server_->start())
     {
         common_args_.apply_actions(agent_server_);
@@ -1164,6 +1277,7 @@ template<> inline bool ArgumentParser<PseudoTerminalAgent>::launch_agent()
 {
     agent_server_.reset(new PseudoTerminalAgent(
             O_RDWR | O_NOCTTY, pseudoterminal_args_.baud_rate().c_str(), 0, utils::get_mw_kind(common_args_.middleware())));
+    common_args_.apply_init_actions(agent_server_);
     if (agent_server_->start())
     {
         common_args_.apply_actions(agent_server_);
@@ -1183,6 +1297,7 @@ template<> inline bool ArgumentParser<CanAgent>::launch_agent()
     uint32_t can_id = strtoul(can_args_.can_id().c_str(), NULL, 16);
     agent_server_.reset(new CanAgent(
             can_args_.dev().c_str(), can_id, utils::get_mw_kind(common_args_.middleware())));
+    common_args_.apply_init_actions(agent_server_);
     if (agent_server_->start())
     {
         common_args_.apply_actions(agent_server_);
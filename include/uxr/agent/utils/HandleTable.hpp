@@ -0,0 +1,140 @@
+// Copyright 2018 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef UXR_AGENT_UTILS_HANDLETABLE_HPP_
+#define UXR_AGENT_UTILS_HANDLETABLE_HPP_
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace eprosima {
+namespace uxr {
+namespace utils {
+
+/**
+ * @brief   Flat table of shared handles indexed by a 12-bit identifier, readable without locks.
+ *          Slots are grouped in chunks, allocated on the first handle set in them and kept until the
+ *          table is destroyed, so a reader never sees a chunk go away. Handles are published and read
+ *          through the atomic shared_ptr operations, and a handle removed from the table is reclaimed
+ *          once its last reader drops it.
+ *          Writers shall be serialized by the caller.
+ */
+template<typename T>
+class HandleTable
+{
+public:
+    static constexpr size_t CAPACITY = size_t(1) << 12;
+
+    HandleTable()
+    {
+        for (auto& chunk : chunks_)
+        {
+            chunk.store(nullptr, std::memory_order_relaxed);
+        }
+    }
+
+    ~HandleTable()
+    {
+        for (auto& chunk : chunks_)
+        {
+            delete chunk.load(std::memory_order_relaxed);
+        }
+    }
+
+    HandleTable(HandleTable&&) = delete;
+    HandleTable(const HandleTable&) = delete;
+    HandleTable& operator=(HandleTable&&) = delete;
+    HandleTable& operator=(const HandleTable&) = delete;
+
+    std::shared_ptr<T> get(
+            uint16_t index) const
+    {
+        std::shared_ptr<T> handle;
+        if (CAPACITY > index)
+        {
+            const Chunk* chunk = chunks_[index / CHUNK_SIZE].load(std::memory_order_acquire);
+            if (nullptr != chunk)
+            {
+                handle = std::atomic_load(&chunk->slots[index % CHUNK_SIZE]);
+            }
+        }
+        return handle;
+    }
+
+    void set(
+            uint16_t index,
+            std::shared_ptr<T> handle)
+    {
+        if (CAPACITY > index)
+        {
+            Chunk* chunk = chunks_[index / CHUNK_SIZE].load(std::memory_order_relaxed);
+            if (nullptr == chunk)
+            {
+                if (!handle)
+                {
+                    return;
+                }
+                chunk = new Chunk();
+                chunks_[index / CHUNK_SIZE].store(chunk, std::memory_order_release);
+            }
+            std::atomic_store(&chunk->slots[index % CHUNK_SIZE], std::move(handle));
+        }
+    }
+
+    void erase(
+            uint16_t index)
+    {
+        set(index, std::shared_ptr<T>());
+    }
+
+    void clear()
+    {
+        for (auto& chunk_ptr : chunks_)
+        {
+            Chunk* chunk = chunk_ptr.load(std::memory_order_relaxed);
+            if (nullptr != chunk)
+            {
+                for (auto& slot : chunk->slots)
+                {
+                    std::atomic_store(&slot, std::shared_ptr<T>());
+                }
+            }
+        }
+    }
+
+private:
+    static constexpr size_t CHUNK_SIZE = 64;
+
+    struct Chunk
+    {
+        std::array<std::shared_ptr<T>, CHUNK_SIZE> slots;
+    };
+
+    std::array<std::atomic<Chunk*>, CAPACITY / CHUNK_SIZE> chunks_;
+};
+
+template<typename T>
+constexpr size_t HandleTable<T>::CAPACITY;
+
+template<typename T>
+constexpr size_t HandleTable<T>::CHUNK_SIZE;
+
+} // namespace utils
+} // namespace uxr
+} // namespace eprosima
+
+#endif // UXR_AGENT_UTILS_HANDLETABLE_HPP_
@@ -0,0 +1,136 @@
+// Copyright 2018 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef UXR_AGENT_UTILS_RATELIMITER_HPP_
+#define UXR_AGENT_UTILS_RATELIMITER_HPP_
+
+#include <chrono>
+#include <cstddef>
+#include <iterator>
+#include <map>
+#include <mutex>
+
+namespace eprosima {
+namespace uxr {
+namespace utils {
+
+/**
+ * @brief   Per-source rate limiter, a token bucket for each source kept as the time its bucket is full again
+ *          (generic cell rate algorithm), so an event costs a lookup and an addition.
+ *          Sources whose bucket is full are forgotten once the table reaches its maximum size, and while it
+ *          stays full the untracked sources share a single bucket, which bounds a flood from many sources.
+ *          A rate of 0 disables the limiter.
+ */
+template<typename Key>
+class RateLimiter
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @param   rate        Events accepted per second from each source.
+     * @param   burst       Events a source may send back to back after being idle.
+     * @param   max_sources Maximum number of tracked sources.
+     */
+    RateLimiter(
+            size_t rate,
+            size_t burst,
+            size_t max_sources)
+        : interval_((0 == rate) ? Clock::duration::zero() : Clock::duration(std::chrono::seconds(1)) / Clock::rep(rate))
+        , tolerance_(interval_ * Clock::rep((1 < burst) ? (burst - 1) : 0))
+        , max_sources_(max_sources)
+        , sources_{}
+        , shared_{}
+        , next_prune_{}
+    {}
+
+    RateLimiter(RateLimiter&&) = delete;
+    RateLimiter(const RateLimiter&) = delete;
+    RateLimiter& operator=(RateLimiter&&) = delete;
+    RateLimiter& operator=(const RateLimiter&) = delete;
+
+    /**
+     * @brief   Accounts an event from a source.
+     * @return  false if the source exceeds its rate, and the event shall be dropped.
+     */
+    bool allow(
+            const Key& source,
+            Clock::time_point now = Clock::now())
+    {
+        if (Clock::duration::zero() == interval_)
+        {
+            return true;
+        }
+
+        std::lock_guard<std::mutex> lock(mtx_);
+        Clock::time_point* full_time = &shared_;
+        auto it = sources_.find(source);
+        if (sources_.end() != it)
+        {
+            full_time = &it->second;
+        }
+        else
+        {
+            if ((max_sources_ <= sources_.size()) && (next_prune_ <= now))
+            {
+                prune(now);
+            }
+            if (max_sources_ > sources_.size())
+            {
+                full_time = &sources_.emplace(source, now).first->second;
+            }
+        }
+
+        const Clock::time_point start = (*full_time > now) ? *full_time : now;
+        if (start - now > tolerance_)
+        {
+            return false;
+        }
+        *full_time = start + interval_;
+        return true;
+    }
+
+    size_t size() const
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        return sources_.size();
+    }
+
+private:
+    void prune(
+            Clock::time_point now)
+    {
+        for (auto it = sources_.begin(); it != sources_.end();)
+        {
+            it = (it->second <= now) ? sources_.erase(it) : std::next(it);
+        }
+        /* Sweeps are spaced by the time an empty bucket takes to refill, bounding their cost under a flood. */
+        next_prune_ = now + tolerance_ + interval_;
+    }
+
+private:
+    const Clock::duration interval_;
+    const Clock::duration tolerance_;
+    const size_t max_sources_;
+    mutable std::mutex mtx_;
+    std::map<Key, Clock::time_point> sources_;
+    Clock::time_point shared_;
+    Clock::time_point next_prune_;
+};
+
+} // namespace utils
+} // namespace uxr
+} // namespace eprosima
+
+#endif // UXR_AGENT_UTILS_RATELIMITER_HPP_
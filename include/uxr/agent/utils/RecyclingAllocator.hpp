@@ -0,0 +1,112 @@
+// Copyright 2018 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef UXR_AGENT_UTILS_RECYCLINGALLOCATOR_HPP_
+#define UXR_AGENT_UTILS_RECYCLINGALLOCATOR_HPP_
+
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace eprosima {
+namespace uxr {
+namespace utils {
+
+/**
+ * @brief   Allocator which recycles the storage of single objects through a process-wide free list per type.
+ *          Combined with std::allocate_shared, an object and its reference count live in one recycled block.
+ *          The free lists are never destroyed, so objects released during the static destruction can still
+ *          give their storage back.
+ */
+template<typename T>
+class RecyclingAllocator
+{
+public:
+    using value_type = T;
+
+    static constexpr size_t MAX_CACHED_BLOCKS = 1024;
+
+    RecyclingAllocator() = default;
+
+    template<typename U>
+    RecyclingAllocator(
+            const RecyclingAllocator<U>&)
+    {}
+
+    T* allocate(
+            size_t n)
+    {
+        if (1 == n)
+        {
+            FreeList& free_list = get_free_list();
+            std::lock_guard<std::mutex> lock(free_list.mtx);
+            if (!free_list.blocks.empty())
+            {
+                void* block = free_list.blocks.back();
+                free_list.blocks.pop_back();
+                return static_cast<T*>(block);
+            }
+        }
+        return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+
+    void deallocate(
+            T* ptr,
+            size_t n)
+    {
+        if (1 == n)
+        {
+            FreeList& free_list = get_free_list();
+            std::lock_guard<std::mutex> lock(free_list.mtx);
+            if (free_list.blocks.size() < MAX_CACHED_BLOCKS)
+            {
+                if (free_list.blocks.capacity() == free_list.blocks.size())
+                {
+                    free_list.blocks.reserve(MAX_CACHED_BLOCKS);
+                }
+                free_list.blocks.push_back(ptr);
+                return;
+            }
+        }
+        ::operator delete(ptr);
+    }
+
+    template<typename U>
+    bool operator==(
+            const RecyclingAllocator<U>&) const { return true; }
+
+    template<typename U>
+    bool operator!=(
+            const RecyclingAllocator<U>&) const { return false; }
+
+private:
+    struct FreeList
+    {
+        std::mutex mtx;
+        std::vector<void*> blocks;
+    };
+
+    static FreeList& get_free_list()
+    {
+        static FreeList* free_list = new FreeList();
+        return *free_list;
+    }
+};
+
+} // namespace utils
+} // namespace uxr
+} // namespace eprosima
+
+#endif // UXR_AGENT_UTILS_RECYCLINGALLOCATOR_HPP_
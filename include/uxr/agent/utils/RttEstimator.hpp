@@ -0,0 +1,110 @@
+// Copyright 2018 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef UXR_AGENT_UTILS_RTTESTIMATOR_HPP_
+#define UXR_AGENT_UTILS_RTTESTIMATOR_HPP_
+
+#include <chrono>
+
+namespace eprosima {
+namespace uxr {
+namespace utils {
+
+/**
+ * @brief   Round-trip time estimator computing a retransmission timeout as described in RFC 6298.
+ *          The smoothed RTT and its variation are updated from each sample with gains of 1/8 and 1/4,
+ *          and the timeout, SRTT + max(G, 4 * RTTVAR), is bounded by [min_rto, max_rto]. Until the first
+ *          sample the timeout is the initial one. Each backoff doubles the timeout, up to max_rto, until
+ *          a new sample is taken.
+ */
+class RttEstimator
+{
+public:
+    using Duration = std::chrono::microseconds;
+
+    /**
+     * @param   initial_rto Timeout used until the first sample.
+     * @param   min_rto     Lower bound of the timeout.
+     * @param   max_rto     Upper bound of the timeout.
+     * @param   granularity Clock granularity G, that is, the resolution of the timers.
+     */
+    RttEstimator(
+            Duration initial_rto,
+            Duration min_rto,
+            Duration max_rto,
+            Duration granularity)
+        : min_rto_(min_rto)
+        , max_rto_(max_rto)
+        , granularity_(granularity)
+        , srtt_(0)
+        , rttvar_(0)
+        , rto_(bound(initial_rto))
+        , has_sample_(false)
+    {}
+
+    void update(
+            Duration sample)
+    {
+        if (!has_sample_)
+        {
+            srtt_ = sample;
+            rttvar_ = sample / 2;
+            has_sample_ = true;
+        }
+        else
+        {
+            const Duration delta = (srtt_ > sample) ? (srtt_ - sample) : (sample - srtt_);
+            rttvar_ = (3 * rttvar_ + delta) / 4;
+            srtt_ = (7 * srtt_ + sample) / 8;
+        }
+        const Duration variation = 4 * rttvar_;
+        rto_ = bound(srtt_ + ((granularity_ > variation) ? granularity_ : variation));
+    }
+
+    void backoff()
+    {
+        rto_ = bound(2 * rto_);
+    }
+
+    bool has_sample() const { return has_sample_; }
+
+    Duration get_srtt() const { return srtt_; }
+
+    Duration get_rttvar() const { return rttvar_; }
+
+    Duration get_rto() const { return rto_; }
+
+private:
+    Duration bound(
+            Duration rto) const
+    {
+        rto = (min_rto_ > rto) ? min_rto_ : rto;
+        return (max_rto_ < rto) ? max_rto_ : rto;
+    }
+
+private:
+    const Duration min_rto_;
+    const Duration max_rto_;
+    const Duration granularity_;
+    Duration srtt_;
+    Duration rttvar_;
+    Duration rto_;
+    bool has_sample_;
+};
+
+} // namespace utils
+} // namespace uxr
+} // namespace eprosima
+
+#endif // UXR_AGENT_UTILS_RTTESTIMATOR_HPP_
@@ -0,0 +1,251 @@
+// Copyright 2018 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef UXR_AGENT_UTILS_SEQNUMRING_HPP_
+#define UXR_AGENT_UTILS_SEQNUMRING_HPP_
+
+#include <uxr/agent/utils/SeqNum.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace eprosima {
+namespace uxr {
+namespace utils {
+
+/**
+ * @brief   Ring of elements indexed by sequence number, with a bitmap of the occupied slots.
+ *          The capacity is a power of two, so a sequence number maps to the slot seq & (capacity - 1)
+ *          consistently across the wrap of the 16-bit sequence numbers. The stored sequence numbers
+ *          shall span no more than the capacity, which is allocated at construction and only changes
+ *          through reserve(). Each slot keeps its sequence number, so a lookup of a sequence number
+ *          outside the stored span misses instead of returning the element aliasing its slot.
+ */
+template<typename T>
+class SeqNumRing
+{
+public:
+    static constexpr size_t MAX_CAPACITY = size_t(1) << 15;
+
+    explicit SeqNumRing(
+            size_t min_capacity)
+        : slots_(get_capacity_for(min_capacity))
+        , seq_nums_(slots_.size(), 0)
+        , presence_((slots_.size() + 63) / 64, 0)
+        , size_(0)
+    {}
+
+    SeqNumRing(SeqNumRing&&) = delete;
+    SeqNumRing(const SeqNumRing&) = delete;
+    SeqNumRing& operator=(SeqNumRing&&) = delete;
+    SeqNumRing& operator=(const SeqNumRing&) = delete;
+
+    /**
+     * @brief   Smallest valid capacity holding the given number of sequence numbers.
+     */
+    static size_t get_capacity_for(
+            size_t min_capacity)
+    {
+        size_t capacity = 1;
+        while ((capacity < min_capacity) && (capacity < MAX_CAPACITY))
+        {
+            capacity <<= 1;
+        }
+        return capacity;
+    }
+
+    size_t capacity() const { return slots_.size(); }
+
+    size_t size() const { return size_; }
+
+    bool empty() const { return 0 == size_; }
+
+    bool contains(
+            SeqNum seq_num) const
+    {
+        return test(get_slot(seq_num), seq_num);
+    }
+
+    T* find(
+            SeqNum seq_num)
+    {
+        const size_t slot = get_slot(seq_num);
+        return test(slot, seq_num) ? &slots_[slot] : nullptr;
+    }
+
+    /**
+     * @brief   Stores an element, unless its slot is already occupied.
+     */
+    bool insert(
+            SeqNum seq_num,
+            T&& element)
+    {
+        const size_t slot = get_slot(seq_num);
+        if (test(slot))
+        {
+            return false;
+        }
+        slots_[slot] = std::move(element);
+        seq_nums_[slot] = uint16_t(seq_num);
+        presence_[slot / 64] |= (uint64_t(1) << (slot % 64));
+        ++size_;
+        return true;
+    }
+
+    /**
+     * @brief   Moves an element out of the ring, freeing its slot.
+     */
+    bool take(
+            SeqNum seq_num,
+            T& element)
+    {
+        const size_t slot = get_slot(seq_num);
+        if (!test(slot, seq_num))
+        {
+            return false;
+        }
+        element = std::move(slots_[slot]);
+        release(slot);
+        return true;
+    }
+
+    void erase(
+            SeqNum seq_num)
+    {
+        const size_t slot = get_slot(seq_num);
+        if (test(slot, seq_num))
+        {
+            release(slot);
+        }
+    }
+
+    void clear()
+    {
+        for (size_t slot = 0; slot < slots_.size(); ++slot)
+        {
+            if (test(slot))
+            {
+                release(slot);
+            }
+        }
+    }
+
+    /**
+     * @brief   Occupancy of consecutive sequence numbers, read from the bitmap a word at a time,
+     *          so they shall lie within the stored span.
+     * @param   first   First sequence number.
+     * @param   count   Number of sequence numbers, up to 64 and up to the capacity.
+     * @return  Bitmap where the bit i is set if first + i is stored.
+     */
+    uint64_t get_presence(
+            SeqNum first,
+            size_t count) const
+    {
+        uint64_t presence = 0;
+        size_t slot = get_slot(first);
+        size_t done = 0;
+        while (done < count)
+        {
+            const size_t bit = slot % 64;
+            size_t len = count - done;
+            len = (len < (64 - bit)) ? len : (64 - bit);
+            len = (len < (slots_.size() - slot)) ? len : (slots_.size() - slot);
+
+            const uint64_t mask = (64 == len) ? ~uint64_t(0) : ((uint64_t(1) << len) - 1);
+            presence |= ((presence_[slot / 64] >> bit) & mask) << done;
+
+            done += len;
+            slot = (slot + len) & (slots_.size() - 1);
+        }
+        return presence;
+    }
+
+    /**
+     * @brief   Grows the ring, if needed, to hold a span of sequence numbers.
+     * @param   first   First stored sequence number, which the elements are moved relative to.
+     * @param   span    Number of sequence numbers to hold from first on.
+     */
+    void reserve(
+            SeqNum first,
+            size_t span)
+    {
+        const size_t capacity = get_capacity_for(span);
+        if (capacity <= slots_.size())
+        {
+            return;
+        }
+
+        std::vector<T> slots(capacity);
+        std::vector<uint16_t> seq_nums(capacity, 0);
+        std::vector<uint64_t> presence((capacity + 63) / 64, 0);
+        for (size_t offset = 0; offset < slots_.size(); ++offset)
+        {
+            const size_t slot = get_slot(SeqNum(uint16_t(uint16_t(first) + offset)));
+            if (test(slot))
+            {
+                const size_t new_slot = seq_nums_[slot] & (capacity - 1);
+                slots[new_slot] = std::move(slots_[slot]);
+                seq_nums[new_slot] = seq_nums_[slot];
+                presence[new_slot / 64] |= (uint64_t(1) << (new_slot % 64));
+            }
+        }
+        slots_.swap(slots);
+        seq_nums_.swap(seq_nums);
+        presence_.swap(presence);
+    }
+
+private:
+    size_t get_slot(
+            SeqNum seq_num) const
+    {
+        return uint16_t(seq_num) & (slots_.size() - 1);
+    }
+
+    bool test(
+            size_t slot) const
+    {
+        return 0 != (presence_[slot / 64] & (uint64_t(1) << (slot % 64)));
+    }
+
+    bool test(
+            size_t slot,
+            SeqNum seq_num) const
+    {
+        return test(slot) && (uint16_t(seq_num) == seq_nums_[slot]);
+    }
+
+    void release(
+            size_t slot)
+    {
+        slots_[slot] = T();
+        presence_[slot / 64] &= ~(uint64_t(1) << (slot % 64));
+        --size_;
+    }
+
+    std::vector<T> slots_;
+    std::vector<uint16_t> seq_nums_;
+    std::vector<uint64_t> presence_;
+    size_t size_;
+};
+
+template<typename T>
+constexpr size_t SeqNumRing<T>::MAX_CAPACITY;
+
+} // namespace utils
+} // namespace uxr
+} // namespace eprosima
+
+#endif // UXR_AGENT_UTILS_SEQNUMRING_HPP_
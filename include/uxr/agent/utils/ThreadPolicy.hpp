@@ -0,0 +1,128 @@
+// Copyright 2018 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef UXR_AGENT_UTILS_THREADPOLICY_HPP_
+#define UXR_AGENT_UTILS_THREADPOLICY_HPP_
+
+#include <uxr/agent/visibility.hpp>
+
+#include <array>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace eprosima {
+namespace uxr {
+namespace utils {
+
+/**
+ * @brief   Kinds of threads spawned by the agent.
+ */
+enum class ThreadRole : uint8_t
+{
+    receiver,
+    sender,
+    processing,
+    heartbeat,
+    error_handler,
+    reactor,
+    reader,
+    internal_client,
+};
+
+constexpr size_t THREAD_ROLE_COUNT = size_t(ThreadRole::internal_client) + 1;
+
+/**
+ * @brief   Placement and scheduling of a thread.
+ *          An empty CPU set keeps the inherited affinity and a priority of 0 keeps the default
+ *          time-sharing scheduling; otherwise the thread runs with SCHED_FIFO at that priority.
+ */
+struct ThreadPolicy
+{
+    std::vector<uint16_t> cpus;
+    int priority = 0;
+};
+
+/**
+ * @brief   Process-wide table of thread policies, one per ThreadRole.
+ *          Each agent thread applies the policy of its role, together with its name, when it starts.
+ *
+ *          Policies are given as entries with the format
+ *              <role>[:cpus=<list>][:fifo=<priority>]
+ *          where <role> is one of receiver, sender, processing, heartbeat, error, reactor, reader
+ *          or p2p, and <list> is a comma separated list of CPUs or CPU ranges (e.g. 0,2-3).
+ *          Several entries are separated by ';' on the command line or by new lines in a file,
+ *          where '#' starts a comment.
+ */
+class ThreadPolicies
+{
+public:
+    UXR_AGENT_EXPORT static ThreadPolicies& instance();
+
+    ThreadPolicies(ThreadPolicies&&) = delete;
+    ThreadPolicies(const ThreadPolicies&) = delete;
+    ThreadPolicies& operator=(ThreadPolicies&&) = delete;
+    ThreadPolicies& operator=(const ThreadPolicies&) = delete;
+
+    UXR_AGENT_EXPORT void set(
+            ThreadRole role,
+            const ThreadPolicy& policy);
+
+    UXR_AGENT_EXPORT ThreadPolicy get(
+            ThreadRole role);
+
+    UXR_AGENT_EXPORT void reset();
+
+    /**
+     * @brief   Parses a list of policy entries and stores them.
+     *          Nothing is stored if any entry is invalid.
+     * @param   spec    Entries separated by ';' or new lines.
+     * @return  true in case of success, false in other case.
+     */
+    UXR_AGENT_EXPORT bool parse(
+            const std::string& spec);
+
+    /**
+     * @brief   Loads the policy entries of a file, one per line.
+     * @param   file_path   Path of the file.
+     * @return  true in case of success, false in other case.
+     */
+    UXR_AGENT_EXPORT bool load_file(
+            const std::string& file_path);
+
+    /**
+     * @brief   Names the calling thread and applies the policy of a role to it.
+     *          The name is truncated to 15 characters, the limit of the platform.
+     * @param   role    Role of the calling thread.
+     * @param   name    Thread name.
+     * @return  true if the whole policy has been applied, false in other case
+     *          (e.g. SCHED_FIFO without the required privileges, or CPU affinity outside Linux).
+     */
+    UXR_AGENT_EXPORT bool apply(
+            ThreadRole role,
+            const std::string& name);
+
+private:
+    ThreadPolicies() = default;
+
+    std::array<ThreadPolicy, THREAD_ROLE_COUNT> policies_;
+    std::mutex mtx_;
+};
+
+} // namespace utils
+} // namespace uxr
+} // namespace eprosima
+
+#endif // UXR_AGENT_UTILS_THREADPOLICY_HPP_
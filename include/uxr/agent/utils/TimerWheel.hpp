@@ -0,0 +1,234 @@
+// Copyright 2017 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef UXR_AGENT_UTILS_TIMERWHEEL_HPP_
+#define UXR_AGENT_UTILS_TIMERWHEEL_HPP_
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace eprosima {
+namespace uxr {
+namespace utils {
+
+/**
+ * @brief   Hierarchical timer wheel keyed by an integer identifier.
+ *          Scheduling, rescheduling and cancelling a key are O(1), and advancing the wheel only
+ *          touches the slots of the elapsed ticks, so the cost does not depend on the number of
+ *          idle keys. Each key has at most one pending expiration.
+ */
+class TimerWheel
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit TimerWheel(
+            std::chrono::milliseconds resolution);
+
+    TimerWheel(TimerWheel&&) = delete;
+    TimerWheel(const TimerWheel&) = delete;
+    TimerWheel& operator=(TimerWheel&&) = delete;
+    TimerWheel& operator=(const TimerWheel&) = delete;
+
+    /**
+     * @brief   Schedules the expiration of a key.
+     * @param   key     Timer identifier.
+     * @param   delay   Time until the expiration, rounded up to the wheel resolution.
+     * @param   replace Whether a pending expiration of the key shall be replaced.
+     * @return  true if the key has been scheduled, false if it was pending and replace is false.
+     */
+    bool schedule(
+            uint64_t key,
+            std::chrono::milliseconds delay,
+            bool replace = true);
+
+    void cancel(
+            uint64_t key);
+
+    bool is_scheduled(
+            uint64_t key);
+
+    size_t size();
+
+    std::chrono::milliseconds get_resolution() const { return resolution_; }
+
+    /**
+     * @brief   Advances the wheel up to a given time point.
+     * @param   now     Current time.
+     * @param   expired Vector where the expired keys are appended.
+     */
+    void advance(
+            Clock::time_point now,
+            std::vector<uint64_t>& expired);
+
+private:
+    static constexpr size_t LEVEL_BITS = 6;
+    static constexpr size_t SLOTS = size_t(1) << LEVEL_BITS;
+    static constexpr size_t SLOT_MASK = SLOTS - 1;
+    static constexpr size_t LEVELS = 3;
+    static constexpr uint64_t MAX_TICKS = uint64_t(1) << (LEVEL_BITS * LEVELS);
+
+    void insert(
+            uint64_t key,
+            uint64_t expiration);
+
+    void cascade(
+            size_t level);
+
+    const std::chrono::milliseconds resolution_;
+    const Clock::time_point start_;
+    uint64_t current_tick_;
+    std::array<std::array<std::vector<uint64_t>, SLOTS>, LEVELS> slots_;
+    std::unordered_map<uint64_t, uint64_t> expirations_;
+    std::mutex mtx_;
+};
+
+inline TimerWheel::TimerWheel(
+        std::chrono::milliseconds resolution)
+    : resolution_((0 < resolution.count()) ? resolution : std::chrono::milliseconds(1))
+    , start_(Clock::now())
+    , current_tick_(0)
+    , slots_()
+    , expirations_()
+    , mtx_()
+{}
+
+inline bool TimerWheel::schedule(
+        uint64_t key,
+        std::chrono::milliseconds delay,
+        bool replace)
+{
+    std::lock_guard<std::mutex> lock(mtx_);
+    auto it = expirations_.find(key);
+    if (!replace && (it != expirations_.end()))
+    {
+        return false;
+    }
+
+    uint64_t ticks = uint64_t((delay + resolution_ - std::chrono::milliseconds(1)) / resolution_);
+    ticks = (0 == ticks) ? 1 : ((MAX_TICKS <= ticks) ? MAX_TICKS - 1 : ticks);
+    uint64_t expiration = current_tick_ + ticks;
+    if (it != expirations_.end())
+    {
+        if (it->second == expiration)
+        {
+            return true;
+        }
+        it->second = expiration;
+    }
+    else
+    {
+        expirations_.emplace(key, expiration);
+    }
+
+    /* Previous slot entries of the key become stale and are discarded when reached. */
+    insert(key, expiration);
+    return true;
+}
+
+inline void TimerWheel::cancel(
+        uint64_t key)
+{
+    std::lock_guard<std::mutex> lock(mtx_);
+    expirations_.erase(key);
+}
+
+inline bool TimerWheel::is_scheduled(
+        uint64_t key)
+{
+    std::lock_guard<std::mutex> lock(mtx_);
+    return expirations_.end() != expirations_.find(key);
+}
+
+inline size_t TimerWheel::size()
+{
+    std::lock_guard<std::mutex> lock(mtx_);
+    return expirations_.size();
+}
+
+inline void TimerWheel::advance(
+        Clock::time_point now,
+        std::vector<uint64_t>& expired)
+{
+    std::lock_guard<std::mutex> lock(mtx_);
+    const uint64_t target_tick = uint64_t((now - start_) / resolution_);
+    while (current_tick_ < target_tick)
+    {
+        ++current_tick_;
+        if (0 == (current_tick_ & SLOT_MASK))
+        {
+            if (0 == ((current_tick_ >> LEVEL_BITS) & SLOT_MASK))
+            {
+                cascade(2);
+            }
+            cascade(1);
+        }
+
+        std::vector<uint64_t>& slot = slots_[0][current_tick_ & SLOT_MASK];
+        for (uint64_t key : slot)
+        {
+            auto it = expirations_.find(key);
+            if ((it != expirations_.end()) && (it->second == current_tick_))
+            {
+                expirations_.erase(it);
+                expired.push_back(key);
+            }
+        }
+        slot.clear();
+    }
+}
+
+inline void TimerWheel::insert(
+        uint64_t key,
+        uint64_t expiration)
+{
+    const uint64_t delta = expiration - current_tick_;
+    if (delta < SLOTS)
+    {
+        slots_[0][expiration & SLOT_MASK].push_back(key);
+    }
+    else if (delta < (SLOTS * SLOTS))
+    {
+        slots_[1][(expiration >> LEVEL_BITS) & SLOT_MASK].push_back(key);
+    }
+    else
+    {
+        slots_[2][(expiration >> (2 * LEVEL_BITS)) & SLOT_MASK].push_back(key);
+    }
+}
+
+inline void TimerWheel::cascade(
+        size_t level)
+{
+    std::vector<uint64_t> keys;
+    keys.swap(slots_[level][(current_tick_ >> (level * LEVEL_BITS)) & SLOT_MASK]);
+    for (uint64_t key : keys)
+    {
+        auto it = expirations_.find(key);
+        if ((it != expirations_.end()) && (it->second >= current_tick_))
+        {
+            insert(key, it->second);
+        }
+    }
+}
+
+} // namespace utils
+} // namespace uxr
+} // namespace eprosima
+
+#endif // UXR_AGENT_UTILS_TIMERWHEEL_HPP_
@@ -535,6 +535,13 @@ void Agent::set_verbose_level(uint8_t verbose_level)
     root_->set_verbose_level(verbose_level);
 }
 
+bool Agent::set_reliable_stream_depth_limits(
+        uint16_t min_depth,
+        uint16_t max_depth)
+{
+    return root_->set_reliable_depth_limits(min_depth, max_depth);
+}
+
 /**********************************************************************************************************************
  * Write Data.
  **********************************************************************************************************************/
@@ -24,16 +24,23 @@
 
 #include <memory>
 #include <chrono>
+#include <cstdlib>
 
 constexpr dds::xrce::XrceVendorId EPROSIMA_VENDOR_ID = {0x01, 0x0F};
 
+/* CLIENT_Representation property carrying the reliable stream depth requested by the client. */
+#define RELIABLE_DEPTH_PROPERTY "uxr_rd"
+
 namespace eprosima {
 namespace uxr {
 
 Root::Root()
     : mtx_(),
+      min_reliable_depth_(1),
+      max_reliable_depth_(RELIABLE_STREAM_MAX_DEPTH),
       clients_(),
-      current_client_()
+      current_client_(),
+      on_create_client_()
 {
     current_client_ = clients_.begin();
 #ifdef UAGENT_LOGGER_PROFILE
@@ -72,6 +79,8 @@ dds::xrce::ResultStatus Root::create_client(
 
     dds::xrce::ResultStatus result_status;
     result_status.status(dds::xrce::STATUS_OK);
+    std::shared_ptr<ProxyClient> created_client;
+    std::function<void (const std::shared_ptr<ProxyClient>&)> on_create_client;
 
     if (client_representation.xrce_cookie() == dds::xrce::XRCE_COOKIE)
     {
@@ -80,24 +89,27 @@ dds::xrce::ResultStatus Root::create_client(
             std::lock_guard<std::mutex> lock(mtx_);
             dds::xrce::ClientKey client_key = client_representation.client_key();
             dds::xrce::SessionId session_id = client_representation.session_id();
-            auto it = clients_.find(client_key);
-            if (it == clients_.end())
+            std::unordered_map<std::string, std::string> client_properties;
+
+            if (client_representation.properties())
             {
-                std::unordered_map<std::string, std::string> client_properties;
-
-                if (client_representation.properties())
-                {   
-                    auto v = *client_representation.properties();
-                    for (auto it_props = v.begin(); it_props != v.end(); ++it_props)
-                    {
-                        client_properties.insert(std::pair<std::string, std::string>(it_props->name(), it_props->value()));
-                    }
+                auto v = *client_representation.properties();
+                for (auto it_props = v.begin(); it_props != v.end(); ++it_props)
+                {
+                    client_properties.insert(std::pair<std::string, std::string>(it_props->name(), it_props->value()));
                 }
+            }
+            const uint16_t reliable_depth = get_reliable_depth(client_properties);
 
+            auto it = clients_.find(client_key);
+            if (it == clients_.end())
+            {
                 std::shared_ptr<ProxyClient> new_client = std::make_shared<ProxyClient>(
                     client_representation,
                     middleware_kind,
-                    std::move(client_properties));
+                    std::move(client_properties),
+                    reliable_depth);
+                created_client = new_client;
                 if (clients_.emplace(client_key, std::move(new_client)).second)
                 {
                     UXR_AGENT_LOG_INFO(
@@ -108,6 +120,7 @@ dds::xrce::ResultStatus Root::create_client(
                 }
                 else
                 {
+                    created_client.reset();
                     result_status.status(dds::xrce::STATUS_ERR_RESOURCES);
 
                     UXR_AGENT_LOG_INFO(
@@ -123,13 +136,17 @@ dds::xrce::ResultStatus Root::create_client(
                 {
                     it->second = std::make_shared<ProxyClient>(
                         client_representation,
-                        middleware_kind);
+                        middleware_kind,
+                        std::move(client_properties),
+                        reliable_depth);
                 }
                 else
                 {
                     client->session().reset();
                 }
+                created_client = it->second;
             }
+            on_create_client = on_create_client_;
         }
         else
         {
@@ -155,9 +172,49 @@ dds::xrce::ResultStatus Root::create_client(
     agent_representation.xrce_version(dds::xrce::XRCE_VERSION);
     agent_representation.xrce_vendor_id(EPROSIMA_VENDOR_ID);
 
+    if (created_client && on_create_client)
+    {
+        on_create_client(created_client);
+    }
+
     return result_status;
 }
 
+bool Root::set_reliable_depth_limits(
+        uint16_t min_depth,
+        uint16_t max_depth)
+{
+    bool rv = false;
+    if ((0 < min_depth) && (min_depth <= max_depth) && (RELIABLE_STREAM_MAX_DEPTH >= max_depth))
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        min_reliable_depth_ = min_depth;
+        max_reliable_depth_ = max_depth;
+        rv = true;
+    }
+    return rv;
+}
+
+/* Shall be called with the mutex locked. */
+uint16_t Root::get_reliable_depth(
+        const std::unordered_map<std::string, std::string>& client_properties) const
+{
+    long depth = RELIABLE_STREAM_DEPTH;
+    auto it = client_properties.find(RELIABLE_DEPTH_PROPERTY);
+    if (client_properties.end() != it)
+    {
+        char* end = nullptr;
+        depth = std::strtol(it->second.c_str(), &end, 10);
+        if (it->second.empty() || ('\0' != *end))
+        {
+            depth = RELIABLE_STREAM_DEPTH;
+        }
+    }
+    depth = (min_reliable_depth_ > depth) ? min_reliable_depth_ : depth;
+    depth = (max_reliable_depth_ < depth) ? max_reliable_depth_ : depth;
+    return uint16_t(depth);
+}
+
 dds::xrce::ResultStatus Root::get_info(dds::xrce::ObjectInfo& agent_info)
 {
     dds::xrce::ResultStatus result_status;
@@ -303,6 +360,13 @@ void Root::set_verbose_level(uint8_t verbose_level)
 #endif
 }
 
+void Root::set_on_create_client(
+        std::function<void (const std::shared_ptr<ProxyClient>&)>&& on_create_client)
+{
+    std::lock_guard<std::mutex> lock(mtx_);
+    on_create_client_ = std::move(on_create_client);
+}
+
 void Root::reset()
 {
     std::lock_guard<std::mutex> lock(mtx_);
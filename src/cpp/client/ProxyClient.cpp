@@ -37,10 +37,12 @@ namespace uxr {
 ProxyClient::ProxyClient(
         const dds::xrce::CLIENT_Representation& representation,
         Middleware::Kind middleware_kind,
-        std::unordered_map<std::string, std::string>&& properties)
+        std::unordered_map<std::string, std::string>&& properties,
+        uint16_t reliable_depth)
     : representation_(representation)
     , objects_()
-    , session_(SessionInfo{representation.client_key(), representation.session_id(), representation.mtu()})
+    , session_(SessionInfo{representation.client_key(), representation.session_id(), representation.mtu()},
+               reliable_depth)
     , state_{State::alive}
     , timestamp_{std::chrono::steady_clock::now()}
     , properties_(std::move(properties))
@@ -219,9 +221,44 @@ std::shared_ptr<XRCEObject> ProxyClient::get_object(const dds::xrce::ObjectId& o
     return object;
 }
 
+std::shared_ptr<DataWriter> ProxyClient::get_datawriter(const dds::xrce::ObjectId& object_id) const
+{
+    return (dds::xrce::OBJK_DATAWRITER == (object_id[1] & 0x0F))
+        ? datawriters_.get(get_handle_index(object_id))
+        : std::shared_ptr<DataWriter>();
+}
+
+std::shared_ptr<DataReader> ProxyClient::get_datareader(const dds::xrce::ObjectId& object_id) const
+{
+    return (dds::xrce::OBJK_DATAREADER == (object_id[1] & 0x0F))
+        ? datareaders_.get(get_handle_index(object_id))
+        : std::shared_ptr<DataReader>();
+}
+
+std::shared_ptr<Requester> ProxyClient::get_requester(const dds::xrce::ObjectId& object_id) const
+{
+    return (dds::xrce::OBJK_REQUESTER == (object_id[1] & 0x0F))
+        ? requesters_.get(get_handle_index(object_id))
+        : std::shared_ptr<Requester>();
+}
+
+std::shared_ptr<Replier> ProxyClient::get_replier(const dds::xrce::ObjectId& object_id) const
+{
+    return (dds::xrce::OBJK_REPLIER == (object_id[1] & 0x0F))
+        ? repliers_.get(get_handle_index(object_id))
+        : std::shared_ptr<Replier>();
+}
+
 void ProxyClient::release()
 {
-    objects_.clear();
+    /* The objects are destroyed once the mutex is released. */
+    XRCEObject::ObjectContainer objects;
+    std::lock_guard<std::mutex> lock(mtx_);
+    datawriters_.clear();
+    datareaders_.clear();
+    requesters_.clear();
+    repliers_.clear();
+    objects.swap(objects_);
 }
 
 Session& ProxyClient::session()
@@ -273,6 +310,11 @@ bool ProxyClient::create_object(
         default:
             break;
     }
+
+    if (rv)
+    {
+        publish_handle(object_id, objects_.at(object_id));
+    }
     return rv;
 }
 
@@ -730,6 +772,7 @@ bool ProxyClient::delete_object_unlock(
     auto it = objects_.find(object_id);
     if (it != objects_.end())
     {
+        publish_handle(object_id, nullptr);
         objects_.erase(object_id);
         UXR_AGENT_LOG_DEBUG(
             UXR_DECORATE_GREEN("object deleted"),
@@ -749,6 +792,37 @@ bool ProxyClient::delete_object_unlock(
     return rv;
 }
 
+/* The kind of an object fixes its type, so the handle is cast without checking it at runtime. */
+void ProxyClient::publish_handle(
+        const dds::xrce::ObjectId& object_id,
+        const std::shared_ptr<XRCEObject>& object)
+{
+    const uint16_t index = get_handle_index(object_id);
+    switch (object_id[1] & 0x0F)
+    {
+        case dds::xrce::OBJK_DATAWRITER:
+            datawriters_.set(index, std::static_pointer_cast<DataWriter>(object));
+            break;
+        case dds::xrce::OBJK_DATAREADER:
+            datareaders_.set(index, std::static_pointer_cast<DataReader>(object));
+            break;
+        case dds::xrce::OBJK_REQUESTER:
+            requesters_.set(index, std::static_pointer_cast<Requester>(object));
+            break;
+        case dds::xrce::OBJK_REPLIER:
+            repliers_.set(index, std::static_pointer_cast<Replier>(object));
+            break;
+        default:
+            break;
+    }
+}
+
+uint16_t ProxyClient::get_handle_index(
+        const dds::xrce::ObjectId& object_id)
+{
+    return uint16_t((uint16_t(object_id[0]) << 4) | (object_id[1] >> 4));
+}
+
 ProxyClient::State ProxyClient::get_state()
 {
     std::lock_guard<std::mutex> lock(state_mtx_);
@@ -120,30 +120,53 @@ bool DataWriter::matched(const dds::xrce::ObjectVariant& new_object_rep) const
 }
 
 bool DataWriter::write(dds::xrce::WRITE_DATA_Payload_Data& write_data)
+{
+    return write(write_data.data().serialized_data().data(), write_data.data().serialized_data().size());
+}
+
+bool DataWriter::write(const std::vector<uint8_t>& data)
 {
     bool rv = false;
-    if (proxy_client_->get_middleware().write_data(get_raw_id(), write_data.data().serialized_data()))
+    if (proxy_client_->get_middleware().write_data(get_raw_id(), data))
     {
         UXR_AGENT_LOG_MESSAGE(
             UXR_DECORATE_YELLOW("[** <<DDS>> **]"),
             get_raw_id(),
-            write_data.data().serialized_data().data(),
-            write_data.data().serialized_data().size());
+            data.data(),
+            data.size());
         rv = true;
     }
     return rv;
 }
 
-bool DataWriter::write(const std::vector<uint8_t>& data)
+size_t DataWriter::write_batch(
+        const Middleware::SampleView* samples,
+        size_t count)
+{
+    size_t rv = proxy_client_->get_middleware().write_data_batch(get_raw_id(), samples, count);
+    for (size_t i = 0; i < rv; ++i)
+    {
+        UXR_AGENT_LOG_MESSAGE(
+            UXR_DECORATE_YELLOW("[** <<DDS>> **]"),
+            get_raw_id(),
+            samples[i].buf,
+            samples[i].len);
+    }
+    return rv;
+}
+
+bool DataWriter::write(
+        const uint8_t* buf,
+        size_t len)
 {
     bool rv = false;
-    if (proxy_client_->get_middleware().write_data(get_raw_id(), data))
+    if (proxy_client_->get_middleware().write_data(get_raw_id(), buf, len))
     {
         UXR_AGENT_LOG_MESSAGE(
             UXR_DECORATE_YELLOW("[** <<DDS>> **]"),
             get_raw_id(),
-            data.data(),
-            data.size());
+            buf,
+            len);
         rv = true;
     }
     return rv;
@@ -14,10 +14,33 @@
 
 #include <uxr/agent/message/InputMessage.hpp>
 #include <uxr/agent/logger/Logger.hpp>
+#include <uxr/agent/utils/RecyclingAllocator.hpp>
 
 namespace eprosima {
 namespace uxr {
 
+void* InputMessage::operator new(
+        std::size_t size)
+{
+    if (sizeof(InputMessage) == size)
+    {
+        return utils::RecyclingAllocator<InputMessage>().allocate(1);
+    }
+    return ::operator new(size);
+}
+
+void InputMessage::operator delete(
+        void* ptr,
+        std::size_t size)
+{
+    if ((nullptr != ptr) && (sizeof(InputMessage) == size))
+    {
+        utils::RecyclingAllocator<InputMessage>().deallocate(static_cast<InputMessage*>(ptr), 1);
+        return;
+    }
+    ::operator delete(ptr);
+}
+
 void InputMessage::log_error()
 {
     UXR_AGENT_LOG_ERROR(
@@ -177,6 +177,31 @@ bool CedGlobalTopic::write(
     return rv;
 }
 
+size_t CedGlobalTopic::write_batch(
+        const Middleware::SampleView* samples,
+        size_t count,
+        WriteAccess write_access,
+        TopicSource topic_src,
+        uint8_t& errcode)
+{
+    size_t rv = 0;
+    if (check_write_access(write_access, topic_src))
+    {
+        std::unique_lock<std::mutex> lock(mtx_);
+        for (; rv < count; ++rv)
+        {
+            size_t index = uint16_t(last_write_ + 1) % history_.size();
+            history_[index].assign(samples[rv].buf, samples[rv].buf + samples[rv].len);
+            srcs_[index] = topic_src;
+            ++last_write_;
+        }
+        lock.unlock();
+        cv_.notify_all();
+        errcode = 0;
+    }
+    return rv;
+}
+
 bool CedGlobalTopic::read(
         std::vector<uint8_t>& data,
         std::chrono::milliseconds timeout,
@@ -303,6 +328,14 @@ bool CedDataWriter::write(
     return topic_->get_global_topic()->write(data, write_access_, topic_src_, errcode);
 }
 
+size_t CedDataWriter::write_batch(
+        const Middleware::SampleView* samples,
+        size_t count,
+        uint8_t& errcode) const
+{
+    return topic_->get_global_topic()->write_batch(samples, count, write_access_, topic_src_, errcode);
+}
+
 /**********************************************************************************************************************
  * CedDataReader
  **********************************************************************************************************************/
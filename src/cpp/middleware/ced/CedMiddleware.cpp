@@ -363,6 +363,21 @@ bool CedMiddleware::write_data(
     return rv;
 }
 
+size_t CedMiddleware::write_data_batch(
+        uint16_t datawriter_id,
+        const SampleView* samples,
+        size_t count)
+{
+    size_t rv = 0;
+    auto it = datawriters_.find(datawriter_id);
+    if (datawriters_.end() != it)
+    {
+        uint8_t errcode;
+        rv = it->second->write_batch(samples, count, errcode);
+    }
+    return rv;
+}
+
 bool CedMiddleware::read_data(
         uint16_t datareader_id,
         std::vector<uint8_t>& data,
@@ -239,14 +239,23 @@ bool FastDataWriter::match(
 bool FastDataWriter::write(
         const std::vector<uint8_t>& data)
 {
-    return impl_->write(&const_cast<std::vector<uint8_t>&>(data));
+    return write(data.data(), data.size());
+}
+
+bool FastDataWriter::write(
+        const uint8_t* buf,
+        size_t len)
+{
+    TopicPubSubType::type sample(buf, len);
+    return impl_->write(&sample);
 }
 
 bool FastDataWriter::write(
         const std::vector<uint8_t>& data,
         fastrtps::rtps::WriteParams& wparams)
 {
-    return impl_->write(&const_cast<std::vector<uint8_t>&>(data), wparams);
+    TopicPubSubType::type sample(data.data(), data.size());
+    return impl_->write(&sample, wparams);
 }
 
 const fastrtps::rtps::GUID_t& FastDataWriter::get_guid() const
@@ -297,7 +306,12 @@ bool FastDataReader::read(
     if (impl_->wait_for_unread_samples(tm))
     {
         fastrtps::SampleInfo_t info;
-        rv = impl_->takeNextData(&data, &info);
+        TopicPubSubType::type sample;
+        rv = impl_->takeNextData(&sample, &info);
+        if (rv)
+        {
+            data.swap(sample.buffer());
+        }
     }
     return rv;
 }
@@ -312,7 +326,12 @@ bool FastDataReader::read(
         {int32_t(timeout.count() / 1000), uint32_t(timeout.count() * 1000000)};
     if (impl_->wait_for_unread_samples(tm))
     {
-        rv = impl_->takeNextData(&data, &info);
+        TopicPubSubType::type sample;
+        rv = impl_->takeNextData(&sample, &info);
+        if (rv)
+        {
+            data.swap(sample.buffer());
+        }
     }
     return rv;
 }
@@ -690,6 +690,23 @@ bool FastMiddleware::write_data(
     return rv;
 }
 
+size_t FastMiddleware::write_data_batch(
+        uint16_t datawriter_id,
+        const SampleView* samples,
+        size_t count)
+{
+    size_t rv = 0;
+    auto it = datawriters_.find(datawriter_id);
+    if (datawriters_.end() != it)
+    {
+        while ((rv < count) && it->second->write(samples[rv].buf, samples[rv].len))
+        {
+            ++rv;
+        }
+    }
+    return rv;
+}
+
 bool FastMiddleware::write_request(
         uint16_t requester_id,
         uint32_t sequence_number,
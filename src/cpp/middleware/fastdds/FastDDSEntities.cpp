@@ -974,7 +974,16 @@ bool FastDDSDataWriter::match_from_bin(const dds::xrce::OBJK_DataWriter_Binary&
 
 bool FastDDSDataWriter::write(const std::vector<uint8_t>& data)
 {
-    return ptr_->write(&const_cast<std::vector<uint8_t>&>(data));
+    return write(data.data(), data.size());
+}
+
+bool FastDDSDataWriter::write(
+        const uint8_t* buf,
+        size_t len)
+{
+    /* The type is not plain, so samples cannot be loaned, but they are serialized straight from the view. */
+    TopicPubSubType::type sample(buf, len);
+    return ptr_->write(&sample);
 }
 
 const fastdds::dds::DataWriter* FastDDSDataWriter::ptr() const
@@ -1113,7 +1122,12 @@ bool FastDDSDataReader::read(
     fastrtps::Duration_t d((long double) timeout.count()/1000.0);
 
     if(ptr_->wait_for_unread_message(d)){
-        rv = ReturnCode_t::RETCODE_OK == ptr_->take_next_sample(&data, &sample_info);
+        TopicPubSubType::type sample;
+        rv = ReturnCode_t::RETCODE_OK == ptr_->take_next_sample(&sample, &sample_info);
+        if (rv)
+        {
+            data.swap(sample.buffer());
+        }
     }
 
     return rv;
@@ -1234,12 +1248,21 @@ bool FastDDSRequester::match(const fastrtps::RequesterAttributes& attrs) const
 bool FastDDSRequester::write(
         uint32_t sequence_number,
         const std::vector<uint8_t>& data)
+{
+    return write(sequence_number, data.data(), data.size());
+}
+
+bool FastDDSRequester::write(
+        uint32_t sequence_number,
+        const uint8_t* buf,
+        size_t len)
 {
     bool rv = true;
     try
     {
         fastrtps::rtps::WriteParams wparams;
-        rv = datawriter_ptr_->write(&const_cast<std::vector<uint8_t>&>(data), wparams);
+        TopicPubSubType::type sample(buf, len);
+        rv = datawriter_ptr_->write(&sample, wparams);
         if (rv)
         {
             int64_t sequence = (int64_t)wparams.sample_identity().sequence_number().high << 32;
@@ -1267,7 +1290,12 @@ bool FastDDSRequester::read(
     fastrtps::Duration_t d((long double) timeout.count()/1000.0);
 
     if(datareader_ptr_->wait_for_unread_message(d)){
-        rv = ReturnCode_t::RETCODE_OK == datareader_ptr_->take_next_sample(&data, &info);
+        TopicPubSubType::type sample;
+        rv = ReturnCode_t::RETCODE_OK == datareader_ptr_->take_next_sample(&sample, &info);
+        if (rv)
+        {
+            data.swap(sample.buffer());
+        }
     }
 
     if (rv)
@@ -1429,7 +1457,14 @@ void FastDDSReplier::transport_sample_identity(
 bool FastDDSReplier::write(
         const std::vector<uint8_t>& data)
 {
-    fastcdr::FastBuffer fastbuffer{reinterpret_cast<char*>(const_cast<uint8_t*>(data.data())), data.size()};
+    return write(data.data(), data.size());
+}
+
+bool FastDDSReplier::write(
+        const uint8_t* buf,
+        size_t len)
+{
+    fastcdr::FastBuffer fastbuffer{reinterpret_cast<char*>(const_cast<uint8_t*>(buf)), len};
     fastcdr::Cdr deserializer(fastbuffer, eprosima::fastcdr::Cdr::DEFAULT_ENDIAN, eprosima::fastcdr::CdrVersion::XCDRv1);
 
     dds::SampleIdentity sample_identity;
@@ -1438,10 +1473,10 @@ bool FastDDSReplier::write(
     fastrtps::rtps::WriteParams wparams;
     transport_sample_identity(sample_identity, wparams.related_sample_identity());
 
-    std::vector<uint8_t> output_data(data.size() - deserializer.get_serialized_data_length());
-    deserializer.deserialize_array(output_data.data(), output_data.size());
-
-    return datawriter_ptr_->write(&const_cast<std::vector<uint8_t>&>(output_data), wparams);
+    /* The reply follows the sample identity, and is written from the same view. */
+    const size_t offset = deserializer.get_serialized_data_length();
+    TopicPubSubType::type sample(buf + offset, len - offset);
+    return datawriter_ptr_->write(&sample, wparams);
 }
 
 void FastDDSReplier::transform_sample_identity(
@@ -1467,14 +1502,15 @@ bool FastDDSReplier::read(
         std::chrono::milliseconds timeout,
         fastdds::dds::SampleInfo& info)
 {
-    std::vector<uint8_t> temp_data;
+    TopicPubSubType::type sample;
+    std::vector<uint8_t>& temp_data = sample.buffer();
 
     bool rv = false;
 
     fastrtps::Duration_t d((long double) timeout.count()/1000.0);
 
     if(datareader_ptr_->wait_for_unread_message(d)){
-        rv = ReturnCode_t::RETCODE_OK == datareader_ptr_->take_next_sample(&temp_data, &info);
+        rv = ReturnCode_t::RETCODE_OK == datareader_ptr_->take_next_sample(&sample, &info);
     }
 
     if (rv)
@@ -901,14 +901,38 @@ bool FastDDSMiddleware::write_data(
         uint16_t datawriter_id,
         const std::vector<uint8_t>& data)
 {
-    for(uint8_t byte : data){
-        std::cout<<static_cast<int>(byte)<<" ";
+    return write_data(datawriter_id, data.data(), data.size());
+}
+
+bool FastDDSMiddleware::write_request(
+        uint16_t requester_id,
+        uint32_t sequence_number,
+        const std::vector<uint8_t>& data)
+{
+    return write_request(requester_id, sequence_number, data.data(), data.size());
+}
+
+bool FastDDSMiddleware::write_reply(
+        uint16_t replier_id,
+        const std::vector<uint8_t>& data)
+{
+    return write_reply(replier_id, data.data(), data.size());
+}
+
+/* Decodes the sample and hands it over to the center queue. */
+static
+void push_to_center(
+        const uint8_t* buf,
+        size_t len)
+{
+    for(size_t i = 0; i < len; ++i){
+        std::cout<<static_cast<int>(buf[i])<<" ";
     }
     std::cout<<std::endl;
-    uint8_t *bufferPtr = const_cast<uint8_t *>(data.data());
+    uint8_t *bufferPtr = const_cast<uint8_t *>(buf);
 
     ucdrBuffer udr;
-    ucdr_init_buffer(&udr,bufferPtr ,data.size());
+    ucdr_init_buffer(&udr,bufferPtr ,len);
 
     student s;
     s.des(udr);
@@ -922,12 +946,42 @@ bool FastDDSMiddleware::write_data(
         //std::lock_guard<std::mutex> lock(agent2center_mtx);
         Agent2CentorQueue::instance().center_read_queue.Push(s);
     }
+}
+
+bool FastDDSMiddleware::write_data(
+        uint16_t datawriter_id,
+        const uint8_t* buf,
+        size_t len)
+{
+   push_to_center(buf, len);
 
    bool rv = false;
    auto it = datawriters_.find(datawriter_id);
    if (datawriters_.end() != it)
    {
-       rv = it->second->write(data);
+       rv = it->second->write(buf, len);
+   }
+   return rv;
+}
+
+size_t FastDDSMiddleware::write_data_batch(
+        uint16_t datawriter_id,
+        const SampleView* samples,
+        size_t count)
+{
+   size_t rv = 0;
+   auto it = datawriters_.find(datawriter_id);
+   if (datawriters_.end() != it)
+   {
+       while (rv < count)
+       {
+           push_to_center(samples[rv].buf, samples[rv].len);
+           if (!it->second->write(samples[rv].buf, samples[rv].len))
+           {
+               break;
+           }
+           ++rv;
+       }
    }
    return rv;
 }
@@ -935,26 +989,28 @@ bool FastDDSMiddleware::write_data(
 bool FastDDSMiddleware::write_request(
         uint16_t requester_id,
         uint32_t sequence_number,
-        const std::vector<uint8_t>& data)
+        const uint8_t* buf,
+        size_t len)
 {
    bool rv = false;
    auto it = requesters_.find(requester_id);
    if (requesters_.end() != it)
    {
-       rv = it->second->write(sequence_number, data);
+       rv = it->second->write(sequence_number, buf, len);
    }
    return rv;
 }
 
 bool FastDDSMiddleware::write_reply(
         uint16_t replier_id,
-        const std::vector<uint8_t>& data)
+        const uint8_t* buf,
+        size_t len)
 {
    bool rv = false;
    auto it = repliers_.find(replier_id);
    if (repliers_.end() != it)
    {
-       rv = it->second->write(data);
+       rv = it->second->write(buf, len);
    }
    return rv;
 }
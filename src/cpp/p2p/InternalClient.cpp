@@ -16,6 +16,7 @@
 #include <uxr/agent/middleware/ced/CedEntities.hpp>
 #include <uxr/agent/Agent.hpp>
 #include <uxr/agent/logger/Logger.hpp>
+#include <uxr/agent/utils/ThreadPolicy.hpp>
 #include <ucdr/microcdr.h>
 
 #include <string>
@@ -359,6 +360,7 @@ void InternalClient::create_topic_entities()
 
 void InternalClient::loop()
 {
+    utils::ThreadPolicies::instance().apply(utils::ThreadRole::internal_client, "uxr-p2p");
 
     while (running_cond_)
     {
@@ -20,6 +20,7 @@
 #include <uxr/agent/Root.hpp>
 #include <uxr/agent/transport/Server.hpp>
 #include <uxr/agent/utils/Time.hpp>
+#include <uxr/agent/config.hpp>
 
 #include <uxr/agent/transport/endpoint/IPv4EndPoint.hpp>
 #include <uxr/agent/transport/endpoint/IPv6EndPoint.hpp>
@@ -28,9 +29,79 @@
 #include <uxr/agent/transport/endpoint/MultiSerialEndPoint.hpp>
 #include <uxr/agent/transport/endpoint/CustomEndPoint.hpp>
 
+#define HEARTBEAT_TICKS_PER_PERIOD 8
+#define OUTPUT_FLUSH_TIMER_FLAG (uint64_t(1) << 40)
+#define ACKNACK_TIMER_FLAG (uint64_t(1) << 41)
+#define WRITE_DATA_BATCH_SIZE 32
+
 namespace eprosima {
 namespace uxr {
 
+/* Timer keys are made of the raw client key and the stream id, STREAMID_NONE is used for liveliness. */
+inline uint64_t heartbeat_timer_key(
+        const dds::xrce::ClientKey& client_key,
+        dds::xrce::StreamId stream_id)
+{
+    return (uint64_t(conversion::clientkey_to_raw(client_key)) << 8) | stream_id;
+}
+
+/* Timers flushing the open message of an output stream share the heartbeat wheel, told apart by a flag. */
+inline uint64_t output_flush_timer_key(
+        const dds::xrce::ClientKey& client_key,
+        dds::xrce::StreamId stream_id)
+{
+    return heartbeat_timer_key(client_key, stream_id) | OUTPUT_FLUSH_TIMER_FLAG;
+}
+
+/* Timers sending the delayed ACKNACK of a reliable input stream. */
+inline uint64_t acknack_timer_key(
+        const dds::xrce::ClientKey& client_key,
+        dds::xrce::StreamId stream_id)
+{
+    return heartbeat_timer_key(client_key, stream_id) | ACKNACK_TIMER_FLAG;
+}
+
+/* Reads the request of the current WRITE_DATA submessage and a view of its sample, left in the message buffer. */
+inline bool get_write_data(
+        InputMessage& message,
+        dds::xrce::BaseObjectRequest& request,
+        Middleware::SampleView& sample)
+{
+    size_t submessage_length = message.get_subheader().submessage_length();
+
+#ifdef UAGENT_TWEAK_XRCE_WRITE_LIMIT
+    if (submessage_length == 0)
+    {
+        submessage_length =
+            message.get_len()
+            - message.get_header().getCdrSerializedSize(0)
+            - message.get_subheader().getCdrSerializedSize(0);
+    }
+#endif
+
+    const size_t request_length = request.getCdrSerializedSize(0);
+    sample.buf = nullptr;
+    sample.len = (submessage_length > request_length) ? submessage_length - request_length : 0;
+    return (submessage_length >= request_length)
+        && message.get_payload(request)
+        && message.get_payload_view(sample.buf, sample.len);
+}
+
+/* Whether the next submessage is a WRITE_DATA with a sample for the given object,
+   whose ObjectId follows the RequestId at the beginning of the payload. */
+inline bool is_next_write_data(
+        const InputMessage& message,
+        const dds::xrce::ObjectId& object_id)
+{
+    const SubmessageIndexEntry* entry = message.peek_next_submessage();
+    return (nullptr != entry)
+        && (dds::xrce::WRITE_DATA == entry->id)
+        && (dds::xrce::FORMAT_DATA_FLAG == (entry->flags & 0x0E))
+        && (message.get_len() >= size_t(entry->offset) + 8)
+        && (object_id[0] == message.get_buf()[entry->offset + 6])
+        && (object_id[1] == message.get_buf()[entry->offset + 7]);
+}
+
 template<typename EndPoint>
 Processor<EndPoint>::Processor(
         Server<EndPoint>& server,
@@ -39,7 +110,31 @@ Processor<EndPoint>::Processor(
     : server_(server)
     , middleware_kind_{middleware_kind}
     , root_(root)
-{}
+    , heartbeat_wheel_(std::chrono::milliseconds(
+        std::min(HEARTBEAT_PERIOD / HEARTBEAT_TICKS_PER_PERIOD, int(MIN_HEARTBEAT_PERIOD))))
+    , output_linger_(0)
+    , acknack_max_pending_(ACKNACK_MAX_PENDING)
+    , acknack_delay_(ACKNACK_DELAY)
+    , info_reply_(get_info_reply({}))
+    , info_limiter_(INFO_RATE, INFO_BURST, INFO_MAX_SOURCES)
+{
+    /* Clients created through the Agent API or the P2P discovery do not go through CREATE_CLIENT. */
+    root_.set_on_create_client([this](const std::shared_ptr<ProxyClient>& client)
+    {
+        if (client->has_hard_liveliness_check())
+        {
+            heartbeat_wheel_.schedule(
+                heartbeat_timer_key(client->get_client_key(), dds::xrce::STREAMID_NONE),
+                std::chrono::milliseconds(HEARTBEAT_PERIOD));
+        }
+    });
+}
+
+template<typename EndPoint>
+Processor<EndPoint>::~Processor()
+{
+    root_.set_on_create_client(nullptr);
+}
 
 template<typename EndPoint>
 void Processor<EndPoint>::process_input_packet(
@@ -63,8 +158,10 @@ void Processor<EndPoint>::process_input_packet(
                 case dds::xrce::GET_INFO:
                 {
                     OutputPacket<EndPoint> output_packet;
-                    process_get_info_packet(std::move(input_packet), output_packet);
-                    server_.push_output_packet(std::move(output_packet));
+                    if (process_get_info_packet(std::move(input_packet), output_packet))
+                    {
+                        server_.push_output_packet(std::move(output_packet));
+                    }
                     break;
                 }
                 default:
@@ -98,7 +195,7 @@ void Processor<EndPoint>::process_input_packet(
             Session& session = client->session();
             dds::xrce::StreamId stream_id = input_packet.message->get_header().stream_id();
             dds::xrce::SequenceNr sequence_nr = input_packet.message->get_header().sequence_nr();
-            session.push_input_message(std::move(input_packet.message), stream_id, sequence_nr);
+            const bool accepted = session.push_input_message(std::move(input_packet.message), stream_id, sequence_nr);
             while (session.pop_input_message(stream_id, input_packet.message))
             {
                 process_input_message(*client, input_packet);
@@ -106,31 +203,18 @@ void Processor<EndPoint>::process_input_packet(
 
             if (is_reliable_stream(stream_id))
             {
-                dds::xrce::MessageHeader acknack_header;
-                acknack_header.session_id(header.session_id());
-                acknack_header.stream_id(dds::xrce::STREAMID_NONE);
-                acknack_header.sequence_nr(0x00);
-                acknack_header.client_key(header.client_key());
-
-                dds::xrce::ACKNACK_Payload acknack_payload;
-                client->session().fill_acknack(stream_id, acknack_payload);
-                acknack_payload.stream_id(header.stream_id());
-
-                dds::xrce::SubmessageHeader acknack_subheader;
-                acknack_subheader.submessage_id(dds::xrce::ACKNACK);
-                acknack_subheader.flags(dds::xrce::FLAG_LITTLE_ENDIANNESS);
-                acknack_subheader.submessage_length(uint16_t(acknack_payload.getCdrSerializedSize()));
-
-                const size_t message_size = acknack_header.getCdrSerializedSize() +
-                                            acknack_subheader.getCdrSerializedSize() +
-                                            acknack_payload.getCdrSerializedSize();
-
-                OutputPacket<EndPoint> output_packet;
-                output_packet.destination = input_packet.source;
-                output_packet.message.reset(new OutputMessage(acknack_header, message_size));
-                output_packet.message->append_submessage(dds::xrce::ACKNACK, acknack_payload);
-
-                server_.push_output_packet(std::move(output_packet));
+                if (session.notify_reliable_message(stream_id, accepted))
+                {
+                    send_acknack(*client, stream_id, input_packet.source);
+                }
+                else
+                {
+                    /* A pending timer is kept, so that no message waits longer than the delay. */
+                    heartbeat_wheel_.schedule(
+                        acknack_timer_key(client->get_client_key(), stream_id),
+                        session.get_acknack_delay(),
+                        false);
+                }
             }
         }
         else
@@ -157,7 +241,7 @@ void Processor<EndPoint>::process_input_packet(
 
                             OutputPacket<EndPoint> output_packet;
                             output_packet.destination = input_packet.source;
-                            output_packet.message.reset(new OutputMessage(input_packet.message->get_header(), message_size));
+                            output_packet.message = OutputMessage::create(input_packet.message->get_header(), message_size);
                             output_packet.message->append_submessage(dds::xrce::STATUS, status_payload);
 
                             server_.push_output_packet(std::move(output_packet));
@@ -168,8 +252,10 @@ void Processor<EndPoint>::process_input_packet(
                     case dds::xrce::GET_INFO:
                     {
                         OutputPacket<EndPoint> output_packet;
-                        process_get_info_packet(std::move(input_packet), output_packet);
-                        server_.push_output_packet(std::move(output_packet));
+                        if (process_get_info_packet(std::move(input_packet), output_packet))
+                        {
+                            server_.push_output_packet(std::move(output_packet));
+                        }
                         break;
                     }
                     default:
@@ -285,6 +371,12 @@ bool Processor<EndPoint>::process_create_client_submessage(
                 server_.establish_session(input_packet.source,
                                           conversion::clientkey_to_raw(client_payload.client_representation().client_key()),
                                           client_payload.client_representation().session_id());
+
+                std::shared_ptr<ProxyClient> client = root_.get_client(client_payload.client_representation().client_key());
+                if (client)
+                {
+                    client->session().set_acknack_policy(acknack_max_pending_, acknack_delay_);
+                }
             }
 
             dds::xrce::STATUS_AGENT_Payload status_agent;
@@ -302,7 +394,7 @@ bool Processor<EndPoint>::process_create_client_submessage(
 
             OutputPacket<EndPoint> output_packet;
             output_packet.destination = input_packet.source;
-            output_packet.message = std::shared_ptr<OutputMessage>(new OutputMessage(status_header, message_size));
+            output_packet.message = OutputMessage::create(status_header, message_size);
             output_packet.message->append_submessage(dds::xrce::STATUS_AGENT, status_agent);
 
             server_.push_output_packet(std::move(output_packet));
@@ -346,14 +438,12 @@ bool Processor<EndPoint>::process_create_submessage(
             stream_kind,
             dds::xrce::STATUS,
             status_payload,
-            std::chrono::milliseconds(0));
+            std::chrono::milliseconds(0),
+            std::chrono::milliseconds::zero() < output_linger_);
 
         OutputPacket<EndPoint> output_packet;
         output_packet.destination = input_packet.source;
-        while (client.session().get_next_output_message(stream_kind, output_packet.message))
-        {
-            server_.push_output_packet(std::move(output_packet));
-        }
+        push_output_messages(client, stream_kind, output_packet);
     }
     return rv;
 }
@@ -405,12 +495,10 @@ bool Processor<EndPoint>::process_delete_submessage(
                 stream_kind,
                 dds::xrce::STATUS,
                 status_payload,
-                std::chrono::milliseconds(0));
+                std::chrono::milliseconds(0),
+                std::chrono::milliseconds::zero() < output_linger_);
 
-            while (client.session().get_next_output_message(stream_kind, output_packet.message))
-            {
-                server_.push_output_packet(std::move(output_packet));
-            }
+            push_output_messages(client, stream_kind, output_packet);
         }
     }
     else
@@ -431,56 +519,60 @@ bool Processor<EndPoint>::process_write_data_submessage(
 {
     bool deserialized = false, written = false;
     uint8_t flags = input_packet.message->get_subheader().flags() & 0x0E;
-    size_t submessage_length = input_packet.message->get_subheader().submessage_length();
-
-#ifdef UAGENT_TWEAK_XRCE_WRITE_LIMIT
-    if (submessage_length == 0)
-    {
-        submessage_length =
-            input_packet.message->get_len()
-            - input_packet.message->get_header().getCdrSerializedSize(0)
-            - input_packet.message->get_subheader().getCdrSerializedSize(0);
-    }
-#endif
 
     switch (flags)
     {
         case dds::xrce::FORMAT_DATA_FLAG:
         {
-            dds::xrce::WRITE_DATA_Payload_Data data_payload;
-            data_payload.data().resize(submessage_length - data_payload.BaseObjectRequest::getCdrSerializedSize(0));
-            if (input_packet.message->get_payload(data_payload))
+            /* The sample is written from the message buffer, without being copied. */
+            dds::xrce::BaseObjectRequest request;
+            Middleware::SampleView sample;
+            deserialized = get_write_data(*input_packet.message, request, sample);
+            if (deserialized)
             {
-                const dds::xrce::ObjectId& object_id = data_payload.object_id();
+                const dds::xrce::ObjectId& object_id = request.object_id();
                 switch (object_id[1] & 0x0F)
                 {
                     case dds::xrce::OBJK_DATAWRITER:
                     {
-                        std::shared_ptr<DataWriter> data_writer =
-                                std::dynamic_pointer_cast<DataWriter>(client.get_object(object_id));
+                        std::shared_ptr<DataWriter> data_writer = client.get_datawriter(object_id);
                         if (nullptr != data_writer)
                         {
-                            written = data_writer->write(data_payload);
+                            /* The samples of the following submessages for the same DataWriter are written as a batch. */
+                            std::array<Middleware::SampleView, WRITE_DATA_BATCH_SIZE> batch;
+                            size_t count = 0;
+                            batch[count++] = sample;
+                            while ((batch.size() > count)
+                                && is_next_write_data(*input_packet.message, object_id)
+                                && input_packet.message->prepare_next_submessage())
+                            {
+                                dds::xrce::BaseObjectRequest next_request;
+                                deserialized = get_write_data(*input_packet.message, next_request, batch[count]);
+                                if (!deserialized)
+                                {
+                                    break;
+                                }
+                                ++count;
+                            }
+                            written = (count == data_writer->write_batch(batch.data(), count));
                         }
                         break;
                     }
                     case dds::xrce::OBJK_REQUESTER:
                     {
-                        std::shared_ptr<Requester> requester =
-                                std::dynamic_pointer_cast<Requester>(client.get_object(object_id));
+                        std::shared_ptr<Requester> requester = client.get_requester(object_id);
                         if (nullptr != requester)
                         {
-                            written = requester->write(data_payload, data_payload.request_id());
+                            written = requester->write(sample.buf, sample.len, request.request_id());
                         }
                         break;
                     }
                     case dds::xrce::OBJK_REPLIER:
                     {
-                        std::shared_ptr<Replier> replier =
-                                std::dynamic_pointer_cast<Replier>(client.get_object(object_id));
+                        std::shared_ptr<Replier> replier = client.get_replier(object_id);
                         if (nullptr != replier)
                         {
-                            written = replier->write(data_payload);
+                            written = replier->write(sample.buf, sample.len);
                         }
                         break;
                     }
@@ -491,9 +583,9 @@ bool Processor<EndPoint>::process_write_data_submessage(
                             conversion::objectid_to_raw(object_id));
                         break;
                 }
-                deserialized = true;
             }
-            else
+
+            if (!deserialized)
             {
                 UXR_AGENT_LOG_ERROR(
                     UXR_DECORATE_RED("deserialization error processing WRITE_DATA submessage"),
@@ -519,24 +611,26 @@ bool Processor<EndPoint>::process_read_data_submessage(
     if (input_packet.message->get_payload(read_payload))
     {
         const dds::xrce::ObjectId& object_id = read_payload.object_id();
-        std::shared_ptr<XRCEObject> reader_object;
+        std::shared_ptr<DataReader> data_reader;
+        std::shared_ptr<Requester> requester;
+        std::shared_ptr<Replier> replier;
 
         switch (object_id[1] & 0x0F)
         {
             case dds::xrce::OBJK_DATAREADER:
-                reader_object = std::dynamic_pointer_cast<DataReader>(client.get_object(read_payload.object_id()));
+                data_reader = client.get_datareader(object_id);
                 break;
             case dds::xrce::OBJK_REQUESTER:
-                reader_object = std::dynamic_pointer_cast<Requester>(client.get_object(read_payload.object_id()));
+                requester = client.get_requester(object_id);
                 break;
             case dds::xrce::OBJK_REPLIER:
-                reader_object = std::dynamic_pointer_cast<Replier>(client.get_object(read_payload.object_id()));
+                replier = client.get_replier(object_id);
                 break;
             default:
                 break;
         }
 
-        dds::xrce::StatusValue status = (nullptr != reader_object)
+        dds::xrce::StatusValue status = (data_reader || requester || replier)
                 ? dds::xrce::STATUS_OK
                 : dds::xrce::STATUS_ERR_UNKNOWN_REFERENCE;
 
@@ -555,13 +649,13 @@ bool Processor<EndPoint>::process_read_data_submessage(
             switch (object_id[1] & 0x0F)
             {
                 case dds::xrce::OBJK_DATAREADER:
-                    reading = std::dynamic_pointer_cast<DataReader>(reader_object)->read(read_payload, write_fn, write_args);
+                    reading = data_reader->read(read_payload, write_fn, write_args);
                     break;
                 case dds::xrce::OBJK_REQUESTER:
-                    reading = std::dynamic_pointer_cast<Requester>(reader_object)->read(read_payload, write_fn, write_args);
+                    reading = requester->read(read_payload, write_fn, write_args);
                     break;
                 case dds::xrce::OBJK_REPLIER:
-                    reading = std::dynamic_pointer_cast<Replier>(reader_object)->read(read_payload, write_fn, write_args);
+                    reading = replier->read(read_payload, write_fn, write_args);
                     break;
                 default:
                     break;
@@ -593,6 +687,7 @@ bool Processor<EndPoint>::process_read_data_submessage(
             {
                 server_.push_output_packet(std::move(output_packet));
             }
+            schedule_heartbeat(client, dds::xrce::STREAMID_BUILTIN_RELIABLE);
         }
     }
     else
@@ -618,28 +713,36 @@ bool Processor<EndPoint>::process_acknack_submessage(
         uint16_t first_message = acknack_payload.first_unacked_seq_num();
         std::array<uint8_t, 2> nack_bitmap = acknack_payload.nack_bitmap();
         uint8_t stream_id = acknack_payload.stream_id();
-        for (uint16_t i = 0; i < 8; ++i)
+        client.session().notify_acknack_received(stream_id);
+
+        /* Only the NACKed messages are visited, up to the highest bit set. */
+        uint16_t nacks = uint16_t((nack_bitmap.at(0) << 8) | nack_bitmap.at(1));
+        for (uint16_t i = 0; 0 != nacks; ++i, nacks >>= 1)
         {
-            OutputPacket<EndPoint> output_packet;
-            output_packet.destination = input_packet.source;
-            uint8_t mask = uint8_t(0x01 << i);
-            if ((nack_bitmap.at(1) & mask) == mask)
+            if (0 != (nacks & 0x01))
             {
+                OutputPacket<EndPoint> output_packet;
+                output_packet.destination = input_packet.source;
                 if (client.session().get_output_message(stream_id, first_message + i, output_packet.message))
                 {
                     server_.push_output_packet(std::move(output_packet));
                 }
             }
-            if ((nack_bitmap.at(0) & mask) == mask)
-            {
-                if (client.session().get_output_message(stream_id, first_message + i + 8, output_packet.message))
-                {
-                    server_.push_output_packet(std::move(output_packet));
-                }
-            }
         }
 
         client.session().update_from_acknack(stream_id, first_message);
+
+        /* Restart the HEARTBEAT timer while there are unacknowledged messages. */
+        dds::xrce::HEARTBEAT_Payload heartbeat;
+        const uint64_t timer_key = heartbeat_timer_key(client.get_client_key(), stream_id);
+        if (client.session().fill_heartbeat(stream_id, heartbeat))
+        {
+            heartbeat_wheel_.schedule(timer_key, client.session().get_heartbeat_period());
+        }
+        else
+        {
+            heartbeat_wheel_.cancel(timer_key);
+        }
     }
     else
     {
@@ -764,51 +867,26 @@ bool Processor<EndPoint>::process_get_info_submessage(
         ProxyClient& client,
         InputPacket<EndPoint>& input_packet)
 {
-    bool rv = false;
+    bool rv = true;
 
     dds::xrce::GET_INFO_Payload get_info_payload;
     input_packet.message->get_payload(get_info_payload);
 
-    dds::xrce::ObjectInfo object_info;
-    dds::xrce::ResultStatus result_status = root_.get_info(object_info);
-    if (dds::xrce::STATUS_OK == result_status.status())
+    /* A ping over the rate is dropped without stopping the submessages that follow it. */
+    if (info_limiter_.allow(input_packet.source))
     {
-        result_status.implementation_status(1);
-
-        dds::xrce::AGENT_ActivityInfo agent_info;
-        agent_info.availability(1);
-
-        dds::xrce::ActivityInfoVariant info_variant;
-        info_variant.agent(agent_info);
-        object_info.activity(info_variant);
-
-        dds::xrce::INFO_Payload info_payload;
-        info_payload.related_request().request_id(get_info_payload.request_id());
-        info_payload.related_request().object_id(get_info_payload.object_id());
-        info_payload.result(result_status);
-        info_payload.object_info(object_info);
-
-        dds::xrce::SubmessageHeader info_subheader;
-        info_subheader.submessage_id(dds::xrce::INFO);
-        info_subheader.flags(dds::xrce::FLAG_LITTLE_ENDIANNESS);
-        info_subheader.submessage_length(uint16_t(info_payload.getCdrSerializedSize()));
-
-        OutputPacket<EndPoint> output_packet;
-        output_packet.destination = input_packet.source;
-
         dds::xrce::MessageHeader header;
         header.session_id(client.get_session_id());
         header.client_key(client.get_client_key());
 
-        const size_t message_size =
-            header.getCdrSerializedSize() +
-            info_subheader.getCdrSerializedSize() +
-            info_payload.getCdrSerializedSize();
-
-        output_packet.message = OutputMessagePtr(new OutputMessage(header, message_size));
-        rv = output_packet.message->append_submessage(dds::xrce::INFO, info_payload);
-
-        server_.push_output_packet(std::move(output_packet));
+        OutputPacket<EndPoint> output_packet;
+        output_packet.destination = input_packet.source;
+        output_packet.message = info_reply_.create_message(header, get_info_payload, 1);
+        rv = bool(output_packet.message);
+        if (rv)
+        {
+            server_.push_output_packet(std::move(output_packet));
+        }
     }
 
     return rv;
@@ -818,28 +896,34 @@ template<typename EndPoint>
 bool Processor<EndPoint>::read_data_callback(
         const WriteFnArgs& cb_args,
         const std::vector<uint8_t>& buffer,
-        std::chrono::milliseconds timeout)
+        const std::shared_ptr<std::function<void()>>& resume)
 {
     bool rv = false;
 
-    dds::xrce::DATA_Payload_Data data_payload;
-    data_payload.request_id(cb_args.request_id);
-    data_payload.object_id(cb_args.object_id);
-    data_payload.data().serialized_data(buffer);
+    /* The sample is copied once into a pooled buffer, which the output messages reference. */
+    std::shared_ptr<BufferPool::Buffer> data =
+        std::allocate_shared<BufferPool::Buffer>(
+            utils::RecyclingAllocator<BufferPool::Buffer>(), BufferPool::get_default()->acquire(buffer.size()));
+    memcpy(data->data(), buffer.data(), buffer.size());
+
+    ScatteredDataPayload data_payload;
+    data_payload.request.request_id(cb_args.request_id);
+    data_payload.request.object_id(cb_args.object_id);
+    data_payload.data = std::move(data);
+    data_payload.len = buffer.size();
 
     OutputPacket<EndPoint> output_packet;
     if (server_.get_endpoint(conversion::clientkey_to_raw(cb_args.client_key), output_packet.destination))
     {
-        rv = cb_args.client->session().push_output_submessage(cb_args.stream_id, dds::xrce::DATA, data_payload, timeout);
-
-        while (cb_args.client->session().get_next_output_message(cb_args.stream_id, output_packet.message))
-        {
-            server_.push_output_packet(std::move(output_packet));
-        }
-    }
-    else
-    {
-        std::this_thread::sleep_for(timeout);
+        /* A full window does not block the reader, which is resumed once the ACKNACKs open it. */
+        rv = (PushResult::pushed == cb_args.client->session().try_push_output_submessage(
+            cb_args.stream_id,
+            dds::xrce::DATA,
+            data_payload,
+            resume,
+            std::chrono::milliseconds::zero() < output_linger_));
+
+        push_output_messages(*cb_args.client, cb_args.stream_id, output_packet);
     }
     return rv;
 }
@@ -849,60 +933,27 @@ bool Processor<EndPoint>::process_get_info_packet(
         InputPacket<EndPoint>&& input_packet,
         OutputPacket<EndPoint>& output_packet) const
 {
-    bool rv = false;
-
     dds::xrce::GET_INFO_Payload get_info_payload;
     input_packet.message->get_payload(get_info_payload);
 
-    dds::xrce::ObjectInfo object_info;
-    dds::xrce::ResultStatus result_status = root_.get_info(object_info);
-    if (dds::xrce::STATUS_OK == result_status.status())
+    if (!info_limiter_.allow(input_packet.source))
     {
-        uint32_t raw_client_key;
-        if (server_.get_client_key(input_packet.source, raw_client_key))
-        {
-            result_status.implementation_status(1);
-        }
-        else
-        {
-            result_status.implementation_status(0);
-        }
-
-        dds::xrce::AGENT_ActivityInfo agent_info;
-        agent_info.availability(1);
-
-        dds::xrce::ActivityInfoVariant info_variant;
-        info_variant.agent(agent_info);
-        object_info.activity(info_variant);
-
-        dds::xrce::INFO_Payload info_payload;
-        info_payload.related_request().request_id(get_info_payload.request_id());
-        info_payload.related_request().object_id(get_info_payload.object_id());
-        info_payload.result(result_status);
-        info_payload.object_info(object_info);
-
-        dds::xrce::SubmessageHeader info_subheader;
-        info_subheader.submessage_id(dds::xrce::INFO);
-        info_subheader.flags(dds::xrce::FLAG_LITTLE_ENDIANNESS);
-        info_subheader.submessage_length(uint16_t(info_payload.getCdrSerializedSize()));
-
-        const size_t message_size = input_packet.message->get_header().getCdrSerializedSize() +
-                                    info_subheader.getCdrSerializedSize() +
-                                    info_payload.getCdrSerializedSize();
-
-        output_packet.destination = input_packet.source;
-        output_packet.message = OutputMessagePtr(new OutputMessage(input_packet.message->get_header(),
-                                                                    message_size));
-        rv = output_packet.message->append_submessage(dds::xrce::INFO, info_payload);
+        return false;
     }
 
-    return rv;
+    uint32_t raw_client_key;
+    const uint8_t implementation_status = server_.get_client_key(input_packet.source, raw_client_key) ? 1 : 0;
+
+    output_packet.destination = input_packet.source;
+    output_packet.message =
+        info_reply_.create_message(input_packet.message->get_header(), get_info_payload, implementation_status);
+    return bool(output_packet.message);
 }
 
 template<typename EndPoint>
 bool Processor<EndPoint>::process_get_info_packet(
         InputPacket<IPv4EndPoint>&& input_packet,
-        std::vector<dds::xrce::TransportAddress>& address,
+        const InfoReply& info_reply,
         OutputPacket<IPv4EndPoint>& output_packet) const
 {
     bool rv = false;
@@ -914,131 +965,294 @@ bool Processor<EndPoint>::process_get_info_packet(
             dds::xrce::GET_INFO_Payload get_info_payload;
             input_packet.message->get_payload(get_info_payload);
 
-            dds::xrce::ObjectInfo object_info;
-            dds::xrce::ResultStatus result_status = root_.get_info(object_info);
-            if (dds::xrce::STATUS_OK == result_status.status())
-            {
-                dds::xrce::AGENT_ActivityInfo agent_info;
-                for (auto &a : address)
-                {
-                    agent_info.address_seq().push_back(a);
-                }
-                agent_info.availability(1);
+            output_packet.destination = input_packet.source;
+            output_packet.message = info_reply.create_message(input_packet.message->get_header(), get_info_payload, 0);
+            rv = bool(output_packet.message);
+        }
+    }
 
-                dds::xrce::ActivityInfoVariant info_variant;
-                info_variant.agent(agent_info);
-                object_info.activity(info_variant);
+    return rv;
+}
+
+template<typename EndPoint>
+InfoReply Processor<EndPoint>::get_info_reply(
+        const std::vector<dds::xrce::TransportAddress>& addresses) const
+{
+    dds::xrce::ObjectInfo object_info;
+    dds::xrce::ResultStatus result_status = root_.get_info(object_info);
+    if (dds::xrce::STATUS_OK != result_status.status())
+    {
+        return InfoReply();
+    }
 
-                dds::xrce::INFO_Payload info_payload;
-                info_payload.related_request().request_id(get_info_payload.request_id());
-                info_payload.related_request().object_id(get_info_payload.object_id());
-                info_payload.result(result_status);
-                info_payload.object_info(object_info);
+    dds::xrce::AGENT_ActivityInfo agent_info;
+    agent_info.address_seq(addresses);
+    agent_info.availability(1);
 
-                dds::xrce::SubmessageHeader info_subheader;
-                info_subheader.submessage_id(dds::xrce::INFO);
-                info_subheader.flags(dds::xrce::FLAG_LITTLE_ENDIANNESS);
-                info_subheader.submessage_length(uint16_t(info_payload.getCdrSerializedSize()));
+    dds::xrce::ActivityInfoVariant info_variant;
+    info_variant.agent(agent_info);
+    object_info.activity(info_variant);
 
-                const size_t message_size = input_packet.message->get_header().getCdrSerializedSize() +
-                                            info_subheader.getCdrSerializedSize() +
-                                            info_payload.getCdrSerializedSize();
+    dds::xrce::INFO_Payload info_payload;
+    info_payload.result(result_status);
+    info_payload.object_info(object_info);
 
-                output_packet.destination = input_packet.source;
-                output_packet.message = OutputMessagePtr(new OutputMessage(input_packet.message->get_header(),
-                                                                           message_size));
-                rv = output_packet.message->append_submessage(dds::xrce::INFO, info_payload);
+    return InfoReply(info_payload);
+}
+
+template<typename EndPoint>
+void Processor<EndPoint>::check_heartbeats()
+{
+    std::vector<uint64_t> expired;
+    heartbeat_wheel_.advance(utils::TimerWheel::Clock::now(), expired);
+
+    for (uint64_t timer_key : expired)
+    {
+        std::shared_ptr<ProxyClient> client = root_.get_client(conversion::raw_to_clientkey(uint32_t(timer_key >> 8)));
+        if (client)
+        {
+            dds::xrce::StreamId stream_id = dds::xrce::StreamId(timer_key & 0xFF);
+            if (0 != (timer_key & OUTPUT_FLUSH_TIMER_FLAG))
+            {
+                flush_output_stream(*client, stream_id);
+            }
+            else if (0 != (timer_key & ACKNACK_TIMER_FLAG))
+            {
+                send_delayed_acknack(*client, stream_id);
+            }
+            else if (dds::xrce::STREAMID_NONE == stream_id)
+            {
+                check_liveliness(*client);
+            }
+            else
+            {
+                send_heartbeat(*client, stream_id);
             }
         }
     }
+}
 
-    return rv;
+template<typename EndPoint>
+void Processor<EndPoint>::push_output_messages(
+        ProxyClient& client,
+        dds::xrce::StreamId stream_id,
+        OutputPacket<EndPoint>& output_packet)
+{
+    /* While lingering, the open message is left for the next submessages or for its flush timer. */
+    const bool linger = (std::chrono::milliseconds::zero() < output_linger_);
+    while (client.session().get_next_output_message(stream_id, output_packet.message, !linger))
+    {
+        server_.push_output_packet(std::move(output_packet));
+    }
+
+    if (linger)
+    {
+        /* A pending timer is kept, so that the open message never waits longer than the linger time. */
+        heartbeat_wheel_.schedule(
+            output_flush_timer_key(client.get_client_key(), stream_id),
+            output_linger_,
+            false);
+    }
+    schedule_heartbeat(client, stream_id);
 }
 
 template<typename EndPoint>
-void Processor<EndPoint>::check_heartbeats()
+void Processor<EndPoint>::flush_output_stream(
+        ProxyClient& client,
+        dds::xrce::StreamId stream_id)
+{
+    OutputPacket<EndPoint> output_packet;
+    uint32_t raw_key = conversion::clientkey_to_raw(client.get_client_key());
+    if (server_.get_endpoint(raw_key, output_packet.destination))
+    {
+        while (client.session().get_next_output_message(stream_id, output_packet.message))
+        {
+            server_.push_output_packet(std::move(output_packet));
+        }
+        schedule_heartbeat(client, stream_id);
+    }
+}
+
+template<typename EndPoint>
+void Processor<EndPoint>::send_acknack(
+        ProxyClient& client,
+        dds::xrce::StreamId stream_id,
+        const EndPoint& destination)
 {
-    dds::xrce::MessageHeader header;
-    header.stream_id(dds::xrce::STREAMID_NONE);
-    header.sequence_nr(0x00);
+    dds::xrce::MessageHeader acknack_header;
+    acknack_header.session_id(client.get_session_id());
+    acknack_header.stream_id(dds::xrce::STREAMID_NONE);
+    acknack_header.sequence_nr(0x00);
+    acknack_header.client_key(client.get_client_key());
 
-    dds::xrce::HEARTBEAT_Payload heartbeat;
+    dds::xrce::ACKNACK_Payload acknack_payload;
+    client.session().fill_acknack(stream_id, acknack_payload);
+    acknack_payload.stream_id(stream_id);
 
-    dds::xrce::SubmessageHeader subheader;
-    subheader.submessage_id(dds::xrce::HEARTBEAT);
-    subheader.flags(dds::xrce::FLAG_LITTLE_ENDIANNESS);
-    subheader.submessage_length(uint16_t(heartbeat.getCdrSerializedSize()));
+    dds::xrce::SubmessageHeader acknack_subheader;
+    acknack_subheader.submessage_id(dds::xrce::ACKNACK);
+    acknack_subheader.flags(dds::xrce::FLAG_LITTLE_ENDIANNESS);
+    acknack_subheader.submessage_length(uint16_t(acknack_payload.getCdrSerializedSize()));
 
-    const size_t message_size =
-            header.getCdrSerializedSize() +
-            subheader.getCdrSerializedSize() +
-            heartbeat.getCdrSerializedSize();
+    const size_t message_size = acknack_header.getCdrSerializedSize() +
+                                acknack_subheader.getCdrSerializedSize() +
+                                acknack_payload.getCdrSerializedSize();
 
     OutputPacket<EndPoint> output_packet;
+    output_packet.destination = destination;
+    output_packet.message = OutputMessage::create(acknack_header, message_size);
+    output_packet.message->append_submessage(dds::xrce::ACKNACK, acknack_payload);
+
+    server_.push_output_packet(std::move(output_packet));
+}
 
-    std::shared_ptr<ProxyClient> client;
-    while (root_.get_next_client(client))
+template<typename EndPoint>
+void Processor<EndPoint>::send_delayed_acknack(
+        ProxyClient& client,
+        dds::xrce::StreamId stream_id)
+{
+    /* Nothing is left to acknowledge if an ACKNACK has been sent meanwhile, e.g. answering a HEARTBEAT. */
+    EndPoint destination;
+    uint32_t raw_key = conversion::clientkey_to_raw(client.get_client_key());
+    if (client.session().has_unacked_messages(stream_id) && server_.get_endpoint(raw_key, destination))
+    {
+        send_acknack(client, stream_id, destination);
+    }
+}
+
+template<typename EndPoint>
+void Processor<EndPoint>::schedule_heartbeat(
+        ProxyClient& client,
+        dds::xrce::StreamId stream_id)
+{
+    if (is_reliable_stream(stream_id))
     {
-        ProxyClient::State state = client->get_state();
-        uint32_t raw_key = conversion::clientkey_to_raw(client->get_client_key());
+        /* A pending timer is kept so that a continuous flow of messages does not delay the HEARTBEAT. */
+        heartbeat_wheel_.schedule(
+            heartbeat_timer_key(client.get_client_key(), stream_id),
+            client.session().get_heartbeat_period(),
+            false);
+    }
+}
 
+template<typename EndPoint>
+void Processor<EndPoint>::send_heartbeat(
+        ProxyClient& client,
+        dds::xrce::StreamId stream_id)
+{
+    dds::xrce::HEARTBEAT_Payload heartbeat;
+    if (client.session().fill_heartbeat(stream_id, heartbeat))
+    {
+        OutputPacket<EndPoint> output_packet;
+        uint32_t raw_key = conversion::clientkey_to_raw(client.get_client_key());
         if (server_.get_endpoint(raw_key, output_packet.destination) &&
-             ProxyClient::State::alive == state)
+            ProxyClient::State::alive == client.get_state())
         {
-            header.session_id(client->get_session_id());
-            header.client_key(client->get_client_key());
-
-            for (auto stream : client->session().get_output_streams())
+            /* A client which did not answer the last HEARTBEAT may have lost the first unacknowledged
+               message as well, so it is retransmitted without waiting for a NACK. */
+            if (client.session().notify_heartbeat_sent(stream_id))
             {
-                if (client->session().fill_heartbeat(stream, heartbeat))
+                OutputPacket<EndPoint> retransmit_packet;
+                retransmit_packet.destination = output_packet.destination;
+                if (client.session().get_output_message(
+                        stream_id, heartbeat.first_unacked_seq_nr(), retransmit_packet.message))
                 {
-                    output_packet.message = OutputMessagePtr(new OutputMessage(header, message_size));
-                    output_packet.message->append_submessage(dds::xrce::HEARTBEAT, heartbeat);
-
-                    server_.push_output_packet(std::move(output_packet));
+                    server_.push_output_packet(std::move(retransmit_packet));
                 }
             }
+
+            dds::xrce::MessageHeader header;
+            header.session_id(client.get_session_id());
+            header.stream_id(dds::xrce::STREAMID_NONE);
+            header.sequence_nr(0x00);
+            header.client_key(client.get_client_key());
+
+            dds::xrce::SubmessageHeader subheader;
+            subheader.submessage_id(dds::xrce::HEARTBEAT);
+            subheader.flags(dds::xrce::FLAG_LITTLE_ENDIANNESS);
+            subheader.submessage_length(uint16_t(heartbeat.getCdrSerializedSize()));
+
+            const size_t message_size =
+                    header.getCdrSerializedSize() +
+                    subheader.getCdrSerializedSize() +
+                    heartbeat.getCdrSerializedSize();
+
+            output_packet.message = OutputMessage::create(header, message_size);
+            output_packet.message->append_submessage(dds::xrce::HEARTBEAT, heartbeat);
+
+            server_.push_output_packet(std::move(output_packet));
         }
-        else if (client->has_hard_liveliness_check() && ProxyClient::State::dead == state)
+
+        heartbeat_wheel_.schedule(
+            heartbeat_timer_key(client.get_client_key(), stream_id),
+            client.session().get_heartbeat_period());
+    }
+}
+
+template<typename EndPoint>
+void Processor<EndPoint>::check_liveliness(
+        ProxyClient& client)
+{
+    ProxyClient::State state = client.get_state();
+    uint32_t raw_key = conversion::clientkey_to_raw(client.get_client_key());
+
+    OutputPacket<EndPoint> output_packet;
+    bool has_endpoint = server_.get_endpoint(raw_key, output_packet.destination);
+
+    if (ProxyClient::State::dead == state)
+    {
+        client.get_hard_liveliness_check_tries()++;
+        if (client.get_hard_liveliness_check_tries() == 3)
         {
-            client->get_hard_liveliness_check_tries()++;
-            if (client->get_hard_liveliness_check_tries() == 3)
-            {
-                client->update_state(ProxyClient::State::to_remove);
-            }
+            client.update_state(ProxyClient::State::to_remove);
+        }
+
+        if (has_endpoint)
+        {
+            dds::xrce::MessageHeader header;
+            header.session_id(client.get_session_id());
+            header.stream_id(dds::xrce::STREAMID_NONE);
+            header.sequence_nr(0x00);
+            header.client_key(client.get_client_key());
 
             dds::xrce::GET_INFO_Payload get_info_payload = {};
+            get_info_payload.request_id({0,0});
+            get_info_payload.object_id(dds::xrce::OBJECTID_CLIENT);
+
+            dds::xrce::SubmessageHeader subheader;
+            subheader.submessage_id(dds::xrce::GET_INFO);
+            subheader.flags(dds::xrce::FLAG_LITTLE_ENDIANNESS);
+            subheader.submessage_length(uint16_t(get_info_payload.getCdrSerializedSize()));
 
             const size_t get_info_size =
                 header.getCdrSerializedSize() +
                 subheader.getCdrSerializedSize() +
                 get_info_payload.getCdrSerializedSize();
 
-            header.session_id(client->get_session_id());
-            header.client_key(client->get_client_key());
-
-            get_info_payload.request_id({0,0});
-            get_info_payload.object_id(dds::xrce::OBJECTID_CLIENT);
-
-            output_packet.message = OutputMessagePtr(new OutputMessage(header, get_info_size));
+            output_packet.message = OutputMessage::create(header, get_info_size);
             output_packet.message->append_submessage(dds::xrce::GET_INFO, get_info_payload);
 
             server_.push_output_packet(std::move(output_packet));
         }
-        else if (client->has_hard_liveliness_check() &&ProxyClient::State::to_remove == state)
+    }
+    else if (ProxyClient::State::to_remove == state)
+    {
+        if (dds::xrce::STATUS_OK == root_.delete_client(client.get_client_key()).status())
         {
-            if (dds::xrce::STATUS_OK == root_.delete_client(client->get_client_key()).status())
-            {
-                server_.destroy_session(conversion::clientkey_to_raw(client->get_client_key()));
-
-                UXR_AGENT_LOG_INFO(
-                    UXR_DECORATE_YELLOW("Session destroyed due to liveliness timeout"),
-                    "client_key: 0x{:08X}, address: {}",
-                    raw_key,
-                    output_packet.destination);
-            }
+            server_.destroy_session(raw_key);
+
+            UXR_AGENT_LOG_INFO(
+                UXR_DECORATE_YELLOW("Session destroyed due to liveliness timeout"),
+                "client_key: 0x{:08X}, address: {}",
+                raw_key,
+                output_packet.destination);
+            return;
         }
     }
+
+    heartbeat_wheel_.schedule(
+        heartbeat_timer_key(client.get_client_key(), dds::xrce::STREAMID_NONE),
+        std::chrono::milliseconds(HEARTBEAT_PERIOD));
 }
 
 template class Processor<IPv4EndPoint>;
@@ -124,15 +124,22 @@ bool Replier::matched(
 
 bool Replier::write(
         dds::xrce::WRITE_DATA_Payload_Data& write_data)
+{
+    return write(write_data.data().serialized_data().data(), write_data.data().serialized_data().size());
+}
+
+bool Replier::write(
+        const uint8_t* buf,
+        size_t len)
 {
     bool rv = false;
-    if (proxy_client_->get_middleware().write_reply(get_raw_id(), write_data.data().serialized_data()))
+    if (proxy_client_->get_middleware().write_reply(get_raw_id(), buf, len))
     {
         UXR_AGENT_LOG_MESSAGE(
             UXR_DECORATE_YELLOW("[** <<DDS>> **]"),
             get_raw_id(),
-            write_data.data().serialized_data().data(),
-            write_data.data().serialized_data().size());
+            buf,
+            len);
         rv = true;
     }
     return rv;
@@ -127,17 +127,25 @@ bool Requester::matched(
 bool Requester::write(
         dds::xrce::WRITE_DATA_Payload_Data& write_data,
         const dds::xrce::RequestId& request_id)
+{
+    return write(write_data.data().serialized_data().data(), write_data.data().serialized_data().size(), request_id);
+}
+
+bool Requester::write(
+        const uint8_t* buf,
+        size_t len,
+        const dds::xrce::RequestId& request_id)
 {
     bool rv = false;
     uint32_t sequence_number = (get_raw_id() << 16) + (request_id[0] << 8) + (request_id[1]);
 
-    if (proxy_client_->get_middleware().write_request(get_raw_id(), sequence_number,  write_data.data().serialized_data()))
+    if (proxy_client_->get_middleware().write_request(get_raw_id(), sequence_number, buf, len))
     {
         UXR_AGENT_LOG_MESSAGE(
             UXR_DECORATE_YELLOW("[** <<DDS>> **]"),
             get_raw_id(),
-            write_data.data().serialized_data().data(),
-            write_data.data().serialized_data().size());
+            buf,
+            len);
         rv = true;
     }
 
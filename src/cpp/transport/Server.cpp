@@ -17,6 +17,9 @@
 #include <uxr/agent/processor/Processor.hpp>
 #include <uxr/agent/Root.hpp>
 #include <uxr/agent/logger/Logger.hpp>
+#include <uxr/agent/utils/Conversion.hpp>
+#include <uxr/agent/client/session/Session.hpp>
+#include <uxr/agent/utils/ThreadPolicy.hpp>
 
 #include <uxr/agent/transport/endpoint/IPv4EndPoint.hpp>
 #include <uxr/agent/transport/endpoint/IPv6EndPoint.hpp>
@@ -24,10 +27,17 @@
 #include <uxr/agent/transport/endpoint/SerialEndPoint.hpp>
 #include <uxr/agent/transport/endpoint/MultiSerialEndPoint.hpp>
 #include <uxr/agent/transport/endpoint/CustomEndPoint.hpp>
+#ifdef __linux__
+#include <uxr/agent/transport/util/ReactorLinux.hpp>
+#endif
 
 #include <functional>
+#include <algorithm>
 
 #define RECEIVE_TIMEOUT 1000   // Milliseconds
+#define SEND_BATCH_MAX_SIZE 32
+#define OUTPUT_FAIR_QUANTUM 512 // Bytes per round for a client of weight 1.
+#define REACTOR_READ_MAX_SIZE 32 // Messages read per readiness event before serving other descriptors.
 
 namespace eprosima {
 namespace uxr {
@@ -42,13 +52,30 @@ extern template class Processor<CustomEndPoint>;
 template<typename EndPoint>
 Server<EndPoint>::Server(Middleware::Kind middleware_kind)
     : processor_(new Processor<EndPoint>(*this, *root_, middleware_kind))
+    , input_buffer_pool_(BufferPool::create())
     , running_cond_(false)
-    , input_scheduler_(SERVER_QUEUE_MAX_SIZE)
-    , output_scheduler_(SERVER_QUEUE_MAX_SIZE)
+    , processing_threads_count_(1)
+    , input_overflow_policies_()
+    , input_schedulers_()
+    , output_scheduler_()
+    , output_overflow_policy_(OverflowPolicy::drop_oldest, std::chrono::milliseconds(0))
+    , output_client_weights_()
+    , output_client_weights_mtx_()
     , transport_rc_{TransportRc::ok}
     , error_mtx_{}
     , error_cv_{}
-{}
+#ifndef _WIN32
+    , reactor_mode_(false)
+#endif
+#ifdef __linux__
+    , reactor_(new util::Reactor())
+    , reactor_thread_()
+    , reactor_rc_{TransportRc::ok}
+    , reactor_packets_()
+#endif
+{
+    set_output_fair_queuing(false);
+}
 
 template<typename EndPoint>
 Server<EndPoint>::~Server()
@@ -68,16 +95,62 @@ bool Server<EndPoint>::start()
     }
 
     /* Scheduler initialization. */
-    input_scheduler_.init();
-    input_scheduler_.set_priority_size(1, 1); // Priority 1 used for heartbeats
-    output_scheduler_.init();
+    input_schedulers_.clear();
+    for (size_t i = 0; i < processing_threads_count_; ++i)
+    {
+        input_schedulers_.emplace_back(new PacketScheduler<InputPacket<EndPoint>>(SERVER_QUEUE_MAX_SIZE));
+        input_schedulers_.back()->init();
+        input_schedulers_.back()->set_priority_size(1, 1); // Priority 1 used for heartbeats
+        input_schedulers_.back()->set_best_effort_predicate([](const InputPacket<EndPoint>& input_packet)
+        {
+            return !is_reliable_stream(input_packet.message->get_header().stream_id());
+        });
+        for (const auto& overflow_policy : input_overflow_policies_)
+        {
+            input_schedulers_.back()->set_overflow_policy(
+                overflow_policy.first, overflow_policy.second.first, overflow_policy.second.second);
+        }
+    }
+    output_scheduler_->init();
+
+    /* Reactor initialization. */
+    bool use_reactor = false;
+#ifdef __linux__
+    if (reactor_mode_)
+    {
+        use_reactor = reactor_->init() && register_reactor_fds() &&
+            reactor_->add_timer(processor_->get_heartbeat_resolution(), [this]()
+            {
+                processor_->check_heartbeats();
+            });
+        if (!use_reactor)
+        {
+            reactor_->fini();
+            UXR_AGENT_LOG_WARN(
+                UXR_DECORATE_YELLOW("reactor mode not available"),
+                "falling back to receiver thread",
+                "");
+        }
+    }
+#endif
 
     /* Thread initialization. */
     running_cond_ = true;
     error_handler_thread_ = std::thread(&Server::error_handler_loop, this);
-    receiver_thread_ = std::thread(&Server::receiver_loop, this);
     sender_thread_ = std::thread(&Server::sender_loop, this);
-    processing_thread_ = std::thread(&Server::processing_loop, this);
+    processing_threads_.clear();
+    for (size_t i = 0; i < input_schedulers_.size(); ++i)
+    {
+        processing_threads_.emplace_back(&Server::processing_loop, this, i);
+    }
+#ifdef __linux__
+    if (use_reactor)
+    {
+        reactor_thread_ = std::thread(&Server::reactor_loop, this);
+        return true;
+    }
+#endif
+    receiver_thread_ = std::thread(&Server::receiver_loop, this);
     heartbeat_thread_ = std::thread(&Server::heartbeat_loop, this);
 
     return true;
@@ -90,12 +163,25 @@ bool Server<EndPoint>::stop()
     running_cond_ = false;
 
     /* Stop input and output queues. */
-    input_scheduler_.deinit();
-    output_scheduler_.deinit();
+    for (auto& input_scheduler : input_schedulers_)
+    {
+        input_scheduler->deinit();
+    }
+    output_scheduler_->deinit();
 
     error_cv_.notify_all();
+#ifdef __linux__
+    reactor_->wakeup();
+#endif
 
     /* Join threads. */
+#ifdef __linux__
+    if (reactor_thread_.joinable())
+    {
+        reactor_thread_.join();
+    }
+    reactor_->fini();
+#endif
     if (receiver_thread_.joinable())
     {
         receiver_thread_.join();
@@ -104,9 +190,12 @@ bool Server<EndPoint>::stop()
     {
         sender_thread_.join();
     }
-    if (processing_thread_.joinable())
+    for (auto& processing_thread : processing_threads_)
     {
-        processing_thread_.join();
+        if (processing_thread.joinable())
+        {
+            processing_thread.join();
+        }
     }
     if (heartbeat_thread_.joinable())
     {
@@ -135,6 +224,197 @@ bool Server<EndPoint>::stop()
     return rv;
 }
 
+template<typename EndPoint>
+bool Server<EndPoint>::set_processing_threads(size_t count)
+{
+    std::lock_guard<std::mutex> lock(mtx_);
+    bool rv = false;
+    if (!running_cond_ && (0 < count))
+    {
+        processing_threads_count_ = count;
+        rv = true;
+    }
+    return rv;
+}
+
+template<typename EndPoint>
+bool Server<EndPoint>::set_input_overflow_policy(
+        uint8_t priority,
+        OverflowPolicy policy,
+        std::chrono::milliseconds timeout)
+{
+    std::lock_guard<std::mutex> lock(mtx_);
+    bool rv = false;
+    if (!running_cond_)
+    {
+        input_overflow_policies_[priority] = std::make_pair(policy, timeout);
+        rv = true;
+    }
+    return rv;
+}
+
+template<typename EndPoint>
+bool Server<EndPoint>::set_output_overflow_policy(
+        OverflowPolicy policy,
+        std::chrono::milliseconds timeout)
+{
+    std::lock_guard<std::mutex> lock(mtx_);
+    bool rv = false;
+    if (!running_cond_)
+    {
+        output_overflow_policy_ = std::make_pair(policy, timeout);
+        output_scheduler_->set_overflow_policy(0, policy, timeout);
+        rv = true;
+    }
+    return rv;
+}
+
+template<typename EndPoint>
+bool Server<EndPoint>::set_output_fair_queuing(
+        bool enable)
+{
+    std::lock_guard<std::mutex> lock(mtx_);
+    if (running_cond_)
+    {
+        return false;
+    }
+
+    if (enable)
+    {
+        FairScheduler<OutputPacket<EndPoint>, EndPoint>* fair_scheduler = new FairScheduler<OutputPacket<EndPoint>, EndPoint>(
+            SERVER_QUEUE_MAX_SIZE,
+            OUTPUT_FAIR_QUANTUM,
+            [](const OutputPacket<EndPoint>& output_packet) { return output_packet.destination; },
+            [](const OutputPacket<EndPoint>& output_packet) { return output_packet.message->get_len(); });
+        fair_scheduler->set_weight_function([this](const EndPoint& endpoint) { return get_output_weight(endpoint); });
+        output_scheduler_.reset(fair_scheduler);
+    }
+    else
+    {
+        output_scheduler_.reset(new PacketScheduler<OutputPacket<EndPoint>>(SERVER_QUEUE_MAX_SIZE));
+    }
+
+    output_scheduler_->set_best_effort_predicate([](const OutputPacket<EndPoint>& output_packet)
+    {
+        return !is_reliable_stream(output_packet.message->get_stream_id());
+    });
+    output_scheduler_->set_overflow_policy(0, output_overflow_policy_.first, output_overflow_policy_.second);
+    return true;
+}
+
+template<typename EndPoint>
+bool Server<EndPoint>::set_output_linger(std::chrono::milliseconds linger)
+{
+    std::lock_guard<std::mutex> lock(mtx_);
+    bool rv = false;
+    if (!running_cond_ && (std::chrono::milliseconds::zero() <= linger))
+    {
+        processor_->set_output_linger(linger);
+        rv = true;
+    }
+    return rv;
+}
+
+template<typename EndPoint>
+bool Server<EndPoint>::set_acknack_policy(
+        uint16_t max_pending,
+        std::chrono::milliseconds delay)
+{
+    std::lock_guard<std::mutex> lock(mtx_);
+    bool rv = false;
+    if (!running_cond_ && (0 < max_pending) && (std::chrono::milliseconds::zero() <= delay))
+    {
+        processor_->set_acknack_policy(max_pending, delay);
+        rv = true;
+    }
+    return rv;
+}
+
+template<typename EndPoint>
+bool Server<EndPoint>::set_output_client_weight(
+        uint32_t client_key,
+        uint32_t weight)
+{
+    if (0 == weight)
+    {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(output_client_weights_mtx_);
+    output_client_weights_[client_key] = weight;
+    return true;
+}
+
+template<typename EndPoint>
+uint32_t Server<EndPoint>::get_output_weight(
+        const EndPoint& endpoint)
+{
+    std::lock_guard<std::mutex> lock(output_client_weights_mtx_);
+    for (const auto& client_weight : output_client_weights_)
+    {
+        EndPoint client_endpoint;
+        if (this->get_endpoint(client_weight.first, client_endpoint) &&
+            !(client_endpoint < endpoint) && !(endpoint < client_endpoint))
+        {
+            return client_weight.second;
+        }
+    }
+    return 1;
+}
+
+template<typename EndPoint>
+void Server<EndPoint>::get_queue_stats(
+        std::vector<SchedulerLaneStats>& input_stats,
+        std::vector<SchedulerLaneStats>& output_stats)
+{
+    std::lock_guard<std::mutex> lock(mtx_);
+    input_stats.clear();
+    for (auto& input_scheduler : input_schedulers_)
+    {
+        std::vector<SchedulerLaneStats> shard_stats;
+        input_scheduler->get_stats(shard_stats);
+        for (const auto& lane_stats : shard_stats)
+        {
+            auto it = std::find_if(input_stats.begin(), input_stats.end(),
+                [&lane_stats](const SchedulerLaneStats& stats) { return stats.priority == lane_stats.priority; });
+            if (it == input_stats.end())
+            {
+                input_stats.push_back(lane_stats);
+            }
+            else
+            {
+                it->size += lane_stats.size;
+                it->enqueued += lane_stats.enqueued;
+                it->dropped += lane_stats.dropped;
+                it->high_watermark = std::max(it->high_watermark, lane_stats.high_watermark);
+            }
+        }
+    }
+
+    output_stats.clear();
+    output_scheduler_->get_stats(output_stats);
+}
+
+#ifndef _WIN32
+template<typename EndPoint>
+bool Server<EndPoint>::set_reactor_mode(
+        bool enable)
+{
+    std::lock_guard<std::mutex> lock(mtx_);
+    bool rv = false;
+#ifdef __linux__
+    if (!running_cond_)
+    {
+        reactor_mode_ = enable;
+        rv = true;
+    }
+#else
+    (void) enable;
+#endif
+    return rv;
+}
+#endif
+
 #ifdef UAGENT_DISCOVERY_PROFILE
 template<typename EndPoint>
 bool Server<EndPoint>::enable_discovery(uint16_t discovery_port)
@@ -179,26 +459,39 @@ void Server<EndPoint>::push_output_packet(
 {
     if (output_packet.message)
     {
-        output_scheduler_.push(std::move(output_packet), 0);
+        output_scheduler_->push(std::move(output_packet), 0);
+    }
+}
+
+template<typename EndPoint>
+void Server<EndPoint>::dispatch_input_packet(
+        InputPacket<EndPoint>&& input_packet)
+{
+    PacketScheduler<InputPacket<EndPoint>>& input_scheduler = *input_schedulers_[get_processing_shard(input_packet)];
+    if(input_packet.message->is_valid_xrce_message() && 1U == input_packet.message->count_submessages() && dds::xrce::HEARTBEAT == input_packet.message->get_submessage_id()){
+        input_scheduler.push(std::move(input_packet), 1);
+    }
+    else
+    {
+        input_scheduler.push(std::move(input_packet), 0);
     }
 }
 
 template<typename EndPoint>
 void Server<EndPoint>::receiver_loop()
 {
-    InputPacket<EndPoint> input_packet{};
+    utils::ThreadPolicies::instance().apply(utils::ThreadRole::receiver, "uxr-receiver");
+    std::vector<InputPacket<EndPoint>> input_packets;
     while (running_cond_)
     {
         TransportRc transport_rc = TransportRc::ok;
-        if (recv_message(input_packet, RECEIVE_TIMEOUT, transport_rc))
+        if (recv_message(input_packets, RECEIVE_TIMEOUT, transport_rc))
         {
-            if(input_packet.message->is_valid_xrce_message() && 1U == input_packet.message->count_submessages() && dds::xrce::HEARTBEAT == input_packet.message->get_submessage_id()){
-                input_scheduler_.push(std::move(input_packet), 1);
-            }
-            else
+            for (auto& input_packet : input_packets)
             {
-                input_scheduler_.push(std::move(input_packet), 0);
+                dispatch_input_packet(std::move(input_packet));
             }
+            input_packets.clear();
         }
         else if(running_cond_)
         {
@@ -216,6 +509,7 @@ void Server<EndPoint>::receiver_loop()
 template<>
 void Server<MultiSerialEndPoint>::receiver_loop()
 {
+    utils::ThreadPolicies::instance().apply(utils::ThreadRole::receiver, "uxr-receiver");
     std::vector<InputPacket<MultiSerialEndPoint>> input_packet;
 
     while (running_cond_)
@@ -225,7 +519,8 @@ void Server<MultiSerialEndPoint>::receiver_loop()
         {
             for (auto & element : input_packet)
             {
-                input_scheduler_.push(std::move(element), 0);
+                size_t shard = get_processing_shard(element);
+                input_schedulers_[shard]->push(std::move(element), 0);
             }
         }
         else if(running_cond_)
@@ -243,56 +538,204 @@ void Server<MultiSerialEndPoint>::receiver_loop()
     }
 }
 
+#ifdef __linux__
+template<typename EndPoint>
+void Server<EndPoint>::reactor_loop()
+{
+    utils::ThreadPolicies::instance().apply(utils::ThreadRole::reactor, "uxr-reactor");
+    while (running_cond_)
+    {
+        if (-1 == reactor_->run_once(RECEIVE_TIMEOUT))
+        {
+            reactor_rc_ = TransportRc::server_error;
+        }
+
+        if (running_cond_ && (TransportRc::server_error == reactor_rc_))
+        {
+            /* The transport is reopened by the error handler, so its descriptors change. */
+            reactor_->clear();
+            {
+                std::unique_lock<std::mutex> lock(error_mtx_);
+                transport_rc_ = reactor_rc_;
+                error_cv_.notify_one();
+                error_cv_.wait(lock);
+            }
+            reactor_rc_ = TransportRc::ok;
+            if (running_cond_ && !register_reactor_fds())
+            {
+                reactor_rc_ = TransportRc::server_error;
+            }
+        }
+    }
+}
+
+template<typename EndPoint>
+bool Server<EndPoint>::register_reactor_fds()
+{
+    std::vector<int> fds;
+    if (!get_reactor_fds(fds) || fds.empty())
+    {
+        return false;
+    }
+
+    for (int fd : fds)
+    {
+        if (!reactor_->add(fd, EPOLLIN, [this, fd](uint32_t /* events */) { on_readable(fd); }))
+        {
+            reactor_->clear();
+            return false;
+        }
+    }
+    return true;
+}
+
+template<typename EndPoint>
+void Server<EndPoint>::on_readable(
+        int fd)
+{
+    /* Epoll is level triggered, so whatever is left is reported again in the next round. */
+    std::vector<InputPacket<EndPoint>>& input_packets = reactor_packets_;
+    size_t read_count = 0;
+    while ((read_count < REACTOR_READ_MAX_SIZE) && running_cond_)
+    {
+        TransportRc transport_rc = TransportRc::ok;
+        if (recv_ready_messages(fd, input_packets, transport_rc))
+        {
+            read_count += input_packets.size();
+            for (auto& input_packet : input_packets)
+            {
+                dispatch_input_packet(std::move(input_packet));
+            }
+            input_packets.clear();
+        }
+        else
+        {
+            if (TransportRc::server_error == transport_rc)
+            {
+                reactor_rc_ = transport_rc;
+            }
+            break;
+        }
+    }
+}
+#endif
+
+template<typename EndPoint>
+bool Server<EndPoint>::send_messages(
+        const std::vector<OutputPacket<EndPoint>>& output_packets,
+        size_t& sent_count,
+        TransportRc& transport_rc)
+{
+    sent_count = 0;
+    for (const auto& output_packet : output_packets)
+    {
+        if (!send_message(output_packet, transport_rc))
+        {
+            return false;
+        }
+        ++sent_count;
+    }
+    return true;
+}
+
 template<typename EndPoint>
 void Server<EndPoint>::sender_loop()
 {
-    OutputPacket<EndPoint> output_packet{};
+    utils::ThreadPolicies::instance().apply(utils::ThreadRole::sender, "uxr-sender");
+    std::vector<OutputPacket<EndPoint>> output_packets;
+    output_packets.reserve(SEND_BATCH_MAX_SIZE);
     while (running_cond_)
     {
-        if (output_scheduler_.pop(output_packet))
+        if (output_scheduler_->pop_batch(output_packets, SEND_BATCH_MAX_SIZE))
         {
             TransportRc transport_rc = TransportRc::ok;
-            if (!send_message(output_packet, transport_rc))
+            size_t sent_count = 0;
+            if (!send_messages(output_packets, sent_count, transport_rc))
             {
+                /* The failed packet is discarded unless the server has to recover from the error. */
                 if (TransportRc::server_error == transport_rc && running_cond_)
                 {
                     std::unique_lock<std::mutex> lock(error_mtx_);
                     transport_rc_ = transport_rc;
-                    output_scheduler_.push_front(std::move(output_packet), 0);
+                    for (size_t i = output_packets.size(); i > sent_count; --i)
+                    {
+                        output_scheduler_->push_front(std::move(output_packets[i - 1]), 0);
+                    }
                     error_cv_.notify_one();
                     error_cv_.wait(lock);
                 }
+                else
+                {
+                    for (size_t i = output_packets.size(); i > sent_count + 1; --i)
+                    {
+                        output_scheduler_->push_front(std::move(output_packets[i - 1]), 0);
+                    }
+                }
             }
+            output_packets.clear();
         }
     }
 }
 
 template<typename EndPoint>
-void Server<EndPoint>::processing_loop()
+void Server<EndPoint>::processing_loop(
+        size_t shard)
 {
+    utils::ThreadPolicies::instance().apply(utils::ThreadRole::processing, "uxr-proc-" + std::to_string(shard));
+    PacketScheduler<InputPacket<EndPoint>>& input_scheduler = *input_schedulers_[shard];
     InputPacket<EndPoint> input_packet;
     while (running_cond_)
     {
-        if (input_scheduler_.pop(input_packet))
+        if (input_scheduler.pop(input_packet))
         {
             processor_->process_input_packet(std::move(input_packet));
         }
     }
 }
 
+template<typename EndPoint>
+size_t Server<EndPoint>::get_processing_shard(
+        const InputPacket<EndPoint>& input_packet)
+{
+    size_t shard = 0;
+    if (1 < input_schedulers_.size())
+    {
+        /*
+         * Sessions with client key in the header are routed by it. Otherwise the client key is
+         * obtained from the source endpoint; unknown sources (e.g. CREATE_CLIENT or pings) go to
+         * the first processing thread, the session is established there before the client sends
+         * any in-session message.
+         */
+        uint32_t raw_client_key = 0;
+        const dds::xrce::MessageHeader& header = input_packet.message->get_header();
+        if (has_session_client_key(header.session_id()))
+        {
+            raw_client_key = conversion::clientkey_to_raw(header.client_key());
+        }
+        else
+        {
+            this->get_client_key(input_packet.source, raw_client_key);
+        }
+        shard = raw_client_key % input_schedulers_.size();
+    }
+    return shard;
+}
+
 template<typename EndPoint>
 void Server<EndPoint>::heartbeat_loop()
 {
+    utils::ThreadPolicies::instance().apply(utils::ThreadRole::heartbeat, "uxr-heartbeat");
     while (running_cond_)
     {
         processor_->check_heartbeats();
-        std::this_thread::sleep_for(std::chrono::milliseconds(HEARTBEAT_PERIOD));
+        std::this_thread::sleep_for(processor_->get_heartbeat_resolution());
     }
 }
 
 template<typename EndPoint>
 void Server<EndPoint>::error_handler_loop()
 {
+    utils::ThreadPolicies::instance().apply(utils::ThreadRole::error_handler, "uxr-error");
     while (running_cond_)
     {
         std::unique_lock<std::mutex> lock(error_mtx_);
@@ -17,6 +17,7 @@
 #include <uxr/agent/logger/Logger.hpp>
 
 #include <unistd.h>
+#include <cerrno>
 
 #include <net/if.h>
 #include <sys/ioctl.h>
@@ -152,46 +153,65 @@ bool CanAgent::recv_message(
         TransportRc& transport_rc)
 {
     bool rv = false;
-    struct canfd_frame frame = {};
-
     int poll_rv = poll(&poll_fd_, 1, timeout);
 
     if (0 < poll_rv)
     {
-        if (0 < read(poll_fd_.fd, &frame, sizeof(struct canfd_frame)))
-        {
-            // Omit EFF, RTR, ERR flags (Assume EFF on CAN FD)
-            uint32_t can_id = frame.can_id & CAN_ERR_MASK;
-            size_t len = frame.data[0];   // XRCE payload lenght
+        rv = recv_ready_message(poll_fd_.fd, input_packet, transport_rc);
+    }
+    else
+    {
+        transport_rc = (poll_rv == 0) ? TransportRc::timeout_error : TransportRc::server_error;
+    }
 
-            if (len > (CANFD_MTU - 1))
-            {
-                // Overflow MTU (63 bytes)
-                return false;
-            }
+    return rv;
+}
 
-            input_packet.message.reset(new InputMessage(&frame.data[1], len));
-            input_packet.source = CanEndPoint(can_id);
-            rv = true;
+bool CanAgent::get_reactor_fds(
+        std::vector<int>& fds)
+{
+    fds.assign(1, poll_fd_.fd);
+    return -1 != poll_fd_.fd;
+}
 
-            uint32_t raw_client_key;
-            if (Server<CanEndPoint>::get_client_key(input_packet.source, raw_client_key))
-            {
-                UXR_AGENT_LOG_MESSAGE(
-                    UXR_DECORATE_YELLOW("[==>> CAN <<==]"),
-                    raw_client_key,
-                    input_packet.message->get_buf(),
-                    input_packet.message->get_len());
-            }
+bool CanAgent::recv_ready_message(
+        int fd,
+        InputPacket<CanEndPoint>& input_packet,
+        TransportRc& transport_rc)
+{
+    bool rv = false;
+    struct canfd_frame frame = {};
+
+    if (0 < recv(fd, &frame, sizeof(struct canfd_frame), MSG_DONTWAIT))
+    {
+        // Omit EFF, RTR, ERR flags (Assume EFF on CAN FD)
+        uint32_t can_id = frame.can_id & CAN_ERR_MASK;
+        size_t len = frame.data[0];   // XRCE payload lenght
+
+        if (len > (CANFD_MTU - 1))
+        {
+            // Overflow MTU (63 bytes)
+            return false;
         }
-        else
+
+        input_packet.message.reset(new InputMessage(&frame.data[1], len, get_input_buffer_pool()));
+        input_packet.source = CanEndPoint(can_id);
+        rv = true;
+
+        uint32_t raw_client_key;
+        if (Server<CanEndPoint>::get_client_key(input_packet.source, raw_client_key))
         {
-            transport_rc = TransportRc::server_error;
+            UXR_AGENT_LOG_MESSAGE(
+                UXR_DECORATE_YELLOW("[==>> CAN <<==]"),
+                raw_client_key,
+                input_packet.message->get_buf(),
+                input_packet.message->get_len());
         }
     }
     else
     {
-        transport_rc = (poll_rv == 0) ? TransportRc::timeout_error : TransportRc::server_error;
+        transport_rc = ((EAGAIN == errno) || (EWOULDBLOCK == errno)) ?
+            TransportRc::timeout_error : TransportRc::server_error;
     }
 
     return rv;
@@ -211,7 +211,7 @@ bool CustomAgent::recv_message(
 
             input_packet.message.reset(
                 new eprosima::uxr::InputMessage(
-                    buffer_, static_cast<size_t>(recv_bytes)));
+                    buffer_, static_cast<size_t>(recv_bytes), get_input_buffer_pool()));
             input_packet.source = *recv_endpoint_;
 
             uint32_t raw_client_key = 0u;
@@ -14,6 +14,7 @@
 
 #include <uxr/agent/transport/discovery/DiscoveryServer.hpp>
 #include <uxr/agent/processor/Processor.hpp>
+#include <uxr/agent/config.hpp>
 
 #include <functional>
 
@@ -57,11 +58,16 @@ void DiscoveryServer<EndPoint>::discovery_loop()
 {
     InputPacket<IPv4EndPoint> input_packet;
     OutputPacket<IPv4EndPoint> output_packet;
+
+    /* The addresses are only set before the loop starts, and so is the reply advertising them. */
+    const InfoReply info_reply = processor_.get_info_reply(transport_addresses_);
+    utils::RateLimiter<IPv4EndPoint> info_limiter(INFO_RATE, INFO_BURST, INFO_MAX_SOURCES);
+
     while (running_cond_)
     {
-        if (recv_message(input_packet, RECEIVE_TIMEOUT))
+        if (recv_message(input_packet, RECEIVE_TIMEOUT) && info_limiter.allow(input_packet.source))
         {
-            if (processor_.process_get_info_packet(std::move(input_packet), transport_addresses_, output_packet))
+            if (processor_.process_get_info_packet(std::move(input_packet), info_reply, output_packet))
             {
                 send_message(std::move(output_packet));
             }
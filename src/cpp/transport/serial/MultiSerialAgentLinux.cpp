@@ -105,7 +105,7 @@ bool MultiSerialAgent::recv_message(
                 if (0 < bytes_read)
                 {
                     struct InputPacket<MultiSerialEndPoint> aux_pack{};
-                    aux_pack.message.reset(new InputMessage(buffer_, static_cast<size_t>(bytes_read)));
+                    aux_pack.message.reset(new InputMessage(buffer_, static_cast<size_t>(bytes_read), get_input_buffer_pool()));
                     aux_pack.source = MultiSerialEndPoint(it->first, remote_addr);
                     rv = true;
 
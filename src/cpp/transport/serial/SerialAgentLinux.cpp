@@ -97,7 +97,7 @@ bool SerialAgent::recv_message(
 
     if (0 < bytes_read)
     {
-        input_packet.message.reset(new InputMessage(buffer_, static_cast<size_t>(bytes_read)));
+        input_packet.message.reset(new InputMessage(buffer_, static_cast<size_t>(bytes_read), get_input_buffer_pool()));
         input_packet.source = SerialEndPoint(remote_addr);
         rv = true;
 
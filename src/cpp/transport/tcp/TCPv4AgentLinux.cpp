@@ -19,11 +19,13 @@
 
 #include <sys/types.h>
 #include <sys/socket.h>
+#include <sys/uio.h>
 #include <arpa/inet.h>
 #include <string.h>
 #include <unistd.h>
 #include <errno.h>
 #include <signal.h>
+#include <algorithm>
 #include <functional>
 
 namespace eprosima {
@@ -277,18 +279,25 @@ bool TCPv4Agent::send_message(
 
         msg_size_buf[0] = uint8_t(0x00FF & output_packet.message->get_len());
         msg_size_buf[1] = uint8_t((0xFF00 & output_packet.message->get_len()) >> 8);
-        uint8_t n_attemps = 0;
-        uint16_t bytes_sent = 0;
 
-        /* Send message size. */
-        bool size_sent = false;
+        /* Send the message size, the serialized part and the payload segment with a single call. */
+        std::array<struct iovec, 3> iov;
+        iov[0].iov_base = msg_size_buf;
+        iov[0].iov_len = sizeof(msg_size_buf);
+        iov[1].iov_base = const_cast<uint8_t*>(output_packet.message->get_head_buf());
+        iov[1].iov_len = output_packet.message->get_head_len();
+        iov[2].iov_base = const_cast<uint8_t*>(output_packet.message->get_payload_buf());
+        iov[2].iov_len = output_packet.message->get_payload_len();
+
+        const size_t total_len = sizeof(msg_size_buf) + output_packet.message->get_len();
+        size_t bytes_sent = 0;
+        uint8_t n_attemps = 0;
         do
         {
-            size_t send_rv = send_data(connection, msg_size_buf, 2, transport_rc);
+            size_t send_rv = send_segments(connection, iov, transport_rc);
             if (0 < send_rv)
             {
-                bytes_sent += uint16_t(send_rv);
-                size_sent = (bytes_sent == 2);
+                bytes_sent += send_rv;
             }
             else
             {
@@ -299,38 +308,8 @@ bool TCPv4Agent::send_message(
             }
             ++n_attemps;
         }
-        while (!size_sent && n_attemps < max_attemps);
-
-        /* Send message payload. */
-        bool payload_sent = false;
-        if (size_sent)
-        {
-            n_attemps = 0;
-            bytes_sent = 0;
-            do
-            {
-                size_t send_rv =
-                    send_data(
-                        connection,
-                        output_packet.message->get_buf() + bytes_sent,
-                        output_packet.message->get_len() - bytes_sent,
-                        transport_rc);
-                if (0 < send_rv)
-                {
-                    bytes_sent += uint16_t(send_rv);
-                    payload_sent = (bytes_sent == uint16_t(output_packet.message->get_len()));
-                }
-                else
-                {
-                    if (TransportRc::ok != transport_rc)
-                    {
-                        break;
-                    }
-                }
-                ++n_attemps;
-            }
-            while (!payload_sent && n_attemps < max_attemps);
-        }
+        while (bytes_sent < total_len && n_attemps < 2 * max_attemps);
+        bool payload_sent = (bytes_sent == total_len);
 
         if (payload_sent)
         {
@@ -338,11 +317,13 @@ bool TCPv4Agent::send_message(
 
             uint32_t raw_client_key = 0u;
             Server<IPv4EndPoint>::get_client_key(output_packet.destination, raw_client_key);
-            UXR_AGENT_LOG_MESSAGE(
+            UXR_AGENT_LOG_SEGMENTED_MESSAGE(
                 UXR_DECORATE_YELLOW("[** <<TCP>> **]"),
                 raw_client_key,
-                output_packet.message->get_buf(),
-                output_packet.message->get_len());
+                output_packet.message->get_head_buf(),
+                output_packet.message->get_head_len(),
+                output_packet.message->get_payload_buf(),
+                output_packet.message->get_payload_len());
         }
 
         if (TransportRc::connection_error == transport_rc)
@@ -445,7 +426,7 @@ bool TCPv4Agent::read_message(
                     if (0 < bytes_read)
                     {
                         InputPacket<IPv4EndPoint> input_packet;
-                        input_packet.message.reset(new InputMessage(conn.input_buffer.buffer.data(), bytes_read));
+                        input_packet.message.reset(new InputMessage(conn.input_buffer.buffer.data(), bytes_read, get_input_buffer_pool()));
                         input_packet.source = conn.endpoint;
                         messages_queue_.push(std::move(input_packet));
                         rv = true;
@@ -572,5 +553,45 @@ size_t TCPv4Agent::send_data(
     return rv;
 }
 
+size_t TCPv4Agent::send_segments(
+        TCPv4ConnectionLinux& connection,
+        std::array<struct iovec, 3>& iov,
+        TransportRc& transport_rc)
+{
+    size_t rv = 0;
+    std::lock_guard<std::mutex> lock(connection.mtx);
+    if (connection.active)
+    {
+        struct msghdr msg{};
+        msg.msg_iov = iov.data();
+        msg.msg_iovlen = iov.size();
+        ssize_t bytes_sent = sendmsg(connection.poll_fd->fd, &msg, 0);
+        if (-1 != bytes_sent)
+        {
+            rv = size_t(bytes_sent);
+            transport_rc = TransportRc::ok;
+
+            /* Skip what has been sent, so that a retry resumes from there. */
+            size_t remaining = rv;
+            for (struct iovec& segment : iov)
+            {
+                size_t consumed = std::min(remaining, segment.iov_len);
+                segment.iov_base = static_cast<uint8_t*>(segment.iov_base) + consumed;
+                segment.iov_len -= consumed;
+                remaining -= consumed;
+            }
+        }
+        else
+        {
+            transport_rc = TransportRc::connection_error;
+        }
+    }
+    else
+    {
+        transport_rc = TransportRc::connection_error;
+    }
+    return rv;
+}
+
 } // namespace uxr
 } // namespace eprosima
@@ -414,7 +414,7 @@ bool TCPv6Agent::read_message(
                     if (0 < bytes_read)
                     {
                         InputPacket<IPv6EndPoint> input_packet;
-                        input_packet.message.reset(new InputMessage(conn.input_buffer.buffer.data(), bytes_read));
+                        input_packet.message.reset(new InputMessage(conn.input_buffer.buffer.data(), bytes_read, get_input_buffer_pool()));
                         input_packet.source = conn.endpoint;
                         messages_queue_.push(std::move(input_packet));
                         rv = true;
@@ -20,11 +20,17 @@
 #include <unistd.h>
 #include <sys/types.h>
 #include <sys/socket.h>
+#include <sys/uio.h>
 #include <netinet/in.h>
 #include <arpa/inet.h>
 #include <cstring>
 #include <cerrno>
 
+/* Datagrams up to this size are received straight into a pooled buffer. */
+#define UDP_POOLED_RECV_SIZE 4096
+#define UDP_RECV_BATCH_SIZE 16
+#define UDP_SEND_BATCH_SIZE 32
+
 namespace eprosima {
 namespace uxr {
 
@@ -38,7 +44,8 @@ UDPv4Agent::UDPv4Agent(
         Middleware::Kind middleware_kind)
     : Server<IPv4EndPoint>{middleware_kind}
     , poll_fd_{-1, 0, 0}
-    , buffer_{0}
+    , receiver_{UDP_RECV_BATCH_SIZE, UDP_POOLED_RECV_SIZE, SERVER_BUFFER_SIZE}
+    , sender_{UDP_SEND_BATCH_SIZE}
     , agent_port_{agent_port}
 #ifdef UAGENT_DISCOVERY_PROFILE
     , discovery_server_{*processor_}
@@ -177,39 +184,36 @@ bool UDPv4Agent::recv_message(
         TransportRc& transport_rc)
 {
     bool rv = false;
-    struct sockaddr_in client_addr{};
-    socklen_t client_addr_len = sizeof(struct sockaddr_in);
-
     int poll_rv = poll(&poll_fd_, 1, timeout);
     if (0 < poll_rv)
     {
-        ssize_t bytes_received =
-                recvfrom(poll_fd_.fd,
-                         buffer_,
-                         sizeof(buffer_),
-                         0,
-                         reinterpret_cast<struct sockaddr*>(&client_addr),
-                         &client_addr_len);
-        if (-1 != bytes_received)
-        {
-            input_packet.message.reset(new InputMessage(buffer_, size_t(bytes_received)));
-            uint32_t addr = client_addr.sin_addr.s_addr;
-            uint16_t port = client_addr.sin_port;
-            input_packet.source = IPv4EndPoint(addr, port);
-            rv = true;
+        rv = recv_ready_message(poll_fd_.fd, input_packet, transport_rc);
+    }
+    else
+    {
+        transport_rc = (0 == poll_rv) ? TransportRc::timeout_error : TransportRc::server_error;
+    }
 
-            uint32_t raw_client_key = 0u;
-            Server<IPv4EndPoint>::get_client_key(input_packet.source, raw_client_key);
-            UXR_AGENT_LOG_MESSAGE(
-                UXR_DECORATE_YELLOW("[==>> UDP <<==]"),
-                raw_client_key,
-                input_packet.message->get_buf(),
-                input_packet.message->get_len());
-        }
-        else
-        {
-            transport_rc = TransportRc::server_error;
-        }
+    return rv;
+}
+
+bool UDPv4Agent::get_reactor_fds(
+        std::vector<int>& fds)
+{
+    fds.assign(1, poll_fd_.fd);
+    return -1 != poll_fd_.fd;
+}
+
+bool UDPv4Agent::recv_message(
+        std::vector<InputPacket<IPv4EndPoint>>& input_packets,
+        int timeout,
+        TransportRc& transport_rc)
+{
+    bool rv = false;
+    int poll_rv = poll(&poll_fd_, 1, timeout);
+    if (0 < poll_rv)
+    {
+        rv = recv_ready_messages(poll_fd_.fd, input_packets, transport_rc);
     }
     else
     {
@@ -219,6 +223,66 @@ bool UDPv4Agent::recv_message(
     return rv;
 }
 
+bool UDPv4Agent::recv_ready_message(
+        int fd,
+        InputPacket<IPv4EndPoint>& input_packet,
+        TransportRc& transport_rc)
+{
+    const int received = receiver_.receive(fd, *get_input_buffer_pool(), 1,
+        [&](BufferPool::Buffer&& buffer, size_t len, const struct sockaddr_in& source)
+        {
+            set_input_packet(std::move(buffer), len, source, input_packet);
+        });
+
+    if (-1 == received)
+    {
+        transport_rc = ((EAGAIN == errno) || (EWOULDBLOCK == errno)) ?
+            TransportRc::timeout_error : TransportRc::server_error;
+    }
+
+    return 0 < received;
+}
+
+bool UDPv4Agent::recv_ready_messages(
+        int fd,
+        std::vector<InputPacket<IPv4EndPoint>>& input_packets,
+        TransportRc& transport_rc)
+{
+    /* The datagrams already queued are read at once, up to a batch, with a single recvmmsg on Linux. */
+    const int received = receiver_.receive(fd, *get_input_buffer_pool(), UDP_RECV_BATCH_SIZE,
+        [&](BufferPool::Buffer&& buffer, size_t len, const struct sockaddr_in& source)
+        {
+            input_packets.emplace_back();
+            set_input_packet(std::move(buffer), len, source, input_packets.back());
+        });
+
+    if (-1 == received)
+    {
+        transport_rc = ((EAGAIN == errno) || (EWOULDBLOCK == errno)) ?
+            TransportRc::timeout_error : TransportRc::server_error;
+    }
+
+    return 0 < received;
+}
+
+void UDPv4Agent::set_input_packet(
+        BufferPool::Buffer&& buffer,
+        size_t len,
+        const struct sockaddr_in& source,
+        InputPacket<IPv4EndPoint>& input_packet)
+{
+    input_packet.message.reset(new InputMessage(std::move(buffer), len));
+    input_packet.source = IPv4EndPoint(source.sin_addr.s_addr, source.sin_port);
+
+    uint32_t raw_client_key = 0u;
+    Server<IPv4EndPoint>::get_client_key(input_packet.source, raw_client_key);
+    UXR_AGENT_LOG_MESSAGE(
+        UXR_DECORATE_YELLOW("[==>> UDP <<==]"),
+        raw_client_key,
+        input_packet.message->get_buf(),
+        input_packet.message->get_len());
+}
+
 bool UDPv4Agent::send_message(
         OutputPacket<IPv4EndPoint> output_packet,
         TransportRc& transport_rc)
@@ -231,14 +295,20 @@ bool UDPv4Agent::send_message(
     client_addr.sin_port = output_packet.destination.get_port();
     client_addr.sin_addr.s_addr = output_packet.destination.get_addr();
 
-    ssize_t bytes_sent =
-        sendto(
-            poll_fd_.fd,
-            output_packet.message->get_buf(),
-            output_packet.message->get_len(),
-            0,
-            reinterpret_cast<struct sockaddr*>(&client_addr),
-            sizeof(client_addr));
+    /* The serialized part and the payload segment are gathered by the kernel. */
+    struct iovec iov[2];
+    iov[0].iov_base = const_cast<uint8_t*>(output_packet.message->get_head_buf());
+    iov[0].iov_len = output_packet.message->get_head_len();
+    iov[1].iov_base = const_cast<uint8_t*>(output_packet.message->get_payload_buf());
+    iov[1].iov_len = output_packet.message->get_payload_len();
+
+    struct msghdr msg{};
+    msg.msg_name = &client_addr;
+    msg.msg_namelen = sizeof(client_addr);
+    msg.msg_iov = iov;
+    msg.msg_iovlen = 2;
+
+    ssize_t bytes_sent = sendmsg(poll_fd_.fd, &msg, 0);
     if (-1 != bytes_sent)
     {
         if (size_t(bytes_sent) == output_packet.message->get_len())
@@ -246,11 +316,13 @@ bool UDPv4Agent::send_message(
             rv = true;
             uint32_t raw_client_key = 0u;
             Server<IPv4EndPoint>::get_client_key(output_packet.destination, raw_client_key);
-            UXR_AGENT_LOG_MESSAGE(
+            UXR_AGENT_LOG_SEGMENTED_MESSAGE(
                 UXR_DECORATE_YELLOW("[** <<UDP>> **]"),
                 raw_client_key,
-                output_packet.message->get_buf(),
-                output_packet.message->get_len());
+                output_packet.message->get_head_buf(),
+                output_packet.message->get_head_len(),
+                output_packet.message->get_payload_buf(),
+                output_packet.message->get_payload_len());
         }
     }
     else
@@ -261,6 +333,67 @@ bool UDPv4Agent::send_message(
     return rv;
 }
 
+bool UDPv4Agent::send_messages(
+        const std::vector<OutputPacket<IPv4EndPoint>>& output_packets,
+        size_t& sent_count,
+        TransportRc& transport_rc)
+{
+    sent_count = 0;
+    while (sent_count < output_packets.size())
+    {
+        /* The serialized parts and the payload segments of a batch are gathered, by a single sendmmsg on Linux. */
+        sender_.clear();
+        for (size_t i = sent_count; (i < output_packets.size()) && !sender_.full(); ++i)
+        {
+            const OutputPacket<IPv4EndPoint>& output_packet = output_packets[i];
+            const IPv4EndPoint& destination = output_packet.destination;
+            struct sockaddr_in client_addr{};
+            client_addr.sin_family = AF_INET;
+            client_addr.sin_port = destination.get_port();
+            client_addr.sin_addr.s_addr = destination.get_addr();
+
+            sender_.push(
+                client_addr,
+                output_packet.message->get_head_buf(),
+                output_packet.message->get_head_len(),
+                output_packet.message->get_payload_buf(),
+                output_packet.message->get_payload_len());
+        }
+
+        size_t first = 0;
+        while (first < sender_.size())
+        {
+            const int sent = sender_.send(poll_fd_.fd, first);
+            if (-1 == sent)
+            {
+                transport_rc = TransportRc::server_error;
+                return false;
+            }
+
+            for (int i = 0; i < sent; ++i, ++first)
+            {
+                if (!sender_.is_complete(first))
+                {
+                    return false;
+                }
+
+                const OutputPacket<IPv4EndPoint>& output_packet = output_packets[sent_count++];
+                uint32_t raw_client_key = 0u;
+                Server<IPv4EndPoint>::get_client_key(output_packet.destination, raw_client_key);
+                UXR_AGENT_LOG_SEGMENTED_MESSAGE(
+                    UXR_DECORATE_YELLOW("[** <<UDP>> **]"),
+                    raw_client_key,
+                    output_packet.message->get_head_buf(),
+                    output_packet.message->get_head_len(),
+                    output_packet.message->get_payload_buf(),
+                    output_packet.message->get_payload_len());
+            }
+        }
+    }
+
+    return true;
+}
+
 bool UDPv4Agent::handle_error(
         TransportRc /*transport_rc*/)
 {
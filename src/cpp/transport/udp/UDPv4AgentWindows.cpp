@@ -166,7 +166,7 @@ bool UDPv4Agent::recv_message(
                 &client_addr_len);
         if (SOCKET_ERROR != bytes_received)
         {
-            input_packet.message.reset(new InputMessage(buffer_, size_t(bytes_received)));
+            input_packet.message.reset(new InputMessage(buffer_, size_t(bytes_received), get_input_buffer_pool()));
             uint32_t addr = client_addr.sin_addr.s_addr;
             uint16_t port = client_addr.sin_port;
             input_packet.source = IPv4EndPoint(addr, port);
@@ -167,7 +167,7 @@ bool UDPv6Agent::recv_message(
                 &client_addr_len);
         if (SOCKET_ERROR != bytes_received)
         {
-            input_packet.message.reset(new InputMessage(buffer_, size_t(bytes_received)));
+            input_packet.message.reset(new InputMessage(buffer_, size_t(bytes_received), get_input_buffer_pool()));
             std::array<uint8_t, 16> addr{};
             std::copy(std::begin(client_addr.sin6_addr.s6_addr), std::end(client_addr.sin6_addr.s6_addr), addr.begin());
             input_packet.source = IPv6EndPoint(addr, client_addr.sin6_port);
@@ -27,15 +27,15 @@ TopicPubSubType::TopicPubSubType(bool with_key) {
 bool TopicPubSubType::serialize(void *data, rtps::SerializedPayload_t *payload)
 {
     bool rv = false;
-    std::vector<unsigned char>* buffer = reinterpret_cast<std::vector<unsigned char>*>(data);
+    const type* sample = reinterpret_cast<const type*>(data);
     payload->data[0] = 0;
     payload->data[1] = 1;
     payload->data[2] = 0;
     payload->data[3] = 0;
-    if (buffer->size() <= (payload->max_size - 4))
+    if (sample->size() <= (payload->max_size - 4))
     {
-        memcpy(&payload->data[4], buffer->data(), buffer->size());
-        payload->length = uint32_t(buffer->size() + 4); //Get the serialized length
+        memcpy(&payload->data[4], sample->data(), sample->size());
+        payload->length = uint32_t(sample->size() + 4); //Get the serialized length
         rv = true;
     }
     return rv;
@@ -43,8 +43,8 @@ bool TopicPubSubType::serialize(void *data, rtps::SerializedPayload_t *payload)
 
 bool TopicPubSubType::deserialize(rtps::SerializedPayload_t* payload, void* data)
 {
-    std::vector<unsigned char>* buffer = reinterpret_cast<std::vector<unsigned char>*>(data);
-    buffer->assign(payload->data + 4, payload->data + payload->length);
+    type* sample = reinterpret_cast<type*>(data);
+    sample->assign(payload->data + 4, payload->data + payload->length);
 
     return true;
 }
@@ -52,16 +52,16 @@ bool TopicPubSubType::deserialize(rtps::SerializedPayload_t* payload, void* data
 std::function<uint32_t()> TopicPubSubType::getSerializedSizeProvider(void* data) {
     return [data]() -> uint32_t
     {
-        return (uint32_t)reinterpret_cast<std::vector<unsigned char>*>(data)->size() + 4 /*encapsulation*/;
+        return (uint32_t)reinterpret_cast<const type*>(data)->size() + 4 /*encapsulation*/;
     };
 }
 
 void* TopicPubSubType::createData() {
-    return (void*)new std::vector<unsigned char>;
+    return (void*)new type;
 }
 
 void TopicPubSubType::deleteData(void* data) {
-    delete((std::vector<unsigned char>*)data);
+    delete((type*)data);
 }
 
 bool TopicPubSubType::getKey(void *data, rtps::InstanceHandle_t* handle, bool force_md5)
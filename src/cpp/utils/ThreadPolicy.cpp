@@ -0,0 +1,303 @@
+// Copyright 2018 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <uxr/agent/utils/ThreadPolicy.hpp>
+#include <uxr/agent/logger/Logger.hpp>
+
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <unordered_map>
+
+#ifndef _WIN32
+#include <pthread.h>
+#include <sched.h>
+#endif // _WIN32
+
+#define THREAD_NAME_MAX_LEN 15
+
+namespace eprosima {
+namespace uxr {
+namespace utils {
+
+namespace {
+
+bool parse_number(
+        const std::string& str,
+        long min,
+        long max,
+        long& value)
+{
+    if (str.empty() || (std::string::npos != str.find_first_not_of("0123456789")))
+    {
+        return false;
+    }
+    value = std::strtol(str.c_str(), nullptr, 10);
+    return (min <= value) && (value <= max);
+}
+
+bool parse_cpus(
+        const std::string& str,
+        std::vector<uint16_t>& cpus)
+{
+    std::stringstream ss(str);
+    std::string item;
+    while (std::getline(ss, item, ','))
+    {
+        long first;
+        long last;
+        size_t dash = item.find('-');
+        if (std::string::npos == dash)
+        {
+            if (!parse_number(item, 0, UINT16_MAX, first))
+            {
+                return false;
+            }
+            last = first;
+        }
+        else if (!parse_number(item.substr(0, dash), 0, UINT16_MAX, first) ||
+                 !parse_number(item.substr(dash + 1), first, UINT16_MAX, last))
+        {
+            return false;
+        }
+
+        for (long cpu = first; cpu <= last; ++cpu)
+        {
+            cpus.push_back(uint16_t(cpu));
+        }
+    }
+    return !cpus.empty();
+}
+
+bool parse_entry(
+        const std::string& entry,
+        ThreadRole& role,
+        ThreadPolicy& policy)
+{
+    static const std::unordered_map<std::string, ThreadRole> roles = {
+        {"receiver", ThreadRole::receiver},
+        {"sender", ThreadRole::sender},
+        {"processing", ThreadRole::processing},
+        {"heartbeat", ThreadRole::heartbeat},
+        {"error", ThreadRole::error_handler},
+        {"reactor", ThreadRole::reactor},
+        {"reader", ThreadRole::reader},
+        {"p2p", ThreadRole::internal_client},
+    };
+
+    std::stringstream ss(entry);
+    std::string field;
+    std::getline(ss, field, ':');
+    auto it = roles.find(field);
+    if (roles.end() == it)
+    {
+        return false;
+    }
+    role = it->second;
+
+    policy = ThreadPolicy{};
+    while (std::getline(ss, field, ':'))
+    {
+        size_t equal = field.find('=');
+        if (std::string::npos == equal)
+        {
+            return false;
+        }
+
+        const std::string key = field.substr(0, equal);
+        const std::string value = field.substr(equal + 1);
+        long priority;
+        if ("cpus" == key)
+        {
+            if (!parse_cpus(value, policy.cpus))
+            {
+                return false;
+            }
+        }
+        else if ("fifo" == key && parse_number(value, 1, 99, priority))
+        {
+            policy.priority = int(priority);
+        }
+        else
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::string trim(
+        const std::string& str)
+{
+    const char* whitespaces = " \t\r\n";
+    size_t first = str.find_first_not_of(whitespaces);
+    if (std::string::npos == first)
+    {
+        return std::string();
+    }
+    return str.substr(first, str.find_last_not_of(whitespaces) - first + 1);
+}
+
+} // unnamed namespace
+
+ThreadPolicies& ThreadPolicies::instance()
+{
+    static ThreadPolicies thread_policies;
+    return thread_policies;
+}
+
+void ThreadPolicies::set(
+        ThreadRole role,
+        const ThreadPolicy& policy)
+{
+    std::lock_guard<std::mutex> lock(mtx_);
+    policies_[size_t(role)] = policy;
+}
+
+ThreadPolicy ThreadPolicies::get(
+        ThreadRole role)
+{
+    std::lock_guard<std::mutex> lock(mtx_);
+    return policies_[size_t(role)];
+}
+
+void ThreadPolicies::reset()
+{
+    std::lock_guard<std::mutex> lock(mtx_);
+    policies_.fill(ThreadPolicy{});
+}
+
+bool ThreadPolicies::parse(
+        const std::string& spec)
+{
+    std::vector<std::pair<ThreadRole, ThreadPolicy>> entries;
+    std::string normalized = spec;
+    for (char& c : normalized)
+    {
+        c = ('\n' == c) ? ';' : c;
+    }
+
+    std::stringstream ss(normalized);
+    std::string entry;
+    while (std::getline(ss, entry, ';'))
+    {
+        entry = trim(entry.substr(0, entry.find('#')));
+        if (entry.empty())
+        {
+            continue;
+        }
+
+        ThreadRole role;
+        ThreadPolicy policy;
+        if (!parse_entry(entry, role, policy))
+        {
+            UXR_AGENT_LOG_ERROR(
+                UXR_DECORATE_RED("invalid thread policy"),
+                "entry: {}",
+                entry);
+            return false;
+        }
+        entries.emplace_back(role, policy);
+    }
+
+    for (const auto& element : entries)
+    {
+        set(element.first, element.second);
+    }
+    return true;
+}
+
+bool ThreadPolicies::load_file(
+        const std::string& file_path)
+{
+    std::ifstream file(file_path);
+    if (!file.is_open())
+    {
+        return false;
+    }
+
+    std::stringstream ss;
+    ss << file.rdbuf();
+    return parse(ss.str());
+}
+
+bool ThreadPolicies::apply(
+        ThreadRole role,
+        const std::string& name)
+{
+    bool rv = true;
+#ifndef _WIN32
+    const ThreadPolicy policy = get(role);
+    pthread_t thread = pthread_self();
+
+#if defined(__linux__)
+    pthread_setname_np(thread, name.substr(0, THREAD_NAME_MAX_LEN).c_str());
+#elif defined(__APPLE__)
+    pthread_setname_np(name.substr(0, THREAD_NAME_MAX_LEN).c_str());
+#endif // __linux__
+
+    if (!policy.cpus.empty())
+    {
+#ifdef __linux__
+        cpu_set_t cpu_set;
+        CPU_ZERO(&cpu_set);
+        for (uint16_t cpu : policy.cpus)
+        {
+            if (CPU_SETSIZE > cpu)
+            {
+                CPU_SET(cpu, &cpu_set);
+            }
+        }
+        int errcode = pthread_setaffinity_np(thread, sizeof(cpu_set), &cpu_set);
+        if (0 != errcode)
+        {
+            rv = false;
+            UXR_AGENT_LOG_WARN(
+                UXR_DECORATE_YELLOW("thread affinity error"),
+                "thread: {}, errno: {}",
+                name, errcode);
+        }
+#else
+        rv = false;
+        UXR_AGENT_LOG_WARN(
+            UXR_DECORATE_YELLOW("thread affinity not supported"),
+            "thread: {}",
+            name);
+#endif // __linux__
+    }
+
+    if (0 < policy.priority)
+    {
+        struct sched_param param{};
+        param.sched_priority = policy.priority;
+        int errcode = pthread_setschedparam(thread, SCHED_FIFO, &param);
+        if (0 != errcode)
+        {
+            rv = false;
+            UXR_AGENT_LOG_WARN(
+                UXR_DECORATE_YELLOW("thread scheduling error"),
+                "thread: {}, priority: {}, errno: {}",
+                name, policy.priority, errcode);
+        }
+    }
+#else
+    (void) role;
+    (void) name;
+#endif // _WIN32
+    return rv;
+}
+
+} // namespace utils
+} // namespace uxr
+} // namespace eprosima
@@ -14,6 +14,7 @@
 
 
 #include <uxr/agent/client/session/stream/InputStream.hpp>
+#include <uxr/agent/message/OutputMessage.hpp>
 #include <map>
 #include <queue>
 #include <mutex>
@@ -290,6 +291,28 @@ TEST_F(ReliableInputStreamTest, BorderCases)
     ASSERT_TRUE(reliable_stream_.emplace_message(RELIABLE_STREAM_DEPTH - 1, buf, sizeof(buf)));
 }
 
+TEST_F(ReliableInputStreamTest, NegotiatedDepth)
+{
+    uint8_t buf[128] = {0};
+    const uint16_t depth = 4 * RELIABLE_STREAM_DEPTH;
+    ReliableInputStream reliable_stream(depth);
+
+    ASSERT_FALSE(reliable_stream.emplace_message(depth, buf, sizeof(buf)));
+    ASSERT_TRUE(reliable_stream.emplace_message(depth - 1, buf, sizeof(buf)));
+
+    InputMessagePtr input_message;
+    ASSERT_FALSE(reliable_stream.pop_message(input_message));
+    for (uint16_t i = 0; i < depth - 1; ++i)
+    {
+        ASSERT_TRUE(reliable_stream.emplace_message(i, buf, sizeof(buf)));
+    }
+    for (uint16_t i = 0; i < depth; ++i)
+    {
+        ASSERT_TRUE(reliable_stream.pop_message(input_message));
+    }
+    ASSERT_FALSE(reliable_stream.pop_message(input_message));
+}
+
 TEST_F(ReliableInputStreamTest, UpdateFromHeartbeat)
 {
     uint8_t buf[128] = {0};
@@ -340,6 +363,85 @@ TEST_F(ReliableInputStreamTest, FillAcknack)
     }
 }
 
+TEST_F(ReliableInputStreamTest, DelayedAcknack)
+{
+    uint8_t buf[128] = {0};
+    InputMessagePtr input_message;
+    dds::xrce::ACKNACK_Payload acknack;
+    const uint16_t max_pending = 4;
+
+    /* Messages in order are acknowledged every max_pending. */
+    ASSERT_FALSE(reliable_stream_.has_unacked_messages());
+    for (uint16_t i = 0; i < max_pending; ++i)
+    {
+        ASSERT_TRUE(reliable_stream_.emplace_message(i, buf, sizeof(buf)));
+        ASSERT_TRUE(reliable_stream_.pop_message(input_message));
+        ASSERT_EQ(max_pending - 1 == i, reliable_stream_.is_acknack_due(true, max_pending));
+        ASSERT_TRUE(reliable_stream_.has_unacked_messages());
+    }
+    reliable_stream_.fill_acknack(acknack);
+    ASSERT_FALSE(reliable_stream_.has_unacked_messages());
+
+    /* A gap is answered right away, and so is every message until it is filled. */
+    ASSERT_TRUE(reliable_stream_.emplace_message(max_pending + 1, buf, sizeof(buf)));
+    ASSERT_FALSE(reliable_stream_.pop_message(input_message));
+    ASSERT_TRUE(reliable_stream_.is_acknack_due(true, max_pending));
+    reliable_stream_.fill_acknack(acknack);
+    ASSERT_EQ(acknack.first_unacked_seq_num(), max_pending);
+    ASSERT_EQ(acknack.nack_bitmap().at(1), 0x01);
+
+    ASSERT_TRUE(reliable_stream_.emplace_message(max_pending, buf, sizeof(buf)));
+    ASSERT_TRUE(reliable_stream_.pop_message(input_message));
+    ASSERT_TRUE(reliable_stream_.pop_message(input_message));
+    ASSERT_FALSE(reliable_stream_.is_acknack_due(true, max_pending));
+
+    /* A repeated message is answered right away. */
+    ASSERT_FALSE(reliable_stream_.emplace_message(max_pending, buf, sizeof(buf)));
+    ASSERT_TRUE(reliable_stream_.is_acknack_due(false, max_pending));
+
+    reliable_stream_.reset();
+    ASSERT_FALSE(reliable_stream_.has_unacked_messages());
+}
+
+TEST_F(ReliableInputStreamTest, FragmentReassembly)
+{
+    const size_t fragment_count = 20;
+    const size_t fragment_size = 500;
+    std::vector<uint8_t> payload(fragment_count * fragment_size);
+    for (size_t i = 0; i < payload.size(); ++i)
+    {
+        payload[i] = uint8_t(i % 251);
+    }
+
+    dds::xrce::MessageHeader header;
+    header.session_id(0x81);
+    header.stream_id(0x80);
+    header.sequence_nr(0);
+
+    InputMessagePtr input_message;
+    for (size_t i = 0; i < fragment_count; ++i)
+    {
+        dds::xrce::SubmessageHeader subheader;
+        subheader.submessage_id(dds::xrce::FRAGMENT);
+        subheader.flags((fragment_count - 1 == i) ? dds::xrce::FLAG_LAST_FRAGMENT : 0);
+        subheader.submessage_length(uint16_t(fragment_size));
+
+        OutputMessage output_message(header, 4 + 4 + fragment_size);
+        ASSERT_TRUE(output_message.append_fragment(subheader, payload.data() + i * fragment_size, fragment_size));
+
+        input_message.reset(new InputMessage(output_message.get_buf(), output_message.get_len()));
+        ASSERT_TRUE(input_message->prepare_next_submessage());
+        ASSERT_FALSE(reliable_stream_.pop_fragment_message(input_message));
+        reliable_stream_.push_fragment(input_message);
+    }
+
+    ASSERT_TRUE(reliable_stream_.pop_fragment_message(input_message));
+    ASSERT_EQ(input_message->get_len(), 4 + payload.size());
+    ASSERT_EQ(input_message->get_header().session_id(), 0x81);
+    ASSERT_EQ(0, memcmp(input_message->get_buf() + 4, payload.data(), payload.size()));
+    ASSERT_FALSE(reliable_stream_.pop_fragment_message(input_message));
+}
+
 } // namespace testing
 } // namespace uxr
 } // namespace eprosima
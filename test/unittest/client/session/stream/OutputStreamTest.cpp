@@ -14,6 +14,7 @@
 
 
 #include <uxr/agent/client/session/stream/OutputStream.hpp>
+#include <uxr/agent/message/InputMessage.hpp>
 #include <map>
 #include <queue>
 #include <mutex>
@@ -144,6 +145,54 @@ TEST_F(BestEffortOutputStreamTest, MaximumMessageSize)
     ASSERT_FALSE(best_effort_stream_.push_submessage(session_info_, stream_id_, dds::xrce::WRITE_DATA, write_data));
 }
 
+/**
+ * @brief   This test checks that coalesced submessages are packed into a single message,
+ *          which is kept open until the stream is flushed.
+ */
+TEST_F(BestEffortOutputStreamTest, Coalescing)
+{
+    dds::xrce::WRITE_DATA_Payload_Data write_data{};
+    write_data.data().serialized_data().assign(8, 0xA5);
+
+    dds::xrce::MessageHeader header{};
+    header.session_id(session_id);
+    header.client_key(client_key);
+    const size_t packed_submessage_size =
+        dds::xrce::SubmessageHeader{}.getCdrSerializedSize() + write_data.getCdrSerializedSize();
+    const size_t message_size = header.getCdrSerializedSize() + packed_submessage_size;
+    for (int i = 0; i < 3; ++i)
+    {
+        ASSERT_TRUE(best_effort_stream_.push_submessage(
+            session_info_, stream_id_, dds::xrce::WRITE_DATA, write_data, true));
+    }
+
+    OutputMessagePtr output_message;
+    ASSERT_FALSE(best_effort_stream_.pop_message(output_message, false));
+    ASSERT_TRUE(best_effort_stream_.pop_message(output_message));
+    ASSERT_EQ(message_size + 2 * packed_submessage_size, output_message->get_len());
+    ASSERT_EQ(0x00, output_message->get_buf()[2]);
+    ASSERT_FALSE(best_effort_stream_.pop_message(output_message));
+
+    InputMessage input_message(output_message->get_buf(), output_message->get_len());
+    size_t submessage_count = 0;
+    while (input_message.prepare_next_submessage())
+    {
+        dds::xrce::WRITE_DATA_Payload_Data packed_data;
+        packed_data.data().serialized_data().resize(write_data.data().serialized_data().size());
+        ASSERT_EQ(dds::xrce::WRITE_DATA, input_message.get_subheader().submessage_id());
+        ASSERT_TRUE(input_message.get_payload(packed_data));
+        ASSERT_EQ(write_data.data().serialized_data(), packed_data.data().serialized_data());
+        ++submessage_count;
+    }
+    ASSERT_EQ(3u, submessage_count);
+
+    /* The next message takes the next sequence number. */
+    ASSERT_TRUE(best_effort_stream_.push_submessage(session_info_, stream_id_, dds::xrce::WRITE_DATA, write_data));
+    ASSERT_TRUE(best_effort_stream_.pop_message(output_message));
+    ASSERT_EQ(message_size, output_message->get_len());
+    ASSERT_EQ(0x01, output_message->get_buf()[2]);
+}
+
 /****************************************************************************************
  * Reliable Output Stream.
  ****************************************************************************************/
@@ -193,6 +242,124 @@ TEST_F(ReliableOutputStreamTest, StreamCapacity)
     ASSERT_FALSE(reliable_stream_.get_next_message(output_message));
 }
 
+/**
+ * @brief   This test checks the capacity of a stream with a negotiated depth.
+ *          No more than depth messages shall be pushed, even beyond RELIABLE_STREAM_DEPTH.
+ */
+TEST_F(ReliableOutputStreamTest, NegotiatedDepth)
+{
+    const uint16_t depth = 4 * RELIABLE_STREAM_DEPTH;
+    ReliableOutputStream reliable_stream(depth);
+    dds::xrce::WRITE_DATA_Payload_Data write_data{};
+    for (int i = 0; i < depth; ++i)
+    {
+        ASSERT_TRUE(reliable_stream.push_submessage(
+            session_info_,
+            stream_id_,
+            dds::xrce::WRITE_DATA,
+            write_data,
+            std::chrono::milliseconds(0)));
+    }
+    ASSERT_FALSE(reliable_stream.push_submessage(
+        session_info_,
+        stream_id_,
+        dds::xrce::WRITE_DATA,
+        write_data,
+        std::chrono::milliseconds(0)));
+
+    dds::xrce::HEARTBEAT_Payload heartbeat;
+    reliable_stream.fill_heartbeat(heartbeat);
+    ASSERT_EQ(heartbeat.first_unacked_seq_nr(), 0x0000);
+    ASSERT_EQ(heartbeat.last_unacked_seq_nr(), depth - 1);
+}
+
+/**
+ * @brief   This test checks the push which does not wait for room in the window.
+ *          A full window shall be reported at once, and the listener called once an ACKNACK opens it.
+ */
+TEST_F(ReliableOutputStreamTest, NonBlockingPush)
+{
+    int calls = 0;
+    std::shared_ptr<WindowListener> listener = std::make_shared<WindowListener>([&calls]() { ++calls; });
+
+    dds::xrce::WRITE_DATA_Payload_Data write_data{};
+    for (int i = 0; i < RELIABLE_STREAM_DEPTH; ++i)
+    {
+        ASSERT_EQ(PushResult::pushed, reliable_stream_.try_push_submessage(
+            session_info_,
+            stream_id_,
+            dds::xrce::WRITE_DATA,
+            write_data,
+            listener));
+    }
+
+    /* The listener is registered once however many pushes find the window full. */
+    for (int i = 0; i < 2; ++i)
+    {
+        ASSERT_EQ(PushResult::window_full, reliable_stream_.try_push_submessage(
+            session_info_,
+            stream_id_,
+            dds::xrce::WRITE_DATA,
+            write_data,
+            listener));
+    }
+    ASSERT_EQ(0, calls);
+
+    OutputMessagePtr output_message;
+    while (reliable_stream_.get_next_message(output_message))
+    {}
+    reliable_stream_.update_from_acknack(1);
+    ASSERT_EQ(1, calls);
+
+    ASSERT_EQ(PushResult::pushed, reliable_stream_.try_push_submessage(
+        session_info_,
+        stream_id_,
+        dds::xrce::WRITE_DATA,
+        write_data,
+        listener));
+
+    /* Listeners going away are not called. */
+    ASSERT_EQ(PushResult::window_full, reliable_stream_.try_push_submessage(
+        session_info_,
+        stream_id_,
+        dds::xrce::WRITE_DATA,
+        write_data,
+        listener));
+    listener.reset();
+    reliable_stream_.update_from_acknack(2);
+    ASSERT_EQ(1, calls);
+}
+
+/**
+ * @brief   This test checks the lookup of acknowledged messages, e.g. from a stale ACKNACK.
+ *          It shall miss, instead of returning the message stored in the same slot.
+ */
+TEST_F(ReliableOutputStreamTest, StaleMessage)
+{
+    dds::xrce::WRITE_DATA_Payload_Data write_data{};
+    OutputMessagePtr output_message;
+    const uint16_t total = 4 * RELIABLE_STREAM_DEPTH;
+    for (uint16_t i = 0; i < total; ++i)
+    {
+        ASSERT_TRUE(reliable_stream_.push_submessage(
+            session_info_,
+            stream_id_,
+            dds::xrce::WRITE_DATA,
+            write_data,
+            std::chrono::milliseconds(0)));
+        ASSERT_TRUE(reliable_stream_.get_next_message(output_message));
+        if (RELIABLE_STREAM_DEPTH <= i + 1)
+        {
+            reliable_stream_.update_from_acknack(SeqNum(uint16_t(i + 2 - RELIABLE_STREAM_DEPTH)));
+        }
+    }
+
+    for (uint16_t i = 0; i < total; ++i)
+    {
+        ASSERT_EQ(total < i + RELIABLE_STREAM_DEPTH, reliable_stream_.get_message(SeqNum(i), output_message));
+    }
+}
+
 /**
  * @brief   This test checks the maximum message size of the stream.
  *          The reliable stream shall be able to push messages larger than the MTU.
@@ -466,6 +633,108 @@ TEST_F(ReliableOutputStreamTest, UpdateFromAcknack)
     ASSERT_EQ(hearbeat.last_unacked_seq_nr(), expected_last_unacked);
 }
 
+/**
+ * @brief   This test checks that coalesced submessages are packed up to the MTU.
+ *          A submessage which does not fit closes the open message, which takes a single sequence number.
+ */
+TEST_F(ReliableOutputStreamTest, Coalescing)
+{
+    SeqNum expected_last_unacked = 0xFFFF;
+    dds::xrce::HEARTBEAT_Payload hearbeat;
+
+    dds::xrce::WRITE_DATA_Payload_Data write_data{};
+    write_data.data().serialized_data().resize(8);
+
+    dds::xrce::MessageHeader header{};
+    header.session_id(session_id);
+    header.client_key(client_key);
+    const size_t packed_submessage_size =
+        dds::xrce::SubmessageHeader{}.getCdrSerializedSize() + write_data.getCdrSerializedSize();
+    const size_t message_size = header.getCdrSerializedSize() + packed_submessage_size;
+    const size_t packed_count = 1 + (mtu - message_size) / packed_submessage_size;
+    for (size_t i = 0; i < packed_count + 1; ++i)
+    {
+        ASSERT_TRUE(reliable_stream_.push_submessage(
+            session_info_,
+            stream_id_,
+            dds::xrce::WRITE_DATA,
+            write_data,
+            std::chrono::milliseconds(0),
+            true));
+    }
+    expected_last_unacked += 1;
+
+    reliable_stream_.fill_heartbeat(hearbeat);
+    ASSERT_EQ(hearbeat.last_unacked_seq_nr(), expected_last_unacked);
+
+    OutputMessagePtr output_message;
+    ASSERT_TRUE(reliable_stream_.get_next_message(output_message, false));
+    ASSERT_EQ(message_size + (packed_count - 1) * packed_submessage_size, output_message->get_len());
+    ASSERT_GE(mtu, output_message->get_len());
+    ASSERT_FALSE(reliable_stream_.get_next_message(output_message, false));
+
+    ASSERT_TRUE(reliable_stream_.get_next_message(output_message));
+    ASSERT_EQ(message_size, output_message->get_len());
+    expected_last_unacked += 1;
+
+    reliable_stream_.fill_heartbeat(hearbeat);
+    ASSERT_EQ(hearbeat.last_unacked_seq_nr(), expected_last_unacked);
+}
+
+/**
+ * @brief   This test checks that the fragments of a DATA submessage reference its sample instead of copying it.
+ *          Only the subheader and the request are held inline by the first fragment, and the fragments
+ *          put together shall give back the serialized submessage.
+ */
+TEST_F(ReliableOutputStreamTest, ScatteredFragmentation)
+{
+    const size_t data_len = 4 * mtu;
+    std::shared_ptr<BufferPool::Buffer> data =
+        std::make_shared<BufferPool::Buffer>(BufferPool::get_default()->acquire(data_len));
+    for (size_t i = 0; i < data_len; ++i)
+    {
+        data->data()[i] = uint8_t(i % 251);
+    }
+
+    ScatteredDataPayload data_payload;
+    data_payload.request.request_id({0x01, 0x02});
+    data_payload.request.object_id({0x03, 0x04});
+    data_payload.data = data;
+    data_payload.len = data_len;
+
+    ASSERT_TRUE(reliable_stream_.push_submessage(
+        session_info_,
+        stream_id_,
+        dds::xrce::DATA,
+        data_payload,
+        std::chrono::milliseconds(0)));
+
+    dds::xrce::MessageHeader header{};
+    header.session_id(session_id);
+    header.client_key(client_key);
+    const size_t header_size = header.getCdrSerializedSize();
+    const size_t subheader_size = dds::xrce::SubmessageHeader{}.getCdrSerializedSize();
+    const size_t inline_len = subheader_size + data_payload.request.getCdrSerializedSize();
+
+    std::vector<uint8_t> submessage;
+    OutputMessagePtr output_message;
+    while (reliable_stream_.get_next_message(output_message))
+    {
+        ASSERT_GE(mtu, output_message->get_len());
+        const size_t fragment_inline_len = output_message->get_head_len() - header_size - subheader_size;
+        ASSERT_EQ(submessage.empty() ? inline_len : 0, fragment_inline_len);
+        ASSERT_EQ(data->data() + submessage.size() + fragment_inline_len - inline_len,
+                  output_message->get_payload_buf());
+
+        const uint8_t* fragment = output_message->get_buf() + header_size + subheader_size;
+        submessage.insert(submessage.end(), fragment, fragment + output_message->get_len() - header_size - subheader_size);
+    }
+
+    ASSERT_EQ(inline_len + data_len, submessage.size());
+    ASSERT_EQ(dds::xrce::DATA, submessage[0]);
+    ASSERT_EQ(0, memcmp(submessage.data() + inline_len, data->data(), data_len));
+}
+
 } // namespace testing
 } // namespace uxr
 } // namespace eprosima
@@ -897,6 +897,73 @@ TEST_F(CedMiddlewareUnitTests, WriteReadData)
     EXPECT_FALSE(middleware_.read_data(1, input_data, std::chrono::milliseconds(100)));
 }
 
+TEST_F(CedMiddlewareUnitTests, WriteDataView)
+{
+    std::string participant_ref{"Participant"};
+    middleware_.create_participant_by_ref(0, 0, participant_ref);
+
+    std::string topic_ref{"Topic"};
+    middleware_.create_topic_by_ref(0, 0, topic_ref);
+
+    std::string subscriber_xml{"Subscriber"};
+    middleware_.create_subscriber_by_xml(0, 0, subscriber_xml);
+
+    std::string publisher_xml{"Publisher"};
+    middleware_.create_publisher_by_xml(0, 0, publisher_xml);
+
+    std::string datareader_ref{"Topic"};
+    middleware_.create_datareader_by_ref(0, 0, datareader_ref);
+
+    std::string datawriter_ref{"Topic"};
+    middleware_.create_datawriter_by_ref(0, 0, datawriter_ref);
+
+    /* Write a view of the middle of a buffer. */
+    const uint8_t buffer[]{9, 0, 1, 2, 9};
+    std::vector<uint8_t> input_data{};
+    EXPECT_TRUE(middleware_.write_data(0, buffer + 1, 3));
+    EXPECT_FALSE(middleware_.write_data(1, buffer + 1, 3));
+
+    EXPECT_TRUE(middleware_.read_data(0, input_data, std::chrono::milliseconds(0)));
+    EXPECT_EQ(std::vector<uint8_t>({0, 1, 2}), input_data);
+}
+
+TEST_F(CedMiddlewareUnitTests, WriteDataBatch)
+{
+    std::string participant_ref{"Participant"};
+    middleware_.create_participant_by_ref(0, 0, participant_ref);
+
+    std::string topic_ref{"Topic"};
+    middleware_.create_topic_by_ref(0, 0, topic_ref);
+
+    std::string subscriber_xml{"Subscriber"};
+    middleware_.create_subscriber_by_xml(0, 0, subscriber_xml);
+
+    std::string publisher_xml{"Publisher"};
+    middleware_.create_publisher_by_xml(0, 0, publisher_xml);
+
+    std::string datareader_ref{"Topic"};
+    middleware_.create_datareader_by_ref(0, 0, datareader_ref);
+
+    std::string datawriter_ref{"Topic"};
+    middleware_.create_datawriter_by_ref(0, 0, datawriter_ref);
+
+    /* Write 3 samples, viewed in a single buffer, in a batch. */
+    const uint8_t buffer[]{0, 1, 2, 3, 4, 5};
+    const Middleware::SampleView samples[]{{buffer, 1}, {buffer + 1, 2}, {buffer + 3, 3}};
+    std::vector<uint8_t> input_data{};
+    EXPECT_EQ(3u, middleware_.write_data_batch(0, samples, 3));
+    EXPECT_EQ(0u, middleware_.write_data_batch(1, samples, 3));
+
+    /* Read the samples in order. */
+    EXPECT_TRUE(middleware_.read_data(0, input_data, std::chrono::milliseconds(0)));
+    EXPECT_EQ(std::vector<uint8_t>({0}), input_data);
+    EXPECT_TRUE(middleware_.read_data(0, input_data, std::chrono::milliseconds(0)));
+    EXPECT_EQ(std::vector<uint8_t>({1, 2}), input_data);
+    EXPECT_TRUE(middleware_.read_data(0, input_data, std::chrono::milliseconds(0)));
+    EXPECT_EQ(std::vector<uint8_t>({3, 4, 5}), input_data);
+    EXPECT_FALSE(middleware_.read_data(0, input_data, std::chrono::milliseconds(0)));
+}
+
 } // namespace testing
 } // namespace uxr
 } // namespace testing
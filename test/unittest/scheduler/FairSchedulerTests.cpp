@@ -0,0 +1,142 @@
+// Copyright 2019 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <uxr/agent/scheduler/FairScheduler.hpp>
+
+#include <gtest/gtest.h>
+
+#include <utility>
+
+namespace eprosima {
+namespace uxr {
+namespace testing {
+
+/* Elements are (flow, value) pairs. */
+using Element = std::pair<int, int>;
+
+class FairSchedulerTest : public ::testing::Test
+{
+protected:
+    FairSchedulerTest()
+        : scheduler_(
+            1024,
+            1,
+            [](const Element& element) { return element.first; })
+    {
+        scheduler_.init();
+        scheduler_.set_priority_size(1, 1);
+    }
+
+    ~FairSchedulerTest() override
+    {
+        scheduler_.deinit();
+    }
+
+    FairScheduler<Element, int> scheduler_;
+};
+
+TEST_F(FairSchedulerTest, noisy_flow_does_not_delay_quiet_flows)
+{
+    const int quiet_flows = 10;
+    for (int i = 0; i < 1000; ++i)
+    {
+        scheduler_.push(Element(0, i), 0);
+    }
+    for (int flow = 1; flow <= quiet_flows; ++flow)
+    {
+        scheduler_.push(Element(flow, 0), 0);
+    }
+
+    /* Every quiet flow is served within the first round. */
+    std::vector<Element> elements;
+    ASSERT_TRUE(scheduler_.pop_batch(elements, size_t(quiet_flows + 1)));
+    int served_quiet_flows = 0;
+    for (const auto& element : elements)
+    {
+        served_quiet_flows += (0 != element.first) ? 1 : 0;
+    }
+    ASSERT_EQ(served_quiet_flows, quiet_flows);
+
+    /* The noisy flow keeps its order. */
+    Element element;
+    for (int i = 1; i < 1000; ++i)
+    {
+        ASSERT_TRUE(scheduler_.pop(element));
+        ASSERT_EQ(element, Element(0, i));
+    }
+}
+
+TEST_F(FairSchedulerTest, weights)
+{
+    scheduler_.set_weight_function([](const int& flow) { return (1 == flow) ? 3u : 1u; });
+    for (int i = 0; i < 30; ++i)
+    {
+        scheduler_.push(Element(1, i), 0);
+        scheduler_.push(Element(2, i), 0);
+    }
+
+    std::vector<Element> elements;
+    ASSERT_TRUE(scheduler_.pop_batch(elements, 20));
+    int first_flow_count = 0;
+    for (const auto& element : elements)
+    {
+        first_flow_count += (1 == element.first) ? 1 : 0;
+    }
+    ASSERT_EQ(first_flow_count, 15);
+}
+
+TEST_F(FairSchedulerTest, priority_lane)
+{
+    scheduler_.push(Element(0, 0), 0);
+    scheduler_.push(Element(1, 0), 1);
+    scheduler_.push(Element(1, 1), 1);
+
+    Element element;
+    ASSERT_TRUE(scheduler_.pop(element));
+    ASSERT_EQ(element, Element(1, 1));
+    ASSERT_TRUE(scheduler_.pop(element));
+    ASSERT_EQ(element, Element(0, 0));
+}
+
+TEST_F(FairSchedulerTest, overflow_drops_from_longest_flow)
+{
+    FairScheduler<Element, int> scheduler(4, 1, [](const Element& element) { return element.first; });
+    scheduler.init();
+    scheduler.push(Element(0, 0), 0);
+    scheduler.push(Element(0, 1), 0);
+    scheduler.push(Element(0, 2), 0);
+    scheduler.push(Element(1, 0), 0);
+    scheduler.push(Element(2, 0), 0);
+
+    std::vector<Element> elements;
+    ASSERT_TRUE(scheduler.pop_batch(elements, 8));
+    ASSERT_EQ(elements, std::vector<Element>({Element(0, 1), Element(1, 0), Element(2, 0), Element(0, 2)}));
+
+    std::vector<SchedulerLaneStats> stats;
+    scheduler.get_stats(stats);
+    ASSERT_EQ(stats.back().enqueued, 5u);
+    ASSERT_EQ(stats.back().dropped, 1u);
+    ASSERT_EQ(stats.back().high_watermark, 4u);
+    scheduler.deinit();
+}
+
+} // namespace testing
+} // namespace uxr
+} // namespace eprosima
+
+int main(int args, char** argv)
+{
+    ::testing::InitGoogleTest(&args, argv);
+    return RUN_ALL_TESTS();
+}
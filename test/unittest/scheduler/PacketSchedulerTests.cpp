@@ -0,0 +1,416 @@
+// Copyright 2019 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <uxr/agent/scheduler/PacketScheduler.hpp>
+
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+#include <set>
+
+namespace eprosima {
+namespace uxr {
+namespace testing {
+
+class PacketSchedulerTest : public ::testing::Test
+{
+protected:
+    PacketSchedulerTest()
+        : scheduler_(8)
+    {
+        scheduler_.init();
+        scheduler_.set_priority_size(1, 1);
+    }
+
+    ~PacketSchedulerTest() override
+    {
+        scheduler_.deinit();
+    }
+
+    PacketScheduler<int> scheduler_;
+};
+
+TEST_F(PacketSchedulerTest, fifo_order)
+{
+    for (int i = 0; i < 8; ++i)
+    {
+        scheduler_.push(std::move(i), 0);
+    }
+
+    int element;
+    for (int i = 0; i < 8; ++i)
+    {
+        ASSERT_TRUE(scheduler_.pop(element));
+        ASSERT_EQ(element, i);
+    }
+}
+
+TEST_F(PacketSchedulerTest, drop_oldest_when_full)
+{
+    for (int i = 0; i < 10; ++i)
+    {
+        scheduler_.push(std::move(i), 0);
+    }
+
+    int element;
+    for (int i = 2; i < 10; ++i)
+    {
+        ASSERT_TRUE(scheduler_.pop(element));
+        ASSERT_EQ(element, i);
+    }
+}
+
+TEST_F(PacketSchedulerTest, priority_order)
+{
+    scheduler_.push(0, 0);
+    scheduler_.push(1, 0);
+    scheduler_.push(10, 1);
+    scheduler_.push(11, 1);
+
+    int element;
+    ASSERT_TRUE(scheduler_.pop(element));
+    ASSERT_EQ(element, 11);
+    ASSERT_TRUE(scheduler_.pop(element));
+    ASSERT_EQ(element, 0);
+    ASSERT_TRUE(scheduler_.pop(element));
+    ASSERT_EQ(element, 1);
+}
+
+TEST_F(PacketSchedulerTest, push_front)
+{
+    scheduler_.push(0, 0);
+    scheduler_.push(1, 0);
+    scheduler_.push_front(2, 0);
+
+    int element;
+    ASSERT_TRUE(scheduler_.pop(element));
+    ASSERT_EQ(element, 2);
+    ASSERT_TRUE(scheduler_.pop(element));
+    ASSERT_EQ(element, 0);
+    ASSERT_TRUE(scheduler_.pop(element));
+    ASSERT_EQ(element, 1);
+}
+
+TEST_F(PacketSchedulerTest, pop_batch)
+{
+    for (int i = 0; i < 5; ++i)
+    {
+        scheduler_.push(std::move(i), 0);
+    }
+    scheduler_.push(10, 1);
+
+    std::vector<int> elements;
+    ASSERT_TRUE(scheduler_.pop_batch(elements, 4));
+    ASSERT_EQ(elements, std::vector<int>({10, 0, 1, 2}));
+
+    elements.clear();
+    ASSERT_TRUE(scheduler_.pop_batch(elements, 4));
+    ASSERT_EQ(elements, std::vector<int>({3, 4}));
+}
+
+TEST_F(PacketSchedulerTest, drop_newest_when_full)
+{
+    scheduler_.set_overflow_policy(0, OverflowPolicy::drop_newest);
+    for (int i = 0; i < 10; ++i)
+    {
+        scheduler_.push(std::move(i), 0);
+    }
+
+    int element;
+    for (int i = 0; i < 8; ++i)
+    {
+        ASSERT_TRUE(scheduler_.pop(element));
+        ASSERT_EQ(element, i);
+    }
+}
+
+TEST_F(PacketSchedulerTest, drop_best_effort_first)
+{
+    /* Odd elements are considered best-effort. */
+    scheduler_.set_overflow_policy(0, OverflowPolicy::drop_best_effort_first);
+    scheduler_.set_best_effort_predicate([](const int& element) { return 0 != (element % 2); });
+    scheduler_.push(0, 0);
+    scheduler_.push(2, 0);
+    scheduler_.push(3, 0);
+    for (int i = 4; i < 9; ++i)
+    {
+        scheduler_.push(i * 2, 0);
+    }
+    scheduler_.push(18, 0);
+
+    std::vector<int> elements;
+    ASSERT_TRUE(scheduler_.pop_batch(elements, 16));
+    ASSERT_EQ(elements, std::vector<int>({0, 2, 8, 10, 12, 14, 16, 18}));
+
+    std::vector<SchedulerLaneStats> stats;
+    scheduler_.get_stats(stats);
+    ASSERT_EQ(stats.back().dropped, 1u);
+}
+
+TEST_F(PacketSchedulerTest, drop_best_effort_first_without_best_effort)
+{
+    /* Odd elements are considered best-effort, but only even ones are pushed. */
+    scheduler_.set_overflow_policy(0, OverflowPolicy::drop_best_effort_first);
+    scheduler_.set_best_effort_predicate([](const int& element) { return 0 != (element % 2); });
+    std::vector<SchedulerLaneStats> stats;
+    for (int i = 0; i < 32; ++i)
+    {
+        scheduler_.push(i * 2, 0);
+        stats.clear();
+        scheduler_.get_stats(stats);
+        ASSERT_LE(stats.back().size, stats.back().capacity);
+        ASSERT_LE(stats.back().high_watermark, stats.back().capacity);
+    }
+    ASSERT_EQ(stats.back().dropped, 24u);
+
+    std::vector<int> elements;
+    ASSERT_TRUE(scheduler_.pop_batch(elements, 64));
+    ASSERT_EQ(elements, std::vector<int>({48, 50, 52, 54, 56, 58, 60, 62}));
+}
+
+TEST_F(PacketSchedulerTest, drop_best_effort_first_with_concurrent_consumers)
+{
+    /*
+     * Odd elements are considered best-effort. Reliable elements never fill the lane, so only best-effort
+     * ones are discarded, and each consumer sees both kinds in the order they were pushed.
+     * The lane is overflowed before the consumers start, and then while they run.
+     */
+    const int consumers = 4;
+    const int elements = 200000;
+    const int reliable_period = 100;
+    const size_t capacity = 4096;
+    const int end_mark = -2;
+
+    PacketScheduler<int> scheduler(capacity);
+    scheduler.init();
+    scheduler.set_best_effort_predicate([](const int& element) { return 0 != (element % 2); });
+    scheduler.set_overflow_policy(0, OverflowPolicy::drop_best_effort_first);
+
+    auto produce = [&](int first, int last)
+    {
+        for (int i = first; i < last; ++i)
+        {
+            scheduler.push((0 == (i % reliable_period)) ? 2 * i : 2 * i + 1, 0);
+        }
+    };
+    produce(0, int(3 * capacity));
+
+    std::vector<std::vector<int>> received(consumers);
+    std::vector<std::thread> consumer_threads;
+    for (int c = 0; c < consumers; ++c)
+    {
+        consumer_threads.emplace_back([&scheduler, &received, c]()
+        {
+            int element;
+            while (scheduler.pop(element) && (end_mark != element))
+            {
+                received[size_t(c)].push_back(element);
+            }
+        });
+    }
+
+    produce(int(3 * capacity), elements);
+    for (int c = 0; c < consumers; ++c)
+    {
+        scheduler.push(int(end_mark), 0);
+    }
+    for (auto& consumer : consumer_threads)
+    {
+        consumer.join();
+    }
+
+    std::vector<SchedulerLaneStats> stats;
+    scheduler.get_stats(stats);
+    scheduler.deinit();
+    ASSERT_LE(stats.back().high_watermark, stats.back().capacity);
+    ASSERT_LT(0u, stats.back().dropped);
+
+    size_t reliable = 0;
+    for (const auto& consumer_elements : received)
+    {
+        int last_reliable = -1;
+        int last_best_effort = -1;
+        for (int element : consumer_elements)
+        {
+            if (0 == (element % 2))
+            {
+                ASSERT_LT(last_reliable, element);
+                last_reliable = element;
+                ++reliable;
+            }
+            else
+            {
+                ASSERT_LT(last_best_effort, element);
+                last_best_effort = element;
+            }
+        }
+    }
+    ASSERT_EQ(reliable, size_t(elements / reliable_period));
+}
+
+TEST_F(PacketSchedulerTest, block_with_timeout)
+{
+    scheduler_.set_overflow_policy(0, OverflowPolicy::block, std::chrono::milliseconds(500));
+    for (int i = 0; i < 8; ++i)
+    {
+        scheduler_.push(std::move(i), 0);
+    }
+
+    std::thread consumer([&]()
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        int element;
+        scheduler_.pop(element);
+    });
+    scheduler_.push(8, 0);
+    consumer.join();
+
+    scheduler_.set_overflow_policy(0, OverflowPolicy::block, std::chrono::milliseconds(10));
+    scheduler_.push(9, 0);
+
+    std::vector<SchedulerLaneStats> stats;
+    scheduler_.get_stats(stats);
+    ASSERT_EQ(stats.back().enqueued, 9u);
+    ASSERT_EQ(stats.back().dropped, 1u);
+
+    std::vector<int> elements;
+    ASSERT_TRUE(scheduler_.pop_batch(elements, 16));
+    ASSERT_EQ(elements, std::vector<int>({1, 2, 3, 4, 5, 6, 7, 8}));
+}
+
+TEST_F(PacketSchedulerTest, stats)
+{
+    for (int i = 0; i < 10; ++i)
+    {
+        scheduler_.push(std::move(i), 0);
+    }
+    scheduler_.push(10, 1);
+    scheduler_.push(11, 1);
+
+    int element;
+    ASSERT_TRUE(scheduler_.pop(element));
+
+    std::vector<SchedulerLaneStats> stats;
+    scheduler_.get_stats(stats);
+    ASSERT_EQ(stats.size(), 2u);
+
+    ASSERT_EQ(stats[0].priority, 1);
+    ASSERT_EQ(stats[0].capacity, 1u);
+    ASSERT_EQ(stats[0].size, 0u);
+    ASSERT_EQ(stats[0].enqueued, 2u);
+    ASSERT_EQ(stats[0].dropped, 1u);
+    ASSERT_EQ(stats[0].high_watermark, 1u);
+
+    ASSERT_EQ(stats[1].priority, 0);
+    ASSERT_EQ(stats[1].capacity, 8u);
+    ASSERT_EQ(stats[1].size, 8u);
+    ASSERT_EQ(stats[1].enqueued, 10u);
+    ASSERT_EQ(stats[1].dropped, 2u);
+    ASSERT_EQ(stats[1].high_watermark, 8u);
+}
+
+TEST_F(PacketSchedulerTest, deinit_wakes_up_consumer)
+{
+    bool rv = true;
+    std::thread consumer([&]()
+    {
+        int element;
+        rv = scheduler_.pop(element);
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    scheduler_.deinit();
+    consumer.join();
+    ASSERT_FALSE(rv);
+}
+
+TEST_F(PacketSchedulerTest, multiple_producers_and_consumers)
+{
+    const int producers = 4;
+    const int consumers = 4;
+    const int elements_per_producer = 10000;
+
+    /* Room for the end marks too, so a slow consumer never makes the lane drop an element. */
+    PacketScheduler<int> scheduler(size_t(producers * elements_per_producer + consumers));
+    scheduler.init();
+
+    std::vector<std::vector<int>> received(consumers);
+    std::vector<std::thread> consumer_threads;
+    for (int c = 0; c < consumers; ++c)
+    {
+        consumer_threads.emplace_back([&scheduler, &received, c]()
+        {
+            int element;
+            while (scheduler.pop(element))
+            {
+                received[size_t(c)].push_back(element);
+                if (-1 == element)
+                {
+                    break;
+                }
+            }
+        });
+    }
+
+    std::vector<std::thread> producer_threads;
+    for (int p = 0; p < producers; ++p)
+    {
+        producer_threads.emplace_back([&scheduler, p, elements_per_producer]()
+        {
+            for (int i = 0; i < elements_per_producer; ++i)
+            {
+                scheduler.push(p * elements_per_producer + i, 0);
+            }
+        });
+    }
+    for (auto& producer : producer_threads)
+    {
+        producer.join();
+    }
+    for (int c = 0; c < consumers; ++c)
+    {
+        scheduler.push(-1, 0);
+    }
+    for (auto& consumer : consumer_threads)
+    {
+        consumer.join();
+    }
+    scheduler.deinit();
+
+    std::set<int> all;
+    size_t count = 0;
+    for (const auto& elements : received)
+    {
+        for (int element : elements)
+        {
+            if (-1 != element)
+            {
+                all.insert(element);
+                ++count;
+            }
+        }
+    }
+    ASSERT_EQ(count, size_t(producers * elements_per_producer));
+    ASSERT_EQ(all.size(), size_t(producers * elements_per_producer));
+}
+
+} // namespace testing
+} // namespace uxr
+} // namespace eprosima
+
+int main(int args, char** argv)
+{
+    ::testing::InitGoogleTest(&args, argv);
+    return RUN_ALL_TESTS();
+}
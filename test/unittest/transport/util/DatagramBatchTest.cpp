@@ -0,0 +1,129 @@
+// Copyright 2018 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <uxr/agent/transport/util/DatagramBatchLinux.hpp>
+
+#include <gtest/gtest.h>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <unistd.h>
+
+namespace eprosima {
+namespace uxr {
+namespace testing {
+
+using eprosima::uxr::util::DatagramReceiver;
+using eprosima::uxr::util::DatagramSender;
+
+class DatagramBatchTest : public ::testing::Test
+{
+protected:
+    static constexpr size_t POOLED_LEN = 256;
+    static constexpr size_t MAX_LEN = 2048;
+
+    DatagramBatchTest()
+        : pool_(BufferPool::create())
+        , rx_fd_(socket(PF_INET, SOCK_DGRAM, 0))
+        , tx_fd_(socket(PF_INET, SOCK_DGRAM, 0))
+        , rx_addr_{}
+    {
+        rx_addr_.sin_family = AF_INET;
+        rx_addr_.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        socklen_t addr_len = sizeof(rx_addr_);
+        EXPECT_EQ(0, bind(rx_fd_, reinterpret_cast<struct sockaddr*>(&rx_addr_), addr_len));
+        EXPECT_EQ(0, getsockname(rx_fd_, reinterpret_cast<struct sockaddr*>(&rx_addr_), &addr_len));
+    }
+
+    ~DatagramBatchTest() override
+    {
+        ::close(rx_fd_);
+        ::close(tx_fd_);
+    }
+
+    std::shared_ptr<BufferPool> pool_;
+    int rx_fd_;
+    int tx_fd_;
+    struct sockaddr_in rx_addr_;
+};
+
+constexpr size_t DatagramBatchTest::POOLED_LEN;
+constexpr size_t DatagramBatchTest::MAX_LEN;
+
+TEST_F(DatagramBatchTest, RoundTrip)
+{
+    std::vector<std::vector<uint8_t>> datagrams;
+    for (size_t len : {size_t(10), POOLED_LEN, POOLED_LEN + 1, MAX_LEN, size_t(1)})
+    {
+        std::vector<uint8_t> datagram(len);
+        for (size_t i = 0; i < len; ++i)
+        {
+            datagram[i] = uint8_t(i * 7 + len);
+        }
+        datagrams.push_back(std::move(datagram));
+    }
+
+    /* Each datagram is split in a head and a payload segment. */
+    DatagramSender<struct sockaddr_in> sender(4);
+    size_t index = 0;
+    while (index < datagrams.size())
+    {
+        sender.clear();
+        for (size_t i = index; (i < datagrams.size()) && !sender.full(); ++i)
+        {
+            const size_t head_len = datagrams[i].size() / 2;
+            sender.push(rx_addr_, datagrams[i].data(), head_len,
+                datagrams[i].data() + head_len, datagrams[i].size() - head_len);
+        }
+        size_t first = 0;
+        while (first < sender.size())
+        {
+            const int sent = sender.send(tx_fd_, first);
+            ASSERT_LT(0, sent);
+            for (int i = 0; i < sent; ++i, ++first, ++index)
+            {
+                EXPECT_TRUE(sender.is_complete(first));
+            }
+        }
+    }
+
+    DatagramReceiver<struct sockaddr_in> receiver(3, POOLED_LEN, MAX_LEN);
+    std::vector<std::pair<BufferPool::Buffer, size_t>> received;
+    while (received.size() < datagrams.size())
+    {
+        const int count = receiver.receive(rx_fd_, *pool_, 3,
+            [&](BufferPool::Buffer&& buffer, size_t len, const struct sockaddr_in& source)
+            {
+                EXPECT_EQ(htonl(INADDR_LOOPBACK), source.sin_addr.s_addr);
+                received.emplace_back(std::move(buffer), len);
+            });
+        ASSERT_LT(0, count);
+        ASSERT_GE(3, count);
+    }
+
+    for (size_t i = 0; i < datagrams.size(); ++i)
+    {
+        ASSERT_EQ(datagrams[i].size(), received[i].second);
+        EXPECT_LE(received[i].second, received[i].first.capacity());
+        EXPECT_EQ(0, memcmp(datagrams[i].data(), received[i].first.data(), received[i].second));
+    }
+
+    errno = 0;
+    EXPECT_EQ(-1, receiver.receive(rx_fd_, *pool_, 3, [](BufferPool::Buffer&&, size_t, const struct sockaddr_in&) {}));
+    EXPECT_EQ(EAGAIN, errno);
+}
+
+} // namespace testing
+} // namespace uxr
+} // namespace eprosima
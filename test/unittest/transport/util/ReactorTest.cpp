@@ -0,0 +1,142 @@
+// Copyright 2018 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <uxr/agent/transport/util/ReactorLinux.hpp>
+
+#include <gtest/gtest.h>
+
+#include <thread>
+
+namespace eprosima {
+namespace uxr {
+namespace testing {
+
+using eprosima::uxr::util::Reactor;
+
+class ReactorTest : public ::testing::Test
+{
+protected:
+    ReactorTest()
+    {
+        EXPECT_TRUE(reactor_.init());
+        EXPECT_EQ(0, pipe(pipe_fds_));
+    }
+
+    ~ReactorTest() override
+    {
+        reactor_.fini();
+        ::close(pipe_fds_[0]);
+        ::close(pipe_fds_[1]);
+    }
+
+    void write_byte()
+    {
+        char byte = 0;
+        ASSERT_EQ(1, ::write(pipe_fds_[1], &byte, 1));
+    }
+
+    void read_byte()
+    {
+        char byte;
+        ASSERT_EQ(1, ::read(pipe_fds_[0], &byte, 1));
+    }
+
+    Reactor reactor_;
+    int pipe_fds_[2];
+};
+
+TEST_F(ReactorTest, Readable)
+{
+    size_t calls = 0;
+    ASSERT_TRUE(reactor_.add(pipe_fds_[0], EPOLLIN, [&](uint32_t events)
+    {
+        EXPECT_TRUE(0 != (events & EPOLLIN));
+        read_byte();
+        ++calls;
+    }));
+    EXPECT_FALSE(reactor_.add(pipe_fds_[0], EPOLLIN, [](uint32_t) {}));
+
+    EXPECT_EQ(0, reactor_.run_once(0));
+    write_byte();
+    EXPECT_EQ(1, reactor_.run_once(100));
+    EXPECT_EQ(1u, calls);
+    EXPECT_EQ(0, reactor_.run_once(0));
+}
+
+TEST_F(ReactorTest, LevelTriggered)
+{
+    size_t calls = 0;
+    ASSERT_TRUE(reactor_.add(pipe_fds_[0], EPOLLIN, [&](uint32_t) { ++calls; }));
+    write_byte();
+    EXPECT_EQ(1, reactor_.run_once(100));
+    EXPECT_EQ(1, reactor_.run_once(100));
+    EXPECT_EQ(2u, calls);
+}
+
+TEST_F(ReactorTest, Remove)
+{
+    size_t calls = 0;
+    ASSERT_TRUE(reactor_.add(pipe_fds_[0], EPOLLIN, [&](uint32_t) { ++calls; }));
+    EXPECT_TRUE(reactor_.remove(pipe_fds_[0]));
+    EXPECT_FALSE(reactor_.remove(pipe_fds_[0]));
+    write_byte();
+    EXPECT_EQ(0, reactor_.run_once(10));
+
+    ASSERT_TRUE(reactor_.add(pipe_fds_[0], EPOLLIN, [&](uint32_t) { ++calls; }));
+    reactor_.clear();
+    EXPECT_EQ(0, reactor_.run_once(10));
+    EXPECT_EQ(0u, calls);
+}
+
+TEST_F(ReactorTest, Timer)
+{
+    size_t expirations = 0;
+    ASSERT_TRUE(reactor_.add_timer(std::chrono::milliseconds(5), [&]() { ++expirations; }));
+    EXPECT_FALSE(reactor_.add_timer(std::chrono::milliseconds(0), []() {}));
+
+    for (size_t i = 0; i < 3; ++i)
+    {
+        EXPECT_EQ(1, reactor_.run_once(1000));
+    }
+    EXPECT_EQ(3u, expirations);
+
+    /* Timers survive clear(). */
+    reactor_.clear();
+    EXPECT_EQ(1, reactor_.run_once(1000));
+    EXPECT_EQ(4u, expirations);
+}
+
+TEST_F(ReactorTest, Wakeup)
+{
+    std::thread waker([&]()
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        reactor_.wakeup();
+    });
+
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_EQ(0, reactor_.run_once(5000));
+    EXPECT_GT(std::chrono::milliseconds(2500), std::chrono::steady_clock::now() - start);
+    waker.join();
+}
+
+} // namespace testing
+} // namespace uxr
+} // namespace eprosima
+
+int main(int args, char** argv)
+{
+    ::testing::InitGoogleTest(&args, argv);
+    return RUN_ALL_TESTS();
+}
@@ -14,6 +14,7 @@
 
 #include "../Common.h"
 
+#include <uxr/agent/message/InfoReply.hpp>
 #include <uxr/agent/message/InputMessage.hpp>
 #include <uxr/agent/message/OutputMessage.hpp>
 
@@ -243,6 +244,99 @@ TEST_F(SerializerDeserializerTests, DataSubmessage)
     ASSERT_EQ(data_payload.data().serialized_data(), deserialized_data.data().serialized_data());
 }
 
+TEST_F(SerializerDeserializerTests, ScatteredDataSubmessage)
+{
+    dds::xrce::MessageHeader message_header = generate_message_header();
+    dds::xrce::DATA_Payload_Data data_payload = generate_data_payload_data();
+    const std::vector<uint8_t>& serialized_data = data_payload.data().serialized_data();
+
+    std::shared_ptr<BufferPool::Buffer> data =
+        std::make_shared<BufferPool::Buffer>(BufferPool::get_default()->acquire(serialized_data.size()));
+    memcpy(data->data(), serialized_data.data(), serialized_data.size());
+    ScatteredDataPayload scattered_payload;
+    scattered_payload.request.request_id(data_payload.request_id());
+    scattered_payload.request.object_id(data_payload.object_id());
+    scattered_payload.data = data;
+    scattered_payload.len = serialized_data.size();
+    ASSERT_EQ(data_payload.getCdrSerializedSize(), scattered_payload.getCdrSerializedSize());
+
+    dds::xrce::SubmessageHeader submessage_header;
+    size_t head_size = message_header.getCdrSerializedSize() +
+                       submessage_header.getCdrSerializedSize() +
+                       scattered_payload.request.getCdrSerializedSize();
+    OutputMessage scattered(message_header, head_size);
+    ASSERT_TRUE(scattered.append_submessage(dds::xrce::DATA, scattered_payload));
+    EXPECT_FALSE(scattered.append_submessage(dds::xrce::DATA, scattered_payload));
+
+    /* The sample is referenced, not copied. */
+    EXPECT_EQ(head_size, scattered.get_head_len());
+    EXPECT_EQ(data->data(), scattered.get_payload_buf());
+    EXPECT_EQ(serialized_data.size(), scattered.get_payload_len());
+
+    /* Gathered, it matches the contiguous serialization. */
+    OutputMessage contiguous(message_header, head_size + serialized_data.size());
+    ASSERT_TRUE(contiguous.append_submessage(dds::xrce::DATA, data_payload));
+    ASSERT_EQ(contiguous.get_len(), scattered.get_len());
+    EXPECT_EQ(0, memcmp(contiguous.get_buf(), scattered.get_buf(), contiguous.get_len()));
+}
+
+TEST_F(SerializerDeserializerTests, InfoReplySubmessage)
+{
+    dds::xrce::MessageHeader message_header = generate_message_header();
+
+    dds::xrce::TransportAddressMedium locator;
+    locator.address({{192, 168, 1, 10}});
+    locator.port(8888);
+    dds::xrce::TransportAddress address;
+    address.medium_locator(locator);
+
+    dds::xrce::AGENT_ActivityInfo agent_info;
+    agent_info.address_seq({address});
+    agent_info.availability(1);
+    dds::xrce::ActivityInfoVariant info_variant;
+    info_variant.agent(agent_info);
+
+    dds::xrce::AGENT_Representation agent_representation;
+    agent_representation.xrce_cookie(dds::xrce::XRCE_COOKIE);
+    agent_representation.xrce_version(dds::xrce::XRCE_VERSION);
+    dds::xrce::ObjectVariant object_variant;
+    object_variant.agent(agent_representation);
+
+    dds::xrce::INFO_Payload info_payload;
+    info_payload.object_info().config(object_variant);
+    info_payload.object_info().activity(info_variant);
+    InfoReply info_reply(info_payload);
+    ASSERT_FALSE(info_reply.empty());
+
+    dds::xrce::GET_INFO_Payload get_info_payload;
+    get_info_payload.request_id({{0x12, 0x34}});
+    get_info_payload.object_id({{0x56, 0x78}});
+    std::shared_ptr<OutputMessage> reply = info_reply.create_message(message_header, get_info_payload, 1);
+    ASSERT_TRUE(bool(reply));
+
+    /* The patched reply matches the serialization of the whole payload. */
+    info_payload.related_request().request_id(get_info_payload.request_id());
+    info_payload.related_request().object_id(get_info_payload.object_id());
+    info_payload.result().implementation_status(1);
+    dds::xrce::SubmessageHeader submessage_header;
+    size_t message_size = message_header.getCdrSerializedSize() +
+                          submessage_header.getCdrSerializedSize() +
+                          info_payload.getCdrSerializedSize();
+    OutputMessage expected(message_header, message_size);
+    ASSERT_TRUE(expected.append_submessage(dds::xrce::INFO, info_payload));
+    ASSERT_EQ(expected.get_len(), reply->get_len());
+    EXPECT_EQ(0, memcmp(expected.get_buf(), reply->get_buf(), expected.get_len()));
+
+    /* Replies do not share their buffer. */
+    get_info_payload.request_id({{0x9A, 0xBC}});
+    std::shared_ptr<OutputMessage> other_reply = info_reply.create_message(message_header, get_info_payload, 0);
+    ASSERT_TRUE(bool(other_reply));
+    EXPECT_EQ(0, memcmp(expected.get_buf(), reply->get_buf(), expected.get_len()));
+    EXPECT_NE(0, memcmp(reply->get_buf(), other_reply->get_buf(), reply->get_len()));
+
+    EXPECT_FALSE(bool(InfoReply().create_message(message_header, get_info_payload, 1)));
+}
+
 TEST_F(SerializerDeserializerTests, DeleteSubmessage)
 {
     dds::xrce::MessageHeader message_header = generate_message_header();
@@ -264,6 +358,130 @@ TEST_F(SerializerDeserializerTests, DeleteSubmessage)
     ASSERT_EQ(delete_payload.request_id(), deserialized_data.request_id());
 }
 
+TEST_F(SerializerDeserializerTests, SubmessageIndex)
+{
+    dds::xrce::MessageHeader message_header = generate_message_header();
+    dds::xrce::HEARTBEAT_Payload heartbeat_payload;
+    heartbeat_payload.first_unacked_seq_nr(1);
+    heartbeat_payload.last_unacked_seq_nr(2);
+    dds::xrce::DELETE_Payload delete_payload = generate_delete_resource_payload(object_id);
+    dds::xrce::SubmessageHeader submessage_header;
+    size_t heartbeat_end = message_header.getCdrSerializedSize() +
+                           submessage_header.getCdrSerializedSize() +
+                           heartbeat_payload.getCdrSerializedSize();
+    size_t delete_offset = heartbeat_end + ((4 - (heartbeat_end & 3)) & 3);
+    size_t message_size = delete_offset +
+                          submessage_header.getCdrSerializedSize() +
+                          delete_payload.getCdrSerializedSize();
+
+    OutputMessage output(message_header, message_size);
+    ASSERT_TRUE(output.append_submessage(dds::xrce::HEARTBEAT, heartbeat_payload));
+    ASSERT_TRUE(output.append_submessage(dds::xrce::DELETE_ID, delete_payload, 0x01));
+
+    InputMessage input(output.get_buf(), output.get_len());
+    ASSERT_TRUE(input.is_valid_xrce_message());
+    ASSERT_EQ(2u, input.count_submessages());
+    EXPECT_EQ(message_header.getCdrSerializedSize(), input.get_submessage_index_entry(0).offset);
+    EXPECT_EQ(dds::xrce::HEARTBEAT, input.get_submessage_index_entry(0).id);
+    EXPECT_EQ(heartbeat_payload.getCdrSerializedSize(), input.get_submessage_index_entry(0).length);
+    EXPECT_EQ(delete_offset, input.get_submessage_index_entry(1).offset);
+    EXPECT_EQ(dds::xrce::DELETE_ID, input.get_submessage_index_entry(1).id);
+    EXPECT_EQ(0x01, input.get_submessage_index_entry(1).flags);
+    EXPECT_EQ(dds::xrce::HEARTBEAT, input.get_submessage_id());
+
+    /* The unread HEARTBEAT payload is skipped. */
+    dds::xrce::DELETE_Payload deserialized_data;
+    ASSERT_TRUE(input.prepare_next_submessage());
+    ASSERT_TRUE(input.prepare_next_submessage());
+    EXPECT_EQ(dds::xrce::DELETE_ID, input.get_subheader().submessage_id());
+    ASSERT_TRUE(input.get_payload(deserialized_data));
+    EXPECT_EQ(delete_payload.object_id(), deserialized_data.object_id());
+    EXPECT_FALSE(input.prepare_next_submessage());
+}
+
+TEST_F(SerializerDeserializerTests, SubmessageIndexInvalid)
+{
+    dds::xrce::MessageHeader message_header = generate_message_header();
+    OutputMessage output(message_header, message_header.getCdrSerializedSize());
+
+    InputMessage input(output.get_buf(), output.get_len());
+    EXPECT_FALSE(input.is_valid_xrce_message());
+    EXPECT_EQ(0u, input.count_submessages());
+    EXPECT_FALSE(input.prepare_next_submessage());
+}
+
+TEST_F(SerializerDeserializerTests, PooledInputMessage)
+{
+    dds::xrce::MessageHeader message_header = generate_message_header();
+    dds::xrce::DELETE_Payload delete_payload = generate_delete_resource_payload(object_id);
+    dds::xrce::SubmessageHeader submessage_header;
+    size_t message_size = message_header.getCdrSerializedSize() +
+                          submessage_header.getCdrSerializedSize() +
+                          delete_payload.getCdrSerializedSize();
+    OutputMessage output(message_header, message_size);
+    ASSERT_TRUE(output.append_submessage(dds::xrce::DELETE_ID, delete_payload));
+
+    /* Buffers are reused once released, so the steady state does not allocate. */
+    std::shared_ptr<BufferPool> pool = BufferPool::create();
+    for (int i = 0; i < 100; ++i)
+    {
+        std::unique_ptr<InputMessage> input(new InputMessage(output.get_buf(), output.get_len(), pool));
+        ASSERT_TRUE(input->is_valid_xrce_message());
+    }
+    EXPECT_EQ(1u, pool->get_allocation_count());
+
+    /* A message built from a received buffer keeps it without copying. */
+    BufferPool::Buffer buffer = pool->acquire(output.get_len());
+    memcpy(buffer.data(), output.get_buf(), output.get_len());
+    uint8_t* data = buffer.data();
+    InputMessage input(std::move(buffer), output.get_len());
+    EXPECT_FALSE(buffer);
+    EXPECT_EQ(data, input.get_buf());
+    ASSERT_TRUE(input.prepare_next_submessage());
+    dds::xrce::DELETE_Payload deserialized_data;
+    ASSERT_TRUE(input.get_payload(deserialized_data));
+    EXPECT_EQ(delete_payload.object_id(), deserialized_data.object_id());
+    EXPECT_EQ(1u, pool->get_allocation_count());
+}
+
+TEST_F(SerializerDeserializerTests, PooledOutputMessage)
+{
+    dds::xrce::MessageHeader message_header = generate_message_header();
+    dds::xrce::ACKNACK_Payload acknack_payload;
+    dds::xrce::SubmessageHeader submessage_header;
+    dds::xrce::DELETE_Payload delete_payload = generate_delete_resource_payload(object_id);
+    size_t acknack_end = message_header.getCdrSerializedSize() +
+                           submessage_header.getCdrSerializedSize() +
+                           acknack_payload.getCdrSerializedSize();
+    ASSERT_NE(0u, acknack_end & 3);
+    size_t delete_offset = acknack_end + ((4 - (acknack_end & 3)) & 3);
+    size_t message_size = delete_offset +
+                          submessage_header.getCdrSerializedSize() +
+                          delete_payload.getCdrSerializedSize();
+
+    std::shared_ptr<BufferPool> pool = BufferPool::create();
+    {
+        /* Leave stale bytes in the pooled buffer. */
+        BufferPool::Buffer buffer = pool->acquire(message_size);
+        memset(buffer.data(), 0xFF, buffer.capacity());
+    }
+
+    for (int i = 0; i < 100; ++i)
+    {
+        std::shared_ptr<OutputMessage> output = OutputMessage::create(message_header, message_size, pool);
+        ASSERT_TRUE(output->append_submessage(dds::xrce::ACKNACK, acknack_payload));
+        ASSERT_TRUE(output->append_submessage(dds::xrce::DELETE_ID, delete_payload));
+        ASSERT_EQ(message_size, output->get_len());
+
+        /* The padding between submessages does not carry the stale bytes. */
+        for (size_t j = acknack_end; j < delete_offset; ++j)
+        {
+            EXPECT_EQ(0, output->get_buf()[j]);
+        }
+    }
+    EXPECT_EQ(1u, pool->get_allocation_count());
+}
+
 } // namespace testing
 } // namespace uxr
 } // namespace eprosima
@@ -0,0 +1,106 @@
+// Copyright 2018 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <uxr/agent/utils/HandleTable.hpp>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+
+namespace eprosima {
+namespace uxr {
+namespace testing {
+
+using eprosima::uxr::utils::HandleTable;
+
+TEST(HandleTableTest, set_get_erase)
+{
+    HandleTable<int> table;
+    ASSERT_EQ(nullptr, table.get(0));
+    ASSERT_EQ(nullptr, table.get(HandleTable<int>::CAPACITY - 1));
+
+    std::shared_ptr<int> handle = std::make_shared<int>(7);
+    table.set(0x123, handle);
+    ASSERT_EQ(handle, table.get(0x123));
+    ASSERT_EQ(nullptr, table.get(0x124));
+    ASSERT_EQ(2, handle.use_count());
+
+    table.erase(0x123);
+    ASSERT_EQ(nullptr, table.get(0x123));
+    ASSERT_EQ(1, handle.use_count());
+}
+
+TEST(HandleTableTest, out_of_range)
+{
+    HandleTable<int> table;
+    table.set(HandleTable<int>::CAPACITY, std::make_shared<int>(1));
+    ASSERT_EQ(nullptr, table.get(HandleTable<int>::CAPACITY));
+}
+
+TEST(HandleTableTest, clear)
+{
+    HandleTable<int> table;
+    for (uint16_t i = 0; i < HandleTable<int>::CAPACITY; i += 100)
+    {
+        table.set(i, std::make_shared<int>(i));
+    }
+    ASSERT_EQ(500, *table.get(500));
+
+    table.clear();
+    for (uint16_t i = 0; i < HandleTable<int>::CAPACITY; i += 100)
+    {
+        ASSERT_EQ(nullptr, table.get(i));
+    }
+}
+
+/*
+ * A handle read while it is being replaced stays valid for as long as the reader holds it.
+ */
+TEST(HandleTableTest, concurrent_replace)
+{
+    HandleTable<int> table;
+    table.set(1, std::make_shared<int>(0));
+
+    std::atomic<bool> running{true};
+    std::thread writer([&]()
+    {
+        for (int i = 1; i < 10000; ++i)
+        {
+            table.set(1, std::make_shared<int>(i));
+        }
+        running = false;
+    });
+
+    int last = 0;
+    while (running)
+    {
+        std::shared_ptr<int> handle = table.get(1);
+        ASSERT_NE(nullptr, handle);
+        ASSERT_LE(last, *handle);
+        last = *handle;
+    }
+    writer.join();
+    ASSERT_EQ(9999, *table.get(1));
+}
+
+} // namespace testing
+} // namespace uxr
+} // namespace eprosima
+
+int main(int args, char** argv)
+{
+    ::testing::InitGoogleTest(&args, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,96 @@
+// Copyright 2018 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <uxr/agent/utils/RateLimiter.hpp>
+
+#include <gtest/gtest.h>
+
+namespace eprosima {
+namespace uxr {
+namespace testing {
+
+using eprosima::uxr::utils::RateLimiter;
+using std::chrono::milliseconds;
+
+class RateLimiterTest : public ::testing::Test
+{
+public:
+    RateLimiterTest()
+        : limiter_(10, 3, 2)
+        , now_(RateLimiter<int>::Clock::now())
+    {}
+
+protected:
+    RateLimiter<int> limiter_;
+    RateLimiter<int>::Clock::time_point now_;
+};
+
+TEST_F(RateLimiterTest, burst)
+{
+    ASSERT_TRUE(limiter_.allow(1, now_));
+    ASSERT_TRUE(limiter_.allow(1, now_));
+    ASSERT_TRUE(limiter_.allow(1, now_));
+    ASSERT_FALSE(limiter_.allow(1, now_));
+    ASSERT_TRUE(limiter_.allow(2, now_));
+}
+
+TEST_F(RateLimiterTest, refill)
+{
+    for (int i = 0; i < 3; ++i)
+    {
+        ASSERT_TRUE(limiter_.allow(1, now_));
+    }
+    ASSERT_FALSE(limiter_.allow(1, now_ + milliseconds(99)));
+    ASSERT_TRUE(limiter_.allow(1, now_ + milliseconds(100)));
+    ASSERT_FALSE(limiter_.allow(1, now_ + milliseconds(100)));
+
+    /* Events below the rate are never dropped, however close they are. */
+    for (int i = 1; i <= 50; ++i)
+    {
+        ASSERT_TRUE(limiter_.allow(1, now_ + milliseconds(100 + 100 * i)));
+    }
+}
+
+TEST_F(RateLimiterTest, shared_bucket)
+{
+    ASSERT_TRUE(limiter_.allow(1, now_));
+    ASSERT_TRUE(limiter_.allow(2, now_));
+    ASSERT_EQ(2u, limiter_.size());
+
+    /* While the table is full, untracked sources share a bucket. */
+    for (int source = 3; source < 6; ++source)
+    {
+        ASSERT_TRUE(limiter_.allow(source, now_));
+    }
+    ASSERT_FALSE(limiter_.allow(6, now_));
+    ASSERT_EQ(2u, limiter_.size());
+
+    /* Once full again, the buckets of idle sources are forgotten. */
+    ASSERT_TRUE(limiter_.allow(7, now_ + milliseconds(300)));
+    ASSERT_EQ(1u, limiter_.size());
+}
+
+TEST(RateLimiterDisabledTest, unlimited)
+{
+    RateLimiter<int> limiter(0, 1, 1);
+    for (int i = 0; i < 1000; ++i)
+    {
+        ASSERT_TRUE(limiter.allow(i));
+    }
+    ASSERT_EQ(0u, limiter.size());
+}
+
+} // namespace testing
+} // namespace uxr
+} // namespace eprosima
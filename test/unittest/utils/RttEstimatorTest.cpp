@@ -0,0 +1,104 @@
+// Copyright 2018 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <uxr/agent/utils/RttEstimator.hpp>
+
+#include <gtest/gtest.h>
+
+namespace eprosima {
+namespace uxr {
+namespace testing {
+
+using eprosima::uxr::utils::RttEstimator;
+using std::chrono::milliseconds;
+
+class RttEstimatorTest : public ::testing::Test
+{
+public:
+    RttEstimatorTest()
+        : estimator_(milliseconds(200), milliseconds(25), milliseconds(8000), milliseconds(10))
+    {}
+
+protected:
+    RttEstimator estimator_;
+};
+
+TEST_F(RttEstimatorTest, initial_timeout)
+{
+    ASSERT_FALSE(estimator_.has_sample());
+    ASSERT_EQ(milliseconds(200), estimator_.get_rto());
+}
+
+TEST_F(RttEstimatorTest, first_sample)
+{
+    estimator_.update(milliseconds(100));
+    ASSERT_TRUE(estimator_.has_sample());
+    ASSERT_EQ(milliseconds(100), estimator_.get_srtt());
+    ASSERT_EQ(milliseconds(50), estimator_.get_rttvar());
+    ASSERT_EQ(milliseconds(300), estimator_.get_rto());
+}
+
+TEST_F(RttEstimatorTest, smoothing)
+{
+    estimator_.update(milliseconds(100));
+    estimator_.update(milliseconds(180));
+    ASSERT_EQ(milliseconds(110), estimator_.get_srtt());
+    ASSERT_EQ(std::chrono::microseconds(57500), estimator_.get_rttvar());
+    ASSERT_EQ(milliseconds(340), estimator_.get_rto());
+}
+
+TEST_F(RttEstimatorTest, bounds)
+{
+    /* Fast links are bounded by the minimum timeout, stable ones by the granularity. */
+    for (int i = 0; i < 64; ++i)
+    {
+        estimator_.update(milliseconds(1));
+    }
+    ASSERT_EQ(milliseconds(25), estimator_.get_rto());
+
+    for (int i = 0; i < 64; ++i)
+    {
+        estimator_.update(milliseconds(100));
+    }
+    ASSERT_EQ(estimator_.get_srtt() + milliseconds(10), estimator_.get_rto());
+
+    estimator_.update(milliseconds(20000));
+    ASSERT_EQ(milliseconds(8000), estimator_.get_rto());
+}
+
+TEST_F(RttEstimatorTest, backoff)
+{
+    estimator_.update(milliseconds(100));
+    estimator_.backoff();
+    ASSERT_EQ(milliseconds(600), estimator_.get_rto());
+    for (int i = 0; i < 8; ++i)
+    {
+        estimator_.backoff();
+    }
+    ASSERT_EQ(milliseconds(8000), estimator_.get_rto());
+
+    /* A new sample recovers the computed timeout. */
+    estimator_.update(milliseconds(100));
+    ASSERT_GT(milliseconds(8000), estimator_.get_rto());
+}
+
+} // namespace testing
+} // namespace uxr
+} // namespace eprosima
+
+int main(int args, char** argv)
+{
+    ::testing::InitGoogleTest(&args, argv);
+    return RUN_ALL_TESTS();
+}
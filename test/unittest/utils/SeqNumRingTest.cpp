@@ -0,0 +1,138 @@
+// Copyright 2018 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <uxr/agent/utils/SeqNumRing.hpp>
+
+#include <gtest/gtest.h>
+
+#include <memory>
+
+namespace eprosima {
+namespace uxr {
+namespace testing {
+
+using eprosima::uxr::utils::SeqNumRing;
+
+TEST(SeqNumRingTest, capacity)
+{
+    SeqNumRing<int> ring(12);
+    ASSERT_EQ(16u, ring.capacity());
+    ASSERT_TRUE(ring.empty());
+    ASSERT_EQ(1u, SeqNumRing<int>::get_capacity_for(0));
+    ASSERT_EQ(64u, SeqNumRing<int>::get_capacity_for(64));
+    ASSERT_EQ(SeqNumRing<int>::MAX_CAPACITY, SeqNumRing<int>::get_capacity_for(UINT16_MAX));
+}
+
+TEST(SeqNumRingTest, insert_take_erase)
+{
+    SeqNumRing<std::unique_ptr<int>> ring(4);
+    ASSERT_TRUE(ring.insert(SeqNum(10), std::unique_ptr<int>(new int(10))));
+    ASSERT_FALSE(ring.insert(SeqNum(10), std::unique_ptr<int>(new int(11))));
+    ASSERT_TRUE(ring.insert(SeqNum(11), std::unique_ptr<int>(new int(11))));
+    ASSERT_EQ(2u, ring.size());
+
+    ASSERT_TRUE(ring.contains(SeqNum(10)));
+    ASSERT_EQ(10, **ring.find(SeqNum(10)));
+    ASSERT_EQ(nullptr, ring.find(SeqNum(12)));
+
+    std::unique_ptr<int> element;
+    ASSERT_TRUE(ring.take(SeqNum(10), element));
+    ASSERT_EQ(10, *element);
+    ASSERT_FALSE(ring.take(SeqNum(10), element));
+
+    ring.erase(SeqNum(11));
+    ASSERT_TRUE(ring.empty());
+}
+
+TEST(SeqNumRingTest, wrap_around)
+{
+    SeqNumRing<int> ring(16);
+    for (uint16_t i = 0; i < 16; ++i)
+    {
+        ASSERT_TRUE(ring.insert(SeqNum(UINT16_MAX - 7 + i), int(i)));
+    }
+    ASSERT_FALSE(ring.insert(SeqNum(8), 16));
+
+    const uint64_t presence = ring.get_presence(SeqNum(UINT16_MAX - 7), 16);
+    ASSERT_EQ(uint64_t(0xFFFF), presence);
+    ASSERT_EQ(15, *ring.find(SeqNum(7)));
+}
+
+TEST(SeqNumRingTest, aliasing)
+{
+    /* 3 and 19 share a slot, only the stored one is found. */
+    SeqNumRing<int> ring(16);
+    ASSERT_TRUE(ring.insert(SeqNum(19), 19));
+    ASSERT_FALSE(ring.contains(SeqNum(3)));
+    ASSERT_EQ(nullptr, ring.find(SeqNum(3)));
+
+    int element = 0;
+    ASSERT_FALSE(ring.take(SeqNum(3), element));
+    ring.erase(SeqNum(3));
+    ASSERT_EQ(1u, ring.size());
+    ASSERT_EQ(19, *ring.find(SeqNum(19)));
+
+    ring.reserve(SeqNum(19), 32);
+    ASSERT_EQ(nullptr, ring.find(SeqNum(51)));
+    ASSERT_EQ(19, *ring.find(SeqNum(19)));
+}
+
+TEST(SeqNumRingTest, presence)
+{
+    SeqNumRing<int> ring(128);
+    const uint16_t first = 100;
+    for (uint16_t i = 0; i < 64; i += 3)
+    {
+        ASSERT_TRUE(ring.insert(SeqNum(first + i), int(i)));
+    }
+
+    const uint64_t presence = ring.get_presence(SeqNum(first), 64);
+    for (uint16_t i = 0; i < 64; ++i)
+    {
+        ASSERT_EQ(0 == (i % 3), 0 != (presence & (uint64_t(1) << i)));
+    }
+    ASSERT_EQ(uint64_t(0x9), ring.get_presence(SeqNum(first), 5));
+    ASSERT_EQ(uint64_t(0), ring.get_presence(SeqNum(first + 1), 2));
+}
+
+TEST(SeqNumRingTest, reserve)
+{
+    SeqNumRing<int> ring(4);
+    const uint16_t first = UINT16_MAX - 1;
+    for (uint16_t i = 0; i < 4; ++i)
+    {
+        ASSERT_TRUE(ring.insert(SeqNum(first + i), int(i)));
+    }
+
+    ring.reserve(SeqNum(first), 6);
+    ASSERT_EQ(8u, ring.capacity());
+    ASSERT_EQ(4u, ring.size());
+    for (uint16_t i = 0; i < 4; ++i)
+    {
+        ASSERT_EQ(int(i), *ring.find(SeqNum(first + i)));
+    }
+    ASSERT_TRUE(ring.insert(SeqNum(first + 4), 4));
+    ASSERT_TRUE(ring.insert(SeqNum(first + 5), 5));
+    ASSERT_EQ(uint64_t(0x3F), ring.get_presence(SeqNum(first), 8));
+}
+
+} // namespace testing
+} // namespace uxr
+} // namespace eprosima
+
+int main(int args, char** argv)
+{
+    ::testing::InitGoogleTest(&args, argv);
+    return RUN_ALL_TESTS();
+}
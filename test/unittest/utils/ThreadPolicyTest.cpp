@@ -0,0 +1,119 @@
+// Copyright 2018 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <uxr/agent/utils/ThreadPolicy.hpp>
+
+#include <gtest/gtest.h>
+
+#include <pthread.h>
+#include <sched.h>
+#include <thread>
+
+namespace eprosima {
+namespace uxr {
+namespace testing {
+
+using namespace eprosima::uxr::utils;
+
+class ThreadPolicyTest : public ::testing::Test
+{
+protected:
+    ThreadPolicyTest()
+        : policies_(ThreadPolicies::instance())
+    {
+        policies_.reset();
+    }
+
+    ~ThreadPolicyTest() override
+    {
+        policies_.reset();
+    }
+
+    ThreadPolicies& policies_;
+};
+
+TEST_F(ThreadPolicyTest, Parse)
+{
+    EXPECT_TRUE(policies_.parse("receiver:cpus=1,3-5:fifo=80; processing:cpus=2"));
+
+    ThreadPolicy receiver = policies_.get(ThreadRole::receiver);
+    EXPECT_EQ((std::vector<uint16_t>{1, 3, 4, 5}), receiver.cpus);
+    EXPECT_EQ(80, receiver.priority);
+
+    ThreadPolicy processing = policies_.get(ThreadRole::processing);
+    EXPECT_EQ((std::vector<uint16_t>{2}), processing.cpus);
+    EXPECT_EQ(0, processing.priority);
+
+    EXPECT_TRUE(policies_.get(ThreadRole::sender).cpus.empty());
+}
+
+TEST_F(ThreadPolicyTest, ParseLines)
+{
+    EXPECT_TRUE(policies_.parse("# gateway layout\nsender:cpus=0\n\nreader:fifo=10 # middleware\n"));
+    EXPECT_EQ((std::vector<uint16_t>{0}), policies_.get(ThreadRole::sender).cpus);
+    EXPECT_EQ(10, policies_.get(ThreadRole::reader).priority);
+}
+
+TEST_F(ThreadPolicyTest, ParseInvalid)
+{
+    EXPECT_FALSE(policies_.parse("unknown:cpus=0"));
+    EXPECT_FALSE(policies_.parse("receiver:cpus="));
+    EXPECT_FALSE(policies_.parse("receiver:cpus=3-1"));
+    EXPECT_FALSE(policies_.parse("receiver:fifo=100"));
+    EXPECT_FALSE(policies_.parse("receiver:rr=10"));
+
+    /* Nothing is stored when an entry is invalid. */
+    EXPECT_FALSE(policies_.parse("sender:cpus=0;receiver:fifo=0"));
+    EXPECT_TRUE(policies_.get(ThreadRole::sender).cpus.empty());
+}
+
+TEST_F(ThreadPolicyTest, ApplyNameAndAffinity)
+{
+    cpu_set_t allowed;
+    ASSERT_EQ(0, sched_getaffinity(0, sizeof(allowed), &allowed));
+    uint16_t cpu = 0;
+    while (!CPU_ISSET(cpu, &allowed))
+    {
+        ++cpu;
+    }
+
+    ThreadPolicy policy;
+    policy.cpus.push_back(cpu);
+    policies_.set(ThreadRole::processing, policy);
+
+    std::thread thread([&]()
+    {
+        EXPECT_TRUE(policies_.apply(ThreadRole::processing, "uxr-proc-with-a-long-name"));
+
+        char name[16];
+        ASSERT_EQ(0, pthread_getname_np(pthread_self(), name, sizeof(name)));
+        EXPECT_STREQ("uxr-proc-with-a", name);
+
+        cpu_set_t cpu_set;
+        ASSERT_EQ(0, pthread_getaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set));
+        EXPECT_EQ(1, CPU_COUNT(&cpu_set));
+        EXPECT_TRUE(CPU_ISSET(cpu, &cpu_set));
+    });
+    thread.join();
+}
+
+} // namespace testing
+} // namespace uxr
+} // namespace eprosima
+
+int main(int args, char** argv)
+{
+    ::testing::InitGoogleTest(&args, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,92 @@
+// Copyright 2017 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <uxr/agent/utils/TimerWheel.hpp>
+
+#include <gtest/gtest.h>
+
+namespace eprosima {
+namespace uxr {
+namespace testing {
+
+using eprosima::uxr::utils::TimerWheel;
+
+class TimerWheelTest : public ::testing::Test
+{
+protected:
+    TimerWheelTest()
+        : wheel_(std::chrono::milliseconds(10))
+        , start_(TimerWheel::Clock::now())
+    {}
+
+    ~TimerWheelTest() override = default;
+
+    std::vector<uint64_t> advance(
+            std::chrono::milliseconds elapsed)
+    {
+        std::vector<uint64_t> expired;
+        wheel_.advance(start_ + elapsed, expired);
+        return expired;
+    }
+
+    TimerWheel wheel_;
+    TimerWheel::Clock::time_point start_;
+};
+
+TEST_F(TimerWheelTest, expiration)
+{
+    ASSERT_TRUE(wheel_.schedule(1, std::chrono::milliseconds(50)));
+    ASSERT_TRUE(wheel_.schedule(2, std::chrono::milliseconds(100)));
+    ASSERT_EQ(wheel_.size(), 2u);
+
+    ASSERT_TRUE(advance(std::chrono::milliseconds(30)).empty());
+    ASSERT_EQ(advance(std::chrono::milliseconds(80)), std::vector<uint64_t>({1}));
+    ASSERT_EQ(advance(std::chrono::milliseconds(120)), std::vector<uint64_t>({2}));
+    ASSERT_EQ(wheel_.size(), 0u);
+}
+
+TEST_F(TimerWheelTest, reschedule_and_cancel)
+{
+    ASSERT_TRUE(wheel_.schedule(1, std::chrono::milliseconds(50)));
+    ASSERT_FALSE(wheel_.schedule(1, std::chrono::milliseconds(20), false));
+    ASSERT_TRUE(wheel_.schedule(1, std::chrono::milliseconds(200)));
+    ASSERT_TRUE(wheel_.schedule(2, std::chrono::milliseconds(50)));
+    wheel_.cancel(2);
+    ASSERT_FALSE(wheel_.is_scheduled(2));
+
+    ASSERT_TRUE(advance(std::chrono::milliseconds(150)).empty());
+    ASSERT_EQ(advance(std::chrono::milliseconds(250)), std::vector<uint64_t>({1}));
+}
+
+TEST_F(TimerWheelTest, upper_levels)
+{
+    /* 10 ms resolution, 64 slots per level: exercise the second and third levels. */
+    ASSERT_TRUE(wheel_.schedule(1, std::chrono::milliseconds(5000)));
+    ASSERT_TRUE(wheel_.schedule(2, std::chrono::milliseconds(60000)));
+
+    ASSERT_TRUE(advance(std::chrono::milliseconds(4990)).empty());
+    ASSERT_EQ(advance(std::chrono::milliseconds(5000)), std::vector<uint64_t>({1}));
+    ASSERT_TRUE(advance(std::chrono::milliseconds(59990)).empty());
+    ASSERT_EQ(advance(std::chrono::milliseconds(60000)), std::vector<uint64_t>({2}));
+}
+
+} // namespace testing
+} // namespace uxr
+} // namespace eprosima
+
+int main(int args, char** argv)
+{
+    ::testing::InitGoogleTest(&args, argv);
+    return RUN_ALL_TESTS();
+}